@@ -0,0 +1,32 @@
+
+#ifndef BENCHCAMERA_H
+#define BENCHCAMERA_H
+#include "Camera.h"
+
+
+//A camera that never moves, so every run of the benchmark renders exactly the same image.
+class BenchCamera final: public Camera {
+public:
+    glm::dvec3 getPosition() override {
+        return {0, 0, 0};
+    }
+
+    double getPitch() override {
+        return 0;
+    }
+
+    double getYaw() override {
+        return 0;
+    }
+
+    double getRoll() override {
+        return 0;
+    }
+
+    void updateCamera() override {
+    }
+};
+
+
+
+#endif //BENCHCAMERA_H
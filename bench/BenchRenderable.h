@@ -0,0 +1,74 @@
+
+#ifndef BENCHRENDERABLE_H
+#define BENCHRENDERABLE_H
+#include <memory>
+#include <utility>
+
+#include "TestMaterial.h"
+#include "TestShaderObject.h"
+#include "renderable/SimpleIndexBufferedRenderable.h"
+#include "glm/glm.hpp"
+#include "glm/ext/matrix_transform.hpp"
+
+
+//A renderable with a fixed transform, placed on a grid in front of the camera. All instances share one material.
+class BenchRenderable final : public SimpleIndexBufferedRenderable<TestShaderData> {
+public:
+    BenchRenderable(const std::shared_ptr<SimpleShaderObject> &shader, std::shared_ptr<Mesh> mesh, const uint32_t gridIndex, const uint32_t gridSize)
+        : SimpleIndexBufferedRenderable(shader, std::move(mesh)) {
+        const uint32_t x = gridIndex % gridSize;
+        const uint32_t y = gridIndex / gridSize % gridSize;
+        const uint32_t z = gridIndex / (gridSize * gridSize);
+
+        transform = translate(glm::identity<glm::mat4>(), glm::vec3(
+            (static_cast<float>(x) - gridSize / 2.0f) * SPACING,
+            (static_cast<float>(y) - gridSize / 2.0f) * SPACING,
+            -DISTANCE - static_cast<float>(z) * SPACING
+        ));
+    }
+
+    std::shared_ptr<Material> getMaterial() override {
+        static const auto material = std::shared_ptr<Material>(new TestMaterial());
+        return material;
+    }
+
+    void draw(VkCommandBuffer commandBuffer, uint32_t imageIndex) override {
+        //The shader replaces the transform buffer when the renderable is initialized, so the transform is only set here.
+        if (!uploadedTransform) {
+            transformBuffer.bufferValue = transform;
+            transformBuffer.markBuffersDirty();
+            uploadedTransform = true;
+        }
+
+        transformBuffer.onFrame(XTPVulkan::currentFrameIndex);
+
+        SimpleShaderObject::bindPushConstant(commandBuffer, getPushConstants(XTPVulkan::currentFrameIndex), shader.get());
+        mesh->draw(commandBuffer);
+    }
+
+    glm::mat4 getTransform() override {
+        return transform;
+    }
+
+    TestShaderData getPushConstants(const uint32_t frameIndex) override {
+        return TestShaderData {
+            XTPVulkan::globalSceneDataBuffers[frameIndex].gpuAddress,
+            transformBuffer.getAddress(frameIndex)
+        };
+    }
+
+    void createBuffers() override {
+
+    }
+
+private:
+    static constexpr float SPACING = 1.5f;
+    static constexpr float DISTANCE = 5.0f;
+
+    glm::mat4 transform;
+    bool uploadedTransform = false;
+};
+
+
+
+#endif //BENCHRENDERABLE_H
@@ -0,0 +1,28 @@
+
+#ifndef BENCHWINDOWDATA_H
+#define BENCHWINDOWDATA_H
+#include "XTPWindowData.h"
+
+class BenchWindowData final: public XTPWindowData {
+public:
+    BenchWindowData(const int width, const int height): width(width), height(height) {
+    }
+
+    const char * getWindowTitle() override {
+        return "XTP Benchmark";
+    }
+
+    int getWidth() override {
+        return width;
+    }
+
+    int getHeight() override {
+        return height;
+    }
+
+private:
+    int width;
+    int height;
+};
+
+#endif //BENCHWINDOWDATA_H
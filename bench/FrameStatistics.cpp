@@ -0,0 +1,58 @@
+
+#include "FrameStatistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+void FrameStatistics::addSample(const uint64_t nanos) {
+    if (nanos == static_cast<uint64_t>(-1)) {
+        return;
+    }
+    samples.emplace_back(nanos);
+}
+
+bool FrameStatistics::empty() const {
+    return samples.empty();
+}
+
+FrameStatistics::Summary FrameStatistics::summarize() const {
+    Summary summary {};
+    if (samples.empty()) {
+        return summary;
+    }
+
+    std::vector<uint64_t> sorted = samples;
+    std::sort(sorted.begin(), sorted.end());
+
+    summary.samples = sorted.size();
+    summary.min = sorted.front();
+    summary.max = sorted.back();
+    summary.mean = std::accumulate(sorted.begin(), sorted.end(), static_cast<long double>(0)) / sorted.size();
+    summary.p50 = percentile(sorted, 50);
+    summary.p95 = percentile(sorted, 95);
+    summary.p99 = percentile(sorted, 99);
+
+    return summary;
+}
+
+std::string FrameStatistics::toJson() const {
+    if (samples.empty()) {
+        return "null";
+    }
+    const Summary summary = summarize();
+
+    return "{\"samples\": " + std::to_string(summary.samples) +
+           ", \"min\": " + std::to_string(summary.min) +
+           ", \"max\": " + std::to_string(summary.max) +
+           ", \"mean\": " + std::to_string(summary.mean) +
+           ", \"p50\": " + std::to_string(summary.p50) +
+           ", \"p95\": " + std::to_string(summary.p95) +
+           ", \"p99\": " + std::to_string(summary.p99) + "}";
+}
+
+uint64_t FrameStatistics::percentile(const std::vector<uint64_t> &sorted, const double percent) {
+    //Nearest-rank percentile, so the result is always an observed sample and is stable between runs.
+    const auto rank = static_cast<size_t>(std::ceil(percent / 100.0 * static_cast<double>(sorted.size())));
+    return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
@@ -0,0 +1,40 @@
+
+#ifndef FRAMESTATISTICS_H
+#define FRAMESTATISTICS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Collects per-frame samples of a single timing (e.g. record time) and reduces them to percentiles.
+class FrameStatistics {
+public:
+    struct Summary {
+        size_t samples;
+        uint64_t min;
+        uint64_t max;
+        uint64_t mean;
+        uint64_t p50;
+        uint64_t p95;
+        uint64_t p99;
+    };
+
+    //Samples equal to -1 are treated as unavailable and ignored.
+    void addSample(uint64_t nanos);
+
+    [[nodiscard]] bool empty() const;
+
+    [[nodiscard]] Summary summarize() const;
+
+    //Writes the summary as a JSON object, or null if there are no samples.
+    [[nodiscard]] std::string toJson() const;
+
+private:
+    std::vector<uint64_t> samples;
+
+    static uint64_t percentile(const std::vector<uint64_t>& sorted, double percent);
+};
+
+
+
+#endif //FRAMESTATISTICS_H
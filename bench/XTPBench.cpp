@@ -0,0 +1,296 @@
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include "XTP.h"
+#include "Events.h"
+#include "SimpleLogger.h"
+#include "XTPWindowing.h"
+#include "HeadlessWindowBackend.h"
+#include "ShaderRegisterEvent.h"
+#include "TestShaderObject.h"
+#include "VulkanRenderInfo.h"
+
+#include "BenchCamera.h"
+#include "BenchRenderable.h"
+#include "BenchWindowData.h"
+#include "Camera.h"
+#include "FrameEvent.h"
+#include "FrameStatistics.h"
+#include "TimeManager.h"
+#include "renderable/SimpleMesh.h"
+
+static SimpleLogger benchLogger = {"Bench Logger", INFORMATION};
+
+//Referenced by every renderable, so it has to outlive all of them.
+static std::shared_ptr<SimpleShaderObject> benchShader = nullptr;
+
+struct BenchOptions {
+    std::vector<uint32_t> sizes = {1000, 10000, 100000};
+    uint32_t renderables = 0;
+    uint32_t frames = 500;
+    uint32_t warmupFrames = 50;
+    uint32_t recordingThreads = 1;
+    bool indirect = false;
+    int width = 1280;
+    int height = 720;
+    std::string output = "xtp-bench.json";
+};
+
+static BenchOptions options {};
+static HeadlessWindowBackend* headlessBackend = nullptr;
+
+static FrameStatistics frameTimes {};
+static FrameStatistics fenceWaitTimes {};
+static FrameStatistics recordTimes {};
+static FrameStatistics submitTimes {};
+static FrameStatistics gpuTimes {};
+
+class BenchRenderInfo final : public VulkanRenderInfo {
+public:
+    uint32_t getRecordingThreadCount() override {
+        return options.recordingThreads;
+    }
+};
+
+class BenchShaderEvent final : public ShaderRegisterEvent {
+    void onRegisterShaders() override {
+        benchShader = std::shared_ptr<SimpleShaderObject>(new TestShaderObject(
+            options.indirect ? "./assets/shaders/test_indirect.vert.spv" : "./assets/shaders/test.vert.spv",
+            "./assets/shaders/test.frag.spv", {.cullMode = VK_CULL_MODE_NONE}, options.indirect));
+        XTPVulkan::addShader(benchShader);
+
+        const std::vector<VertexData> vertices = {
+            {{}, {-0.5f,0.5f,-0.5f}, {0, 0}},
+            {{}, {-0.5f,-0.5f,-0.5f}, {0, 1}},
+            {{}, {0.5f,-0.5f,-0.5f}, {1, 1}},
+            {{}, {0.5f,0.5f,-0.5f}, {1, 0}},
+
+            {{}, {-0.5f,0.5f,0.5f}, {0, 0}},
+            {{}, {-0.5f,-0.5f,0.5f}, {0, 1}},
+            {{}, {0.5f,-0.5f,0.5f}, {1, 1}},
+            {{}, {0.5f,0.5f,0.5f}, {1, 0}},
+
+            {{}, {0.5f,0.5f,-0.5f}, {0, 0}},
+            {{}, {0.5f,-0.5f,-0.5f}, {0, 1}},
+            {{}, {0.5f,-0.5f,0.5f}, {1, 1}},
+            {{}, {0.5f,0.5f,0.5f}, {1, 0}},
+
+            {{}, {-0.5f,0.5f,-0.5f}, {0, 0}},
+            {{}, {-0.5f,-0.5f,-0.5f}, {0, 1}},
+            {{}, {-0.5f,-0.5f,0.5f}, {1, 1}},
+            {{}, {-0.5f,0.5f,0.5f}, {1, 0}},
+
+            {{}, {-0.5f,0.5f,0.5f}, {0, 0}},
+            {{}, {-0.5f,0.5f,-0.5f}, {0, 1}},
+            {{}, {0.5f,0.5f,-0.5f}, {1, 1}},
+            {{}, {0.5f,0.5f,0.5f}, {1, 0}},
+
+            {{}, {-0.5f,-0.5f,0.5f}, {0, 0}},
+            {{}, {-0.5f,-0.5f,-0.5f}, {0, 1}},
+            {{}, {0.5f,-0.5f,-0.5f}, {1, 1}},
+            {{}, {0.5f,-0.5f,0.5f}, {1, 0}}
+        };
+
+        const std::vector<uint32_t> indices = {
+            0,1,3,
+            3,1,2,
+            4,5,7,
+            7,5,6,
+            8,9,11,
+            11,9,10,
+            12,13,15,
+            15,13,14,
+            16,17,19,
+            19,17,18,
+            20,21,23,
+            23,21,22
+        };
+
+        //Every renderable shares one mesh, so the scene size only scales the per-object work of the renderer.
+        const auto mesh = std::make_shared<SimpleMesh<VertexData>>(vertices, indices);
+        const auto gridSize = static_cast<uint32_t>(std::ceil(std::cbrt(static_cast<double>(options.renderables))));
+
+        for (uint32_t i = 0; i < options.renderables; ++i) {
+            XTPVulkan::addRenderable(std::shared_ptr<Renderable>(new BenchRenderable(benchShader, mesh, i, gridSize)));
+        }
+    }
+};
+
+class BenchFrameEvent final: public FrameEvent {
+public:
+    void onFrameBegin() override {}
+
+    void onFrameDrawBegin() override {}
+
+    void onFrameDrawEnd() override {}
+
+    void onFrameEnd() override {
+        const uint64_t now = TimeManager::getCurrentTimeNano();
+        framesSeen++;
+
+        //The first frames are skipped, since they include pipeline creation, material init and the initial uploads.
+        if (framesSeen > options.warmupFrames) {
+            frameTimes.addSample(now - lastFrameEnd);
+            fenceWaitTimes.addSample(XTPVulkan::lastFrameTimings.fenceWaitNanos);
+            recordTimes.addSample(XTPVulkan::lastFrameTimings.recordNanos);
+            submitTimes.addSample(XTPVulkan::lastFrameTimings.submitNanos);
+            gpuTimes.addSample(XTPVulkan::lastFrameTimings.gpuNanos);
+        }
+        lastFrameEnd = now;
+
+        if (framesSeen >= options.warmupFrames + options.frames) {
+            headlessBackend->requestClose();
+        }
+    }
+
+private:
+    uint32_t framesSeen = 0;
+    uint64_t lastFrameEnd = 0;
+};
+
+static std::vector<uint32_t> parseSizes(const std::string& list) {
+    std::vector<uint32_t> sizes;
+    std::stringstream stream(list);
+    std::string size;
+    while (std::getline(stream, size, ',')) {
+        sizes.emplace_back(std::stoul(size));
+    }
+    return sizes;
+}
+
+static void parseOptions(const int argc, char *argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--indirect") {
+            options.indirect = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            benchLogger.logCritical("Missing Value For Option '{}'!", true, arg);
+        }
+        const std::string value = argv[++i];
+
+        if (arg == "--sizes") {
+            options.sizes = parseSizes(value);
+        } else if (arg == "--renderables") {
+            options.renderables = std::stoul(value);
+        } else if (arg == "--frames") {
+            options.frames = std::stoul(value);
+        } else if (arg == "--warmup") {
+            options.warmupFrames = std::stoul(value);
+        } else if (arg == "--threads") {
+            options.recordingThreads = std::stoul(value);
+        } else if (arg == "--width") {
+            options.width = std::stoi(value);
+        } else if (arg == "--height") {
+            options.height = std::stoi(value);
+        } else if (arg == "--output") {
+            options.output = value;
+        } else {
+            benchLogger.logCritical("Unknown Option '{}'!", true, arg);
+        }
+    }
+}
+
+static std::string readWholeFile(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        benchLogger.logCritical("Failed To Open '{}'!", true, path);
+    }
+    std::stringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+static void writeWholeFile(const std::string& path, const std::string& contents) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        benchLogger.logCritical("Failed To Open '{}'!", true, path);
+    }
+    file << contents;
+}
+
+//Renders a single scene of options.renderables objects and writes its statistics to options.output.
+static void runScene() {
+    auto* backend = new HeadlessWindowBackend();
+    headlessBackend = backend;
+    XTPWindowing::setWindowBackend(std::unique_ptr<XTPWindowBackend>(backend));
+    XTPWindowing::setWindowData(std::unique_ptr<XTPWindowData>(new BenchWindowData(options.width, options.height)));
+    VulkanRenderInfo::INSTANCE = new BenchRenderInfo();
+    Camera::camera = std::shared_ptr<Camera>(new BenchCamera());
+
+    Events::registerEvent(std::unique_ptr<Event>(new BenchShaderEvent()));
+    Events::registerEvent(std::unique_ptr<Event>(new BenchFrameEvent()));
+    XTP::start(std::chrono::milliseconds{1});
+
+    std::stringstream json;
+    json << "{\"renderables\": " << options.renderables
+         << ", \"frames\": " << options.frames
+         << ", \"warmupFrames\": " << options.warmupFrames
+         << ", \"recordingThreads\": " << options.recordingThreads
+         << ", \"indirect\": " << (options.indirect ? "true" : "false")
+         << ", \"width\": " << options.width
+         << ", \"height\": " << options.height
+         << ", \"frameNanos\": " << frameTimes.toJson()
+         << ", \"fenceWaitNanos\": " << fenceWaitTimes.toJson()
+         << ", \"recordNanos\": " << recordTimes.toJson()
+         << ", \"submitNanos\": " << submitTimes.toJson()
+         << ", \"gpuNanos\": " << gpuTimes.toJson() << "}";
+    writeWholeFile(options.output, json.str());
+
+    if (gpuTimes.empty()) {
+        benchLogger.logWarning("No GPU Times Were Recorded, "
+                               "XTPCore Must Be Built With XTP_USE_ADVANCED_TIMING To Report Them.");
+    }
+}
+
+//Runs every scene size in a fresh process, so the renderer state of one size (allocations, caches, etc.) cannot affect the
+//next one, and merges the results into a single file.
+static int runAllScenes(const char* executable) {
+    std::stringstream json;
+    json << "{\"results\": [";
+
+    for (size_t i = 0; i < options.sizes.size(); ++i) {
+        const uint32_t size = options.sizes[i];
+        const std::string sceneOutput = options.output + "." + std::to_string(size) + ".tmp";
+
+        benchLogger.logInformation("Running Scene With {} Renderables", size);
+        const std::string command = "\"" + std::string(executable) + "\"" +
+            " --renderables " + std::to_string(size) +
+            " --frames " + std::to_string(options.frames) +
+            " --warmup " + std::to_string(options.warmupFrames) +
+            " --threads " + std::to_string(options.recordingThreads) +
+            (options.indirect ? " --indirect" : "") +
+            " --width " + std::to_string(options.width) +
+            " --height " + std::to_string(options.height) +
+            " --output \"" + sceneOutput + "\"";
+
+        if (std::system(command.c_str()) != 0) {
+            benchLogger.logError("Scene With {} Renderables Failed!", false, size);
+            return 1;
+        }
+
+        json << (i == 0 ? "" : ", ") << readWholeFile(sceneOutput);
+        std::remove(sceneOutput.c_str());
+    }
+
+    json << "]}\n";
+    writeWholeFile(options.output, json.str());
+    benchLogger.logInformation("Wrote Benchmark Results To '{}'", options.output);
+    return 0;
+}
+
+//Usage: XTPBench [--sizes 1000,10000,100000] [--frames 500] [--warmup 50] [--threads 1] [--indirect] [--width 1280] [--height 720] [--output xtp-bench.json]
+int main(const int argc, char *argv[]) {
+    parseOptions(argc, argv);
+
+    if (options.renderables == 0) {
+        return runAllScenes(argv[0]);
+    }
+
+    runScene();
+    return 0;
+}
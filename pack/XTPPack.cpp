@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <unordered_map>
+#include <vector>
+
+#include "AssetArchive.h"
+#include "Lz4.h"
+#include "MappedFile.h"
+#include "SimpleLogger.h"
+
+//Packs files into an AssetArchive, e.g. "XTPPack assets.xtpa assets" from the directory the app runs in. Assets are
+//stored under the path they were found at, so the app finds them by the same paths it would load the loose files from.
+//
+//Usage: XTPPack [--no-compression] <archive> <file or directory>...
+
+static SimpleLogger packLogger = {"Pack Logger", INFORMATION};
+
+struct PackedContents {
+    uint64_t hash;
+    uint64_t offset;
+    std::vector<unsigned char> stored;
+    size_t size;
+    AssetArchiveEntry::Compression compression;
+    //Kept to compare against contents with the same hash.
+    std::shared_ptr<MappedFile> source;
+};
+
+static bool compress = true;
+
+static std::vector<std::string> findFiles(const std::vector<std::string> &inputs) {
+    std::vector<std::string> files;
+    for (const std::string &input: inputs) {
+        if (std::filesystem::is_directory(input)) {
+            std::vector<std::string> directoryFiles;
+            for (const auto &file: std::filesystem::recursive_directory_iterator(input)) {
+                if (file.is_regular_file()) {
+                    directoryFiles.push_back(file.path().lexically_normal().generic_string());
+                }
+            }
+            //Sorted, so packing the same files always gives the same archive.
+            std::sort(directoryFiles.begin(), directoryFiles.end());
+            files.insert(files.end(), directoryFiles.begin(), directoryFiles.end());
+        } else if (std::filesystem::is_regular_file(input)) {
+            files.push_back(std::filesystem::path(input).lexically_normal().generic_string());
+        } else {
+            packLogger.logCritical("Failed To Find '{}'!", true, input);
+        }
+    }
+    return files;
+}
+
+//Only keeps the compressed contents if they save at least an eighth, since anything less isn't worth decompressing.
+static void storeContents(const MappedFile &file, PackedContents &contents) {
+    contents.size = file.size();
+    if (compress && file.size() > 0) {
+        contents.stored.resize(Lz4::getMaxCompressedSize(file.size()));
+        const size_t compressedSize = Lz4::compress(file.data(), file.size(), contents.stored.data(),
+                                                    contents.stored.size());
+        if (compressedSize > 0 && compressedSize <= file.size() - file.size() / 8) {
+            contents.stored.resize(compressedSize);
+            contents.compression = AssetArchiveEntry::LZ4;
+            return;
+        }
+    }
+    contents.stored.assign(file.data(), file.data() + file.size());
+    contents.compression = AssetArchiveEntry::NONE;
+}
+
+static uint64_t align(const uint64_t offset, const uint64_t size) {
+    const uint64_t alignment = size >= AssetArchive::PAGE_ALIGNED_SIZE ?
+        AssetArchive::PAGE_ALIGNMENT : AssetArchive::CONTENT_ALIGNMENT;
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+int main(const int argc, char *argv[]) {
+    std::vector<std::string> arguments;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--no-compression") == 0) {
+            compress = false;
+        } else {
+            arguments.emplace_back(argv[i]);
+        }
+    }
+    if (arguments.size() < 2) {
+        packLogger.logCritical("Usage: XTPPack [--no-compression] <archive> <file or directory>...");
+    }
+    const std::string archivePath = arguments.front();
+    const std::vector<std::string> files = findFiles({arguments.begin() + 1, arguments.end()});
+
+    std::vector<AssetArchiveEntry> entries;
+    std::vector<PackedContents> packedContents;
+    std::unordered_map<uint64_t, std::string> pathsByHash;
+    std::unordered_multimap<uint64_t, size_t> contentsByHash;
+    size_t totalSize = 0;
+
+    for (const std::string &path: files) {
+        const uint64_t pathHash = AssetArchive::hashPath(path);
+        if (const auto [existing, inserted] = pathsByHash.try_emplace(pathHash, path); !inserted) {
+            if (existing->second == path) {
+                continue;
+            }
+            packLogger.logCritical("The Paths '{}' And '{}' Have The Same Hash!", true, existing->second, path);
+        }
+
+        auto file = std::make_shared<MappedFile>(path);
+        if (!file->isOpen()) {
+            packLogger.logCritical("Failed To Open '{}'!", true, path);
+        }
+        totalSize += file->size();
+
+        const uint64_t contentHash = AssetArchive::hashContents(file->data(), file->size());
+        size_t contentsIndex = packedContents.size();
+        const auto [first, last] = contentsByHash.equal_range(contentHash);
+        for (auto candidate = first; candidate != last; ++candidate) {
+            const MappedFile &other = *packedContents[candidate->second].source;
+            if (other.size() == file->size() && (file->size() == 0 ||
+                memcmp(other.data(), file->data(), file->size()) == 0)) {
+                contentsIndex = candidate->second;
+                break;
+            }
+        }
+        if (contentsIndex == packedContents.size()) {
+            PackedContents &contents = packedContents.emplace_back();
+            contents.hash = contentHash;
+            contents.source = file;
+            storeContents(*file, contents);
+            contentsByHash.emplace(contentHash, contentsIndex);
+        }
+
+        AssetArchiveEntry entry {};
+        entry.pathHash = pathHash;
+        entry.contentHash = contentHash;
+        entry.size = file->size();
+        //The offset and the rest are filled in once the layout is known.
+        entry.offset = contentsIndex;
+        entries.push_back(entry);
+    }
+
+    //Contents start after the entries, each one aligned.
+    uint64_t offset = sizeof(AssetArchiveHeader) + entries.size() * sizeof(AssetArchiveEntry);
+    for (PackedContents &contents: packedContents) {
+        offset = align(offset, contents.stored.size());
+        contents.offset = offset;
+        offset += contents.stored.size();
+    }
+    for (AssetArchiveEntry &entry: entries) {
+        const PackedContents &contents = packedContents[entry.offset];
+        entry.offset = contents.offset;
+        entry.storedSize = contents.stored.size();
+        entry.compression = contents.compression;
+    }
+    std::sort(entries.begin(), entries.end(), [](const AssetArchiveEntry &a, const AssetArchiveEntry &b) {
+        return a.pathHash < b.pathHash;
+    });
+
+    std::ofstream archive(archivePath, std::ios::binary | std::ios::trunc);
+    if (!archive.is_open()) {
+        packLogger.logCritical("Failed To Create '{}'!", true, archivePath);
+    }
+    const AssetArchiveHeader header {AssetArchiveHeader::MAGIC, AssetArchiveHeader::VERSION, entries.size()};
+    archive.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    archive.write(reinterpret_cast<const char*>(entries.data()),
+                  static_cast<std::streamsize>(entries.size() * sizeof(AssetArchiveEntry)));
+    uint64_t written = sizeof(AssetArchiveHeader) + entries.size() * sizeof(AssetArchiveEntry);
+    for (const PackedContents &contents: packedContents) {
+        const std::vector<char> padding(contents.offset - written, 0);
+        archive.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+        archive.write(reinterpret_cast<const char*>(contents.stored.data()),
+                      static_cast<std::streamsize>(contents.stored.size()));
+        written = contents.offset + contents.stored.size();
+    }
+    archive.close();
+    if (archive.fail()) {
+        packLogger.logCritical("Failed To Write '{}'!", true, archivePath);
+    }
+
+    packLogger.logInformation("Packed {} Assets ({} Unique) From {} Bytes Into {} Bytes", entries.size(),
+                              packedContents.size(), totalSize, written);
+    return 0;
+}
@@ -0,0 +1,131 @@
+
+#include "HeadlessWindowBackend.h"
+
+#include <stdexcept>
+
+#include "XTPWindowing.h"
+#ifdef XTP_USE_IMGUI_UI
+#include "imgui.h"
+#endif
+
+HeadlessWindowBackend::HeadlessWindowBackend(const uint64_t frameLimit): frameLimit(frameLimit) {
+}
+
+void HeadlessWindowBackend::createWindow() {
+    if (XTPWindowing::data == nullptr) {
+        throw std::runtime_error("Window Data Must Not Be Null!");
+    }
+    width = XTPWindowing::data->getWidth();
+    height = XTPWindowing::data->getHeight();
+    framebufferResized = false;
+}
+
+void HeadlessWindowBackend::getWindowSize(int *width, int *height) {
+    *width = this->width;
+    *height = this->height;
+}
+
+void HeadlessWindowBackend::setWindowSize(const int width, const int height) {
+    if (width == this->width && height == this->height) {
+        return;
+    }
+    this->width = width;
+    this->height = height;
+    framebufferResized = true;
+}
+
+void HeadlessWindowBackend::setMousePos(const double x, const double y) {
+    mousePos = {x, y};
+}
+
+void HeadlessWindowBackend::getMousePos(double *x, double *y) {
+    *x = mousePos.x;
+    *y = mousePos.y;
+}
+
+bool HeadlessWindowBackend::shouldClose() {
+    return closeRequested || (frameLimit != 0 && framesRendered >= frameLimit);
+}
+
+void HeadlessWindowBackend::beginFrame() {
+}
+
+void HeadlessWindowBackend::endFrame() {
+    updateImGuiDisplay();
+}
+
+void HeadlessWindowBackend::destroyWindow() {
+}
+
+bool HeadlessWindowBackend::captureMouse() {
+    return false;
+}
+
+bool HeadlessWindowBackend::releaseMouse(bool returnToLastReleasedPos) {
+    return false;
+}
+
+bool HeadlessWindowBackend::isMouseCaptured() {
+    return false;
+}
+
+void HeadlessWindowBackend::getFramebufferSize(int *width, int *height) {
+    *width = this->width;
+    *height = this->height;
+}
+
+void HeadlessWindowBackend::waitForEvents() {
+}
+
+void HeadlessWindowBackend::postRendererInit() {
+    //The ImGui context only exists once the renderer is initialized, and it asserts on a zero display size if anything
+    //starts a frame before endFrame() has run.
+    updateImGuiDisplay();
+}
+
+void HeadlessWindowBackend::pollEvents() {
+    //The render loop polls once per frame, so this is used to count frames.
+    framesRendered++;
+}
+
+bool HeadlessWindowBackend::createVulkanSurface(VkInstance instance, VkSurfaceKHR *surface) {
+    return false;
+}
+
+const char **HeadlessWindowBackend::getRequiredInstanceExtensions(uint32_t &count) {
+    count = 0;
+    return nullptr;
+}
+
+bool HeadlessWindowBackend::isKeyPressed(uint32_t keyCode) {
+    return false;
+}
+
+glm::dvec2 HeadlessWindowBackend::getMouseDelta() {
+    return {0, 0};
+}
+
+glm::dvec2 HeadlessWindowBackend::getScrollDelta() {
+    return {0, 0};
+}
+
+bool HeadlessWindowBackend::isHeadless() {
+    return true;
+}
+
+void HeadlessWindowBackend::requestClose() {
+    closeRequested = true;
+}
+
+uint64_t HeadlessWindowBackend::getFramesRendered() const {
+    return framesRendered;
+}
+
+void HeadlessWindowBackend::updateImGuiDisplay() const {
+#ifdef XTP_USE_IMGUI_UI
+    //There is no platform backend to feed ImGui, so the display size of the offscreen images is provided here instead.
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(static_cast<float>(width), static_cast<float>(height));
+    io.DeltaTime = 1.0f / 60.0f;
+#endif
+}
@@ -0,0 +1,80 @@
+
+#ifndef HEADLESS_WINDOW_BACKEND_XTP_H
+#define HEADLESS_WINDOW_BACKEND_XTP_H
+
+#include <cstdint>
+
+#include "XTPWindowBackend.h"
+
+// A window backend that never opens a window or creates a surface. XTPVulkan renders into offscreen images instead of a
+// swapchain when this backend is active, which allows running the renderer on machines without a display (e.g. CI boxes
+// using lavapipe or SwiftShader).
+class HeadlessWindowBackend final: public XTPWindowBackend {
+public:
+    //If frameLimit is 0, the backend will only close once requestClose() is called.
+    explicit HeadlessWindowBackend(uint64_t frameLimit = 0);
+
+    ~HeadlessWindowBackend() override = default;
+
+    void createWindow() override;
+
+    void getWindowSize(int* width, int* height) override;
+
+    void setWindowSize(int width, int height) override;
+
+    void setMousePos(double x, double y) override;
+
+    void getMousePos(double* x, double* y) override;
+
+    bool shouldClose() override;
+
+    void beginFrame() override;
+
+    void endFrame() override;
+
+    void destroyWindow() override;
+
+    bool captureMouse() override;
+
+    bool releaseMouse(bool returnToLastReleasedPos) override;
+
+    bool isMouseCaptured() override;
+
+    void getFramebufferSize(int* width, int* height) override;
+
+    void waitForEvents() override;
+
+    void postRendererInit() override;
+
+    void pollEvents() override;
+
+    bool createVulkanSurface(VkInstance instance, VkSurfaceKHR* surface) override;
+
+    const char** getRequiredInstanceExtensions(uint32_t& count) override;
+
+    bool isKeyPressed(uint32_t keyCode) override;
+
+    glm::dvec2 getMouseDelta() override;
+
+    glm::dvec2 getScrollDelta() override;
+
+    bool isHeadless() override;
+
+    void requestClose();
+
+    [[nodiscard]] uint64_t getFramesRendered() const;
+
+private:
+    void updateImGuiDisplay() const;
+
+    int width = 0;
+    int height = 0;
+    glm::dvec2 mousePos {};
+    uint64_t frameLimit;
+    uint64_t framesRendered = 0;
+    bool closeRequested = false;
+};
+
+
+
+#endif //HEADLESS_WINDOW_BACKEND_XTP_H
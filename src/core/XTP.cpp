@@ -4,6 +4,7 @@
 #include "CleanUpEvent.h"
 #include "Events.h"
 #include "InitEvent.h"
+#include "Profiler.h"
 #include "TimeManager.h"
 
 #include "XTPWindowing.h"
@@ -11,21 +12,31 @@
 
 
 SimpleLogger* XTP::logger = new SimpleLogger("XTP Logger", DEBUG ? LogLevel::DEBUG: LogLevel::INFORMATION);
-Ticker* XTP::ticker;
+std::shared_ptr<Ticker> XTP::ticker;
+TickScheduler XTP::tickScheduler;
 std::thread XTP::updateThread;
+Ticker::Clock::time_point XTP::lastTickDeadline;
 // std::thread XTP::renderThread;
 
 void XTP::init(const std::chrono::nanoseconds tickInterval) {
     if (XTPWindowing::windowBackend == nullptr) {
         logger->logCritical("Windowing Backend Is Not Set!");
     }
+    if (VulkanRenderInfo::INSTANCE->useDeferredLogging()) {
+        AsyncLogWriter::start(VulkanRenderInfo::INSTANCE->getLogQueueCapacity());
+    }
+    Profiler::init(VulkanRenderInfo::INSTANCE->getProfilerFrameCount());
+    Profiler::setEnabled(VulkanRenderInfo::INSTANCE->useProfiler());
+    Profiler::setThreadName("Render");
     XTPWindowing::windowBackend->createWindow();
+    JobSystem::init(VulkanRenderInfo::INSTANCE->getJobWorkerCount());
     XTPVulkan::init();
     XTPWindowing::windowBackend->postRendererInit();
     TimeManager::startup();
     Events::callFunctionOnAllEventsOfType<InitEvent>([](auto e) {e->onInit();});
 
-    ticker = new Ticker(tickInterval, tick);
+    ticker = std::make_shared<Ticker>(tickInterval, tick);
+    tickScheduler.addTicker(ticker);
 
     updateThread = std::thread(runTicker);
     // renderThread = std::thread(render);
@@ -44,10 +55,14 @@ void XTP::init(const std::chrono::nanoseconds tickInterval) {
 void XTP::start(const std::chrono::nanoseconds tickInterval) {
     init(tickInterval);
     while (!XTPWindowing::windowBackend->shouldClose()) {
+        Profiler::beginFrame();
         XTPWindowing::windowBackend->pollEvents();
+        updateTickInterpolation();
         XTPVulkan::render();
+        Profiler::endFrame();
     }
     //Ensure that the thread exits gracefully
+    tickScheduler.stop();
     updateThread.join();
     // renderThread.join();
 
@@ -61,22 +76,44 @@ SimpleLogger* XTP::getLogger() {
 void XTP::cleanUp() {
     Events::callFunctionOnAllEventsOfType<CleanUpEvent>([](auto e) {e->cleanUp();});
     XTPVulkan::cleanUp();
+    JobSystem::cleanUp();
     XTPWindowing::windowBackend->destroyWindow();
+    AsyncLogWriter::stop();
     delete logger;
 }
 
 void XTP::runTicker() {
-    while (!XTPWindowing::windowBackend->shouldClose()) {
-        ticker->tryExecute();
+    Profiler::setThreadName("Tick");
+    tickScheduler.run();
+}
+
+void XTP::updateTickInterpolation() {
+    if (!VulkanRenderInfo::INSTANCE->interpolateTickState()) {
+        return;
     }
+    //The deadline is read first, so a tick that finishes in between only counts as finished for the next frame. Its
+    //state may already be acquired in this one, which SimpleIndexBufferedRenderable then draws from the start.
+    const Ticker::Clock::time_point deadline = ticker->getNextDeadline();
+    XTPVulkan::tickInterpolationAlpha = ticker->getInterpolationAlpha();
+    XTPVulkan::tickedSinceLastFrame = deadline != lastTickDeadline;
+    lastTickDeadline = deadline;
 }
 
 void XTP::tick() {
-    for (auto& [shader, renderables] : XTPVulkan::toRender) {
-        for (const auto&[material, renderables] : renderables) {
-            for (const auto& renderable : renderables) {
-                renderable->tick();
-            }
-        }
+    parallelForRenderables([](Renderable* renderable) {
+        renderable->tick();
+        renderable->publishTickState();
+    });
+}
+
+void XTP::parallelForRenderables(const std::function<void(Renderable*)>& function, const size_t grainSize) {
+    const auto renderables = std::atomic_load(&XTPVulkan::tickRenderables);
+    if (renderables == nullptr) {
+        return;
     }
+    JobSystem::parallelFor(renderables->size(), grainSize, [&function, &renderables](const size_t first, const size_t last) {
+        for (size_t i = first; i < last; ++i) {
+            function((*renderables)[i].get());
+        }
+    });
 }
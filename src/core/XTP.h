@@ -1,10 +1,14 @@
 #ifndef XTP_VQT_H
 #define XTP_VQT_H
 
+#include "JobSystem.h"
 #include "SimpleLogger.h"
 #include "Ticker.h"
+#include <memory>
 #include <thread>
 
+class Renderable;
+
 class XTP {
 
 
@@ -27,13 +31,26 @@ public:
 
     static void runTicker();
 
+    //Hands the ticker's interpolation alpha to the renderer for the frame about to be drawn.
+    static void updateTickInterpolation();
+
     static void tick();
 
+    //Calls function on every renderable the tick thread ticks, split across the JobSystem in batches of grainSize.
+    //Returns once all of them are done.
+    static void parallelForRenderables(const std::function<void(Renderable*)>& function, size_t grainSize = 64);
+
     static SimpleLogger* logger;
 
-    static Ticker* ticker;
+    //Runs tick() at the interval passed to init(). More tickers can be added to tickScheduler, and all of them run on
+    //updateThread.
+    static std::shared_ptr<Ticker> ticker;
+
+    static TickScheduler tickScheduler;
 
     static std::thread updateThread;
+    //The ticker's deadline when the last frame started, to tell whether a tick finished since.
+    static Ticker::Clock::time_point lastTickDeadline;
     // static std::thread renderThread;
 };
 
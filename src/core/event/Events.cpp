@@ -3,5 +3,34 @@
 //
 #include "Events.h"
 
-std::vector<std::unique_ptr<Event>> Events::registeredEvents;
-SimpleLogger* Events::logger = new SimpleLogger("XTP Events", INFORMATION);
\ No newline at end of file
+#include <algorithm>
+
+std::shared_ptr<const Events::EventList> Events::registeredEvents = std::make_shared<const EventList>();
+SimpleLogger* Events::logger = new SimpleLogger("XTP Events", INFORMATION);
+
+void Events::registerEvent(std::unique_ptr<Event> event) {
+    ZoneScopedN("Events::registerEvent");
+    const std::shared_ptr<Event> registered = std::move(event);
+    std::shared_ptr<const EventList> current = std::atomic_load(&registeredEvents);
+    std::shared_ptr<const EventList> updated;
+    do {
+        auto events = std::make_shared<EventList>(*current);
+        events->emplace_back(registered);
+        updated = std::move(events);
+    } while (!std::atomic_compare_exchange_weak(&registeredEvents, &current, updated));
+    generation.fetch_add(1, std::memory_order_release);
+}
+
+void Events::unregisterEvent(const Event *event) {
+    ZoneScopedN("Events::unregisterEvent");
+    std::shared_ptr<const EventList> current = std::atomic_load(&registeredEvents);
+    std::shared_ptr<const EventList> updated;
+    do {
+        auto events = std::make_shared<EventList>(*current);
+        events->erase(std::remove_if(events->begin(), events->end(), [event](const std::shared_ptr<Event> &registered) {
+            return registered.get() == event;
+        }), events->end());
+        updated = std::move(events);
+    } while (!std::atomic_compare_exchange_weak(&registeredEvents, &current, updated));
+    generation.fetch_add(1, std::memory_order_release);
+}
@@ -1,36 +1,82 @@
 
 #ifndef EVENTS_H
 #define EVENTS_H
-#include <functional>
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <vector>
 #ifdef TRACY_ENABLE
 #include <tracy/Tracy.hpp>
 #else
-#define ZoneScopedN(name)
+#include "Profiler.h"
 #endif
 
 #include "Event.h"
 #include "SimpleLogger.h"
 
 
+//Events can be registered, unregistered and dispatched from any thread at the same time. The registered events are an
+//immutable list that is swapped out as a whole when it changes, and every event type keeps its own list of listeners
+//built from it, so dispatching is a loop over that list without any casts.
+//The lists are shared_ptrs read with std::atomic_load, which libstdc++ and MSVC implement by locking a mutex from a
+//small global pool for the duration of the copy. Dispatching takes one of those locks, to get its event type's list,
+//and a second one to rebuild it if the registered events changed since it was built.
 class Events {
 public:
-    static std::vector<std::unique_ptr<Event>> registeredEvents;
-
     static SimpleLogger* logger;
 
-    static void registerEvent(std::unique_ptr<Event> event) {
-        ZoneScopedN("Events::registerEvent");
-        registeredEvents.emplace_back(std::move(event));
-    }
+    static void registerEvent(std::unique_ptr<Event> event);
+
+    //Dispatches that are already running still call the event, it is destroyed once the last of them has finished.
+    static void unregisterEvent(const Event* event);
 
-    template <class EventClass> static void callFunctionOnAllEventsOfType(const std::function<void(EventClass*)>& func) {
+    template <class EventClass, class Function> static void callFunctionOnAllEventsOfType(const Function& func) {
         ZoneScopedN("Events::callFunctionOnAllEventsOfType");
-        for (const std::unique_ptr<Event>& event : registeredEvents) {
+        //Holding the list keeps its events alive, even if they are unregistered while they are being called.
+        const std::shared_ptr<const ListenerList<EventClass>> listeners = getListeners<EventClass>();
+        for (EventClass* event : listeners->listeners) {
+            func(event);
+        }
+    }
+
+private:
+    using EventList = std::vector<std::shared_ptr<Event>>;
+
+    template <class EventClass> struct ListenerList {
+        //The registered events the listeners were found in, which keep them alive.
+        std::shared_ptr<const EventList> source;
+        //The generation read before source was loaded, so a list built while the events change is never current.
+        uint64_t generation;
+        std::vector<EventClass*> listeners;
+    };
+
+    static std::shared_ptr<const EventList> registeredEvents;
+    //Bumped after every change to registeredEvents, so dispatching can tell its list is current without loading them.
+    static inline std::atomic<uint64_t> generation {0};
+
+    //One list per event type, rebuilt the first time the type is dispatched after the registered events changed.
+    template <class EventClass> static inline std::shared_ptr<const ListenerList<EventClass>> listenerLists;
+
+    template <class EventClass> static std::shared_ptr<const ListenerList<EventClass>> getListeners() {
+        const uint64_t current = generation.load(std::memory_order_acquire);
+        std::shared_ptr<const ListenerList<EventClass>> listeners = std::atomic_load(&listenerLists<EventClass>);
+        if (listeners != nullptr && listeners->generation == current) {
+            return listeners;
+        }
+
+        //Two threads may rebuild the same list at once, which is harmless since both build the same one. A list built
+        //from an older snapshot is simply rebuilt again by the next dispatch.
+        auto rebuilt = std::make_shared<ListenerList<EventClass>>();
+        rebuilt->source = std::atomic_load(&registeredEvents);
+        rebuilt->generation = current;
+        for (const std::shared_ptr<Event>& event : *rebuilt->source) {
             if (auto* ev = dynamic_cast<EventClass*>(event.get()); ev != nullptr) {
-                func(ev);
+                rebuilt->listeners.emplace_back(ev);
             }
         }
+        listeners = std::move(rebuilt);
+        std::atomic_store(&listenerLists<EventClass>, listeners);
+        return listeners;
     }
 };
 
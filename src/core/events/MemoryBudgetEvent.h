@@ -0,0 +1,14 @@
+#ifndef MEMORYBUDGETEVENT_H
+#define MEMORYBUDGETEVENT_H
+#include "Event.h"
+#include "GpuStatistics.h"
+
+//Called on the render thread when a heap's usage goes over VulkanRenderInfo::getMemoryBudgetThreshold() of its budget,
+//e.g. to evict textures before the driver starts paging. It is only called again for that heap once usage has dropped
+//back below the threshold first.
+class MemoryBudgetEvent: public Event {
+public:
+    virtual void onMemoryBudgetThreshold(uint32_t heapIndex, const MemoryHeapStatistics &heap) = 0;
+};
+
+#endif //MEMORYBUDGETEVENT_H
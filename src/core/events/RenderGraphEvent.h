@@ -0,0 +1,16 @@
+
+#ifndef RENDERGRAPHEVENT_H
+#define RENDERGRAPHEVENT_H
+#include "Event.h"
+#include "graph/RenderGraph.h"
+
+//Only called when frames are drawn with dynamic rendering, since the render graph records every pass of the frame.
+class RenderGraphEvent: public Event {
+public:
+    //For passes the scene depends on, like shadow maps. Add their outputs to sceneUses so the scene pass waits for them.
+    virtual void onBuildPassesBeforeScene(RenderGraph &graph, std::vector<RenderGraphUse> &sceneUses) = 0;
+    //For passes that work on the drawn scene, like post processing.
+    virtual void onBuildPassesAfterScene(RenderGraph &graph, RenderGraphResource color, RenderGraphResource depth) = 0;
+};
+
+#endif //RENDERGRAPHEVENT_H
\ No newline at end of file
@@ -0,0 +1,176 @@
+#include "AsyncLogWriter.h"
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+
+std::unique_ptr<AsyncLogWriter::Slot[]> AsyncLogWriter::slots;
+size_t AsyncLogWriter::mask;
+std::atomic<size_t> AsyncLogWriter::pushPosition;
+size_t AsyncLogWriter::popPosition;
+std::atomic<size_t> AsyncLogWriter::writtenCount;
+std::atomic<size_t> AsyncLogWriter::droppedCount;
+std::atomic<bool> AsyncLogWriter::running;
+std::atomic<uint32_t> AsyncLogWriter::activeWriters;
+std::atomic<bool> AsyncLogWriter::writerSleeping;
+bool AsyncLogWriter::stopping;
+std::mutex AsyncLogWriter::wakeMutex;
+std::condition_variable AsyncLogWriter::wake;
+std::thread AsyncLogWriter::writer;
+
+//How long the writer sleeps at most when a wake up was missed.
+static constexpr std::chrono::milliseconds MAX_SLEEP {5};
+
+void AsyncLogWriter::start(const size_t capacity) {
+    if (isRunning()) {
+        return;
+    }
+    size_t slotCount = 2;
+    while (slotCount < capacity) {
+        slotCount *= 2;
+    }
+    slots = std::make_unique<Slot[]>(slotCount);
+    for (size_t i = 0; i < slotCount; ++i) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    mask = slotCount - 1;
+    pushPosition.store(0, std::memory_order_relaxed);
+    popPosition = 0;
+    writtenCount.store(0, std::memory_order_relaxed);
+    droppedCount.store(0, std::memory_order_relaxed);
+    stopping = false;
+    writer = std::thread(writerLoop);
+    running.store(true, std::memory_order_release);
+}
+
+void AsyncLogWriter::stop() {
+    if (!isRunning()) {
+        return;
+    }
+    running.store(false);
+    //Anyone who saw the writer running is counted by now. Waiting lets their lines, and ERROR lines waiting to be
+    //written, through while the writer thread is still draining.
+    while (activeWriters.load() > 0) {
+        std::this_thread::yield();
+    }
+    {
+        std::lock_guard lock(wakeMutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    writer.join();
+    slots.reset();
+}
+
+bool AsyncLogWriter::isRunning() {
+    return running.load(std::memory_order_acquire);
+}
+
+bool AsyncLogWriter::write(std::string &line, const LogLevel severity) {
+    //Counted before checking running, and stop() clears running before checking the count, so stop() either sees this
+    //thread or this thread sees that it is stopping.
+    activeWriters.fetch_add(1);
+    const bool pushed = running.load();
+    if (pushed) {
+        push(line, severity);
+    }
+    activeWriters.fetch_sub(1, std::memory_order_release);
+    return pushed;
+}
+
+void AsyncLogWriter::push(std::string &line, const LogLevel severity) {
+    size_t position;
+    while (!tryPush(line, severity, position)) {
+        if (severity < WARNING) {
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        std::this_thread::yield();
+    }
+
+    if (severity >= ERROR || writerSleeping.load(std::memory_order_acquire)) {
+        std::lock_guard lock(wakeMutex);
+        wake.notify_one();
+    }
+    if (severity >= ERROR) {
+        while (writtenCount.load(std::memory_order_acquire) <= position) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool AsyncLogWriter::tryPush(std::string &line, const LogLevel severity, size_t &position) {
+    position = pushPosition.load(std::memory_order_relaxed);
+    while (true) {
+        const size_t sequence = slots[position & mask].sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+        if (difference == 0) {
+            if (pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            //The writer hasn't popped the line a whole lap ago yet, so the queue is full.
+            return false;
+        } else {
+            position = pushPosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    Slot &slot = slots[position & mask];
+    slot.line = std::move(line);
+    slot.severity = severity;
+    slot.sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+bool AsyncLogWriter::hasQueued() {
+    return slots[popPosition & mask].sequence.load(std::memory_order_acquire) == popPosition + 1;
+}
+
+size_t AsyncLogWriter::drain() {
+    size_t count = 0;
+    bool wroteErrors = false;
+    while (hasQueued()) {
+        Slot &slot = slots[popPosition & mask];
+        if (slot.severity >= ERROR) {
+            std::cerr << slot.line;
+            wroteErrors = true;
+        } else {
+            std::cout << slot.line;
+        }
+        slot.line.clear();
+        slot.sequence.store(popPosition + mask + 1, std::memory_order_release);
+        ++popPosition;
+        ++count;
+    }
+
+    if (const size_t dropped = droppedCount.exchange(0, std::memory_order_relaxed); dropped > 0) {
+        std::cout << "[Log Writer] - WARNING: " << dropped << " Lines Were Dropped Because The Queue Was Full!\n";
+    }
+    if (count > 0) {
+        std::cout.flush();
+        if (wroteErrors) {
+            std::cerr.flush();
+        }
+        writtenCount.fetch_add(count, std::memory_order_release);
+    }
+    return count;
+}
+
+void AsyncLogWriter::writerLoop() {
+    while (true) {
+        if (drain() > 0) {
+            continue;
+        }
+
+        std::unique_lock lock(wakeMutex);
+        writerSleeping.store(true, std::memory_order_release);
+        wake.wait_for(lock, MAX_SLEEP, [] { return stopping || hasQueued(); });
+        writerSleeping.store(false, std::memory_order_relaxed);
+        if (stopping) {
+            lock.unlock();
+            drain();
+            return;
+        }
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef XTP_ASYNCLOGWRITER_H
+#define XTP_ASYNCLOGWRITER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "LogLevel.h"
+
+//Writes the lines of every SimpleLogger on its own thread while it is running, so logging only costs formatting the line
+//and pushing it into a bounded lock-free queue. Any thread may push, only the writer thread pops.
+class AsyncLogWriter {
+public:
+    //capacity is rounded up to a power of two.
+    static void start(size_t capacity);
+
+    //Waits for lines that are being pushed and writes everything still queued before returning. Lines logged after this
+    //has started are either written before it returns or left to the caller.
+    static void stop();
+
+    [[nodiscard]] static bool isRunning();
+
+    //Returns false, leaving line alone, if the writer isn't running, in which case the caller writes the line itself.
+    //If the queue is full, lines below WARNING are dropped and others wait for space. ERROR and CRITICAL lines also
+    //wait until they have been written, so they aren't lost if the process dies right after.
+    static bool write(std::string &line, LogLevel severity);
+
+private:
+    struct Slot {
+        //Equal to the position of the line that may be pushed into it, or one more than that once it has been.
+        std::atomic<size_t> sequence;
+        std::string line;
+        LogLevel severity;
+    };
+
+    static std::unique_ptr<Slot[]> slots;
+    static size_t mask;
+    static std::atomic<size_t> pushPosition;
+    //Only used by the writer thread.
+    static size_t popPosition;
+    static std::atomic<size_t> writtenCount;
+    static std::atomic<size_t> droppedCount;
+    static std::atomic<bool> running;
+    //Threads inside write(), which stop() waits for so no line is pushed after the last drain.
+    static std::atomic<uint32_t> activeWriters;
+    static std::atomic<bool> writerSleeping;
+    static bool stopping;
+    static std::mutex wakeMutex;
+    static std::condition_variable wake;
+    static std::thread writer;
+
+    static void push(std::string &line, LogLevel severity);
+
+    static bool tryPush(std::string &line, LogLevel severity, size_t &position);
+
+    static bool hasQueued();
+
+    //Writes every queued line, returning how many there were.
+    static size_t drain();
+
+    static void writerLoop();
+};
+
+
+
+#endif //XTP_ASYNCLOGWRITER_H
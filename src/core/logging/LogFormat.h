@@ -0,0 +1,62 @@
+#ifndef XTP_LOGFORMAT_H
+#define XTP_LOGFORMAT_H
+
+#include <charconv>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+//Builds log lines from a message with {} placeholders, like fmt does, without going through iostreams.
+class LogFormat {
+public:
+    //Appends message to line, with each {} replaced by the next argument. Placeholders without an argument are kept as
+    //they are, and arguments without a placeholder are left out.
+    template<class... Args>
+    static void format(std::string &line, const std::string_view message, const Args &... args) {
+        size_t start = 0;
+        (appendNext(line, message, start, args), ...);
+        line.append(message.substr(start));
+    }
+
+    template<class T>
+    static void append(std::string &line, const T &value) {
+        if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            line.append(std::string_view(value));
+        } else if constexpr (std::is_same_v<T, bool>) {
+            line.append(value ? "true" : "false");
+        } else if constexpr (std::is_same_v<T, char>) {
+            line.push_back(value);
+        } else if constexpr (std::is_enum_v<T>) {
+            append(line, static_cast<std::underlying_type_t<T>>(value));
+        } else if constexpr (std::is_integral_v<T>) {
+            char buffer[24];
+            const std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+            line.append(buffer, result.ptr);
+        } else if constexpr (std::is_floating_point_v<T>) {
+            char buffer[32];
+            const int length = snprintf(buffer, sizeof(buffer), "%g", static_cast<double>(value));
+            line.append(buffer, static_cast<size_t>(length));
+        } else if constexpr (std::is_pointer_v<T>) {
+            char buffer[24];
+            const int length = snprintf(buffer, sizeof(buffer), "%p", static_cast<const void*>(value));
+            line.append(buffer, static_cast<size_t>(length));
+        } else {
+            static_assert(!sizeof(T), "This type can't be logged, convert it to a string first.");
+        }
+    }
+
+private:
+    template<class T>
+    static void appendNext(std::string &line, const std::string_view message, size_t &start, const T &value) {
+        const size_t placeholder = message.find("{}", start);
+        if (placeholder == std::string_view::npos) {
+            return;
+        }
+        line.append(message.substr(start, placeholder - start));
+        append(line, value);
+        start = placeholder + 2;
+    }
+};
+
+#endif //XTP_LOGFORMAT_H
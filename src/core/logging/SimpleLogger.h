@@ -1,101 +1,138 @@
-
 #ifndef XTP_SIMPLELOGGER_H
 #define XTP_SIMPLELOGGER_H
 
-#include <string>
 #include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 #ifdef TRACY_ENABLE
 #include "tracy/Tracy.hpp"
 #else
-#define ZoneScopedN(e)
+#include "Profiler.h"
 #endif
 
+#include "AsyncLogWriter.h"
+#include "LogFormat.h"
 #include "LogLevel.h"
 
+//Calls below this level are compiled out entirely, whatever level a logger is created with.
+#ifndef XTP_MIN_LOG_LEVEL
+#define XTP_MIN_LOG_LEVEL 0
+#endif
+
 class SimpleLogger {
 public:
+    static constexpr LogLevel MIN_LEVEL = static_cast<LogLevel>(XTP_MIN_LOG_LEVEL);
+
     SimpleLogger(std::string name, LogLevel level) {
-        ZoneScopedN("new");
         loggerName = std::move(name);
         logLevel = level;
     }
 
-    void logTrace(const std::string &s) const {
-        ZoneScopedN("logTrace");
-        log(s, TRACE);
+    //Every {} in the message is replaced by the next argument. Nothing is formatted unless the message is logged.
+    template<class... Args>
+    void logTrace(const std::string_view message, const Args &... args) const {
+        log<TRACE>(message, args...);
     }
 
-    void logDebug(const std::string &s) const {
-        ZoneScopedN("logDebug");
-        log(s, DEBUG);
+    template<class... Args>
+    void logDebug(const std::string_view message, const Args &... args) const {
+        log<DEBUG>(message, args...);
     }
 
-    void logInformation(const std::string &s) const {
-        ZoneScopedN("logInformation");
-        log(s, INFORMATION);
+    template<class... Args>
+    void logInformation(const std::string_view message, const Args &... args) const {
+        log<INFORMATION>(message, args...);
     }
 
-    void logWarning(const std::string &s) const {
-        ZoneScopedN("logWarning");
-        log(s, WARNING);
+    template<class... Args>
+    void logWarning(const std::string_view message, const Args &... args) const {
+        log<WARNING>(message, args...);
     }
 
     void logError(const std::string &s, const bool thr = true) const {
-        ZoneScopedN("logError");
         if (thr) {
             throw std::runtime_error(s);
         }
-        log(s, ERROR);
+        log<ERROR>(s);
     }
 
     void logCritical(const std::string &s, const bool thr = true) const {
-        ZoneScopedN("logCritical");
         if (thr) {
             throw std::runtime_error(s);
         }
-        log(s, CRITICAL);
+        log<CRITICAL>(s);
+    }
+
+    //Like the above, with every {} in the message replaced by the next argument. thr has to be passed, so the first
+    //argument isn't taken for it.
+    template<class First, class... Rest>
+    void logError(const std::string_view message, const bool thr, const First &first, const Rest &... rest) const {
+        if (thr) {
+            throwFormatted(message, first, rest...);
+        }
+        log<ERROR>(message, first, rest...);
+    }
+
+    template<class First, class... Rest>
+    void logCritical(const std::string_view message, const bool thr, const First &first, const Rest &... rest) const {
+        if (thr) {
+            throwFormatted(message, first, rest...);
+        }
+        log<CRITICAL>(message, first, rest...);
     }
 
     [[nodiscard]] LogLevel getLogLevel() const {
-        ZoneScopedN("getLogLevel");
         return logLevel;
     }
 
 private:
     std::string loggerName;
     LogLevel logLevel;
-    void log(const std::string& message, LogLevel severity) const {
-        ZoneScopedN("log");
-        if (severity >= logLevel) {
-            if (severity == CRITICAL || severity == ERROR) {
-                std::cerr << "[" << loggerName << "] - " << getLogLevelName(severity) << ": " << message << "\n";
-            } else {
-                std::cout << "[" << loggerName << "] - " << getLogLevelName(severity) << ": " << message << "\n";
+
+    template<LogLevel severity, class... Args>
+    void log(const std::string_view message, const Args &... args) const {
+        if constexpr (severity >= MIN_LEVEL) {
+            if (severity >= logLevel) {
+                write(severity, message, args...);
             }
         }
     }
 
-    // ReSharper disable once CppDFAConstantFunctionResult
-    static std::string getLogLevelName(const LogLevel level) {
-        ZoneScopedN("getLevelName");
-        std::string toReturn = "invalid";
+    template<class... Args>
+    [[noreturn]] static void throwFormatted(const std::string_view message, const Args &... args) {
+        std::string what;
+        LogFormat::format(what, message, args...);
+        throw std::runtime_error(what);
+    }
+
+    //Lines go to the AsyncLogWriter if it is running, otherwise they are written on the calling thread.
+    template<class... Args>
+    void write(const LogLevel severity, const std::string_view message, const Args &... args) const {
+        ZoneScopedN("SimpleLogger::write");
+        const std::string_view levelName = getLogLevelName(severity);
+        std::string line;
+        line.reserve(loggerName.size() + levelName.size() + message.size() + 8);
+        line.append("[").append(loggerName).append("] - ").append(levelName).append(": ");
+        LogFormat::format(line, message, args...);
+        line.push_back('\n');
+
+        if (!AsyncLogWriter::write(line, severity)) {
+            (severity == CRITICAL || severity == ERROR ? std::cerr : std::cout) << line;
+        }
+    }
+
+    static constexpr std::string_view getLogLevelName(const LogLevel level) {
         switch (level) {
-            case TRACE: toReturn = "TRACE";
-            break;
-            case DEBUG: toReturn = "DEBUG";
-            break;
-            case INFORMATION: toReturn = "INFORMATION";
-            break;
-            case WARNING: toReturn = "WARNING";
-            break;
-            case ERROR: toReturn = "ERROR";
-            break;
-            case CRITICAL: toReturn = "CRITICAL";
-            break;
-            case NONE:
-                break;
+            case TRACE: return "TRACE";
+            case DEBUG: return "DEBUG";
+            case INFORMATION: return "INFORMATION";
+            case WARNING: return "WARNING";
+            case ERROR: return "ERROR";
+            case CRITICAL: return "CRITICAL";
+            case NONE: break;
         }
-        return toReturn;
+        return "invalid";
     }
 };
 
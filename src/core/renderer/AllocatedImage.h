@@ -15,6 +15,10 @@ struct AllocatedImage {
     VmaAllocationInfo allocationInfo;
     VkImageView imageView;
     VkSampler sampler;
+    uint32_t mipLevels;
+    //Indices into the BindlessTable, 0 (the error texture and its sampler) until the image is added to it.
+    uint32_t bindlessIndex = 0;
+    uint32_t bindlessSamplerIndex = 0;
 };
 
 
@@ -0,0 +1,221 @@
+#include "AssetStreamer.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "AssetFile.h"
+#include "CompressedTexture.h"
+#include "stb_image.h"
+#include "VulkanRenderInfo.h"
+#include "XTPVulkan.h"
+#include "renderable/StreamedMesh.h"
+
+std::vector<std::thread> AssetStreamer::workers;
+std::deque<std::function<AssetStreamer::PendingUpload()>> AssetStreamer::jobs;
+std::mutex AssetStreamer::jobMutex;
+std::condition_variable AssetStreamer::jobAvailable;
+bool AssetStreamer::stopping;
+std::deque<AssetStreamer::PendingUpload> AssetStreamer::pendingUploads;
+std::mutex AssetStreamer::uploadMutex;
+std::exception_ptr AssetStreamer::loadError;
+
+bool StreamedTexture::isReady() const {
+    return state.load(std::memory_order_acquire) == READY;
+}
+
+bool StreamedTexture::hasFailed() const {
+    return state.load(std::memory_order_acquire) == FAILED;
+}
+
+AllocatedImage StreamedTexture::getImage() const {
+    return isReady() ? image : XTPVulkan::errorTexure;
+}
+
+void AssetStreamer::init() {
+    ZoneScopedN("AssetStreamer::init");
+    stopping = false;
+    const uint32_t threadCount = std::max(1u, VulkanRenderInfo::INSTANCE->getStreamingThreadCount());
+    for (uint32_t i = 0; i < threadCount; ++i) {
+        workers.emplace_back(workerLoop);
+    }
+}
+
+void AssetStreamer::cleanUp() {
+    {
+        std::lock_guard lock(jobMutex);
+        stopping = true;
+        jobs.clear();
+    }
+    jobAvailable.notify_all();
+    for (std::thread &worker: workers) {
+        worker.join();
+    }
+    workers.clear();
+
+    std::lock_guard lock(uploadMutex);
+    pendingUploads.clear();
+}
+
+std::shared_ptr<StreamedTexture> AssetStreamer::loadTexture(const std::string &path, const VkFormat format,
+                                                            TextureCallback &&onReady) {
+    auto texture = std::make_shared<StreamedTexture>();
+
+    //Runs on the render thread, once the texture has been decoded.
+    auto finish = [texture, onReady = std::move(onReady)](const AllocatedImage &image) {
+        if (image.image == XTPVulkan::errorTexure.image) {
+            texture->state.store(StreamedTexture::FAILED, std::memory_order_release);
+            return;
+        }
+        texture->image = image;
+        texture->state.store(StreamedTexture::READY, std::memory_order_release);
+        if (onReady != nullptr) {
+            onReady(image);
+        }
+    };
+
+    enqueue([texture, path, format, finish]() -> PendingUpload {
+        ZoneScopedN("AssetStreamer::loadTexture#decode");
+        if (CompressedTextureLoader::isCompressedTexturePath(path)) {
+            auto compressed = std::make_shared<CompressedTexture>();
+            if (!CompressedTextureLoader::load(path, CompressedTextureLoader::isSrgbFormat(format), *compressed)) {
+                texture->state.store(StreamedTexture::FAILED, std::memory_order_release);
+                return {0, nullptr};
+            }
+            return {compressed->data.size(), [compressed, finish] {
+                finish(XTPVulkan::createCompressedImage(*compressed));
+            }};
+        }
+
+        const AssetFile file(path);
+        int width, height, channels;
+        std::shared_ptr<stbi_uc> pixels(file.isOpen() && file.size() <= std::numeric_limits<int>::max() ?
+                                            stbi_load_from_memory(file.data(), static_cast<int>(file.size()), &width,
+                                                                  &height, &channels, STBI_rgb_alpha) :
+                                            nullptr, stbi_image_free);
+        if (pixels == nullptr) {
+            XTPVulkan::logger->logError("Failed To Load Texture '{}'!", false, path);
+            texture->state.store(StreamedTexture::FAILED, std::memory_order_release);
+            return {0, nullptr};
+        }
+
+        const VkDeviceSize size = static_cast<VkDeviceSize>(width) * height * 4;
+        return {size, [pixels, size, format, width, height, finish] {
+            finish(XTPVulkan::createImage(pixels.get(), size, format, width, height));
+        }};
+    });
+
+    return texture;
+}
+
+std::shared_ptr<StreamedMesh> AssetStreamer::loadMesh(std::function<std::shared_ptr<Mesh>()> &&load,
+                                                      const std::shared_ptr<Mesh> &placeholder) {
+    auto streamedMesh = std::make_shared<StreamedMesh>(placeholder);
+
+    enqueue([streamedMesh, load = std::move(load)]() -> PendingUpload {
+        ZoneScopedN("AssetStreamer::loadMesh#load");
+        std::shared_ptr<Mesh> mesh = load();
+        if (mesh == nullptr) {
+            return {0, nullptr};
+        }
+
+        return {mesh->getUploadSize(), [streamedMesh, mesh] {
+            //Removed before it finished loading.
+            if (streamedMesh->destroyed()) {
+                return;
+            }
+            if (!mesh->initialized()) {
+                mesh->init();
+            }
+            streamedMesh->mesh = mesh;
+            streamedMesh->ready.store(true, std::memory_order_release);
+        }};
+    });
+
+    return streamedMesh;
+}
+
+void AssetStreamer::readFile(const std::string &path, FileCallback &&onRead) {
+    enqueue([path, onRead = std::move(onRead)]() -> PendingUpload {
+        ZoneScopedN("AssetStreamer::readFile#read");
+        auto file = std::make_shared<AssetFile>(path);
+        file->populate();
+        return {0, [file, onRead] {
+            onRead(*file);
+        }};
+    });
+}
+
+void AssetStreamer::onFrame() {
+    ZoneScopedN("AssetStreamer::onFrame");
+    {
+        std::lock_guard lock(jobMutex);
+        if (loadError != nullptr) {
+            std::rethrow_exception(std::exchange(loadError, nullptr));
+        }
+    }
+
+    const VkDeviceSize budget = VulkanRenderInfo::INSTANCE->getStreamingUploadBudget();
+    VkDeviceSize uploaded = 0;
+    bool first = true;
+    while (true) {
+        PendingUpload upload;
+        {
+            std::lock_guard lock(uploadMutex);
+            if (pendingUploads.empty()) {
+                break;
+            }
+            //The first upload of a frame always goes through, so assets bigger than the budget still load.
+            if (!first && uploaded + pendingUploads.front().size > budget) {
+                break;
+            }
+            upload = std::move(pendingUploads.front());
+            pendingUploads.pop_front();
+        }
+
+        upload.upload();
+        uploaded += upload.size;
+        first = false;
+    }
+}
+
+size_t AssetStreamer::getPendingUploadCount() {
+    std::lock_guard lock(uploadMutex);
+    return pendingUploads.size();
+}
+
+void AssetStreamer::enqueue(std::function<PendingUpload()> &&job) {
+    {
+        std::lock_guard lock(jobMutex);
+        jobs.emplace_back(std::move(job));
+    }
+    jobAvailable.notify_one();
+}
+
+void AssetStreamer::workerLoop() {
+    while (true) {
+        std::function<PendingUpload()> job;
+        {
+            std::unique_lock lock(jobMutex);
+            jobAvailable.wait(lock, [] { return stopping || !jobs.empty(); });
+            if (stopping) {
+                return;
+            }
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+
+        try {
+            PendingUpload upload = job();
+            if (upload.upload != nullptr) {
+                std::lock_guard lock(uploadMutex);
+                pendingUploads.emplace_back(std::move(upload));
+            }
+        } catch (...) {
+            std::lock_guard lock(jobMutex);
+            if (loadError == nullptr) {
+                loadError = std::current_exception();
+            }
+        }
+    }
+}
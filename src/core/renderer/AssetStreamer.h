@@ -0,0 +1,103 @@
+#ifndef ASSETSTREAMER_H
+#define ASSETSTREAMER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AllocatedImage.h"
+
+class AssetFile;
+class Mesh;
+class StreamedMesh;
+
+//A texture loaded by the AssetStreamer. Until it has been uploaded, or if it fails to load, getImage() returns the error
+//texture.
+class StreamedTexture {
+public:
+    [[nodiscard]] bool isReady() const;
+
+    [[nodiscard]] bool hasFailed() const;
+
+    [[nodiscard]] AllocatedImage getImage() const;
+
+private:
+    friend class AssetStreamer;
+
+    enum State : uint8_t {
+        LOADING,
+        READY,
+        FAILED
+    };
+
+    std::atomic<State> state {LOADING};
+    //Only written before state becomes READY.
+    AllocatedImage image {};
+};
+
+//Loads assets on background threads, so new content never stalls the render thread on decoding. Everything that touches
+//the device happens in onFrame(), on the render thread, which uploads at most VulkanRenderInfo::getStreamingUploadBudget()
+//bytes per frame (but always at least one asset) so a burst of new assets is spread over several frames.
+class AssetStreamer {
+public:
+    using TextureCallback = std::function<void(const AllocatedImage &image)>;
+    using FileCallback = std::function<void(const AssetFile &file)>;
+
+    static void init();
+
+    //Stops the loading threads. Assets that haven't been uploaded yet are dropped.
+    static void cleanUp();
+
+    //Decodes the texture like XTPVulkan::createImage(path, format) would. onReady is called on the render thread once
+    //the image has been uploaded, e.g. to point a descriptor set at it.
+    static std::shared_ptr<StreamedTexture> loadTexture(const std::string &path,
+                                                        VkFormat format = VK_FORMAT_R8G8B8A8_SRGB,
+                                                        TextureCallback &&onReady = nullptr);
+
+    //Calls load on a loading thread, then initializes the mesh it returns on the render thread. The returned mesh draws
+    //placeholder until then, or nothing if there is none.
+    static std::shared_ptr<StreamedMesh> loadMesh(std::function<std::shared_ptr<Mesh>()> &&load,
+                                                  const std::shared_ptr<Mesh> &placeholder = nullptr);
+
+    //Opens the asset like AssetFile does, from a mounted archive or else the loose file, and reads all of it in on a
+    //loading thread, then calls onRead with it on the render thread, where it can be read in place without blocking on
+    //the disk. The file isn't open if it couldn't be read, and is released once onRead returns. Files don't count
+    //towards the upload budget.
+    static void readFile(const std::string &path, FileCallback &&onRead);
+
+    //Uploads loaded assets, up to the per frame budget. Must be called on the render thread before the frame is recorded.
+    static void onFrame();
+
+    //How many loaded assets are waiting for their upload.
+    [[nodiscard]] static size_t getPendingUploadCount();
+
+private:
+    struct PendingUpload {
+        VkDeviceSize size;
+        std::function<void()> upload;
+    };
+
+    static std::vector<std::thread> workers;
+    static std::deque<std::function<PendingUpload()>> jobs;
+    static std::mutex jobMutex;
+    static std::condition_variable jobAvailable;
+    static bool stopping;
+    static std::deque<PendingUpload> pendingUploads;
+    static std::mutex uploadMutex;
+    static std::exception_ptr loadError;
+
+    static void enqueue(std::function<PendingUpload()> &&job);
+
+    static void workerLoop();
+};
+
+
+
+#endif //ASSETSTREAMER_H
@@ -0,0 +1,199 @@
+#include "BindlessTable.h"
+
+#include <algorithm>
+#include <array>
+
+#include "AllocatedImage.h"
+#include "UploadManager.h"
+#include "VulkanRenderInfo.h"
+#include "XTPVulkan.h"
+
+bool BindlessTable::enabled;
+VkDescriptorSetLayout BindlessTable::layout;
+VkDescriptorPool BindlessTable::pool;
+VkDescriptorSet BindlessTable::set;
+uint32_t BindlessTable::textureCapacity;
+uint32_t BindlessTable::samplerCapacity;
+uint32_t BindlessTable::materialCapacity;
+uint32_t BindlessTable::textureCount;
+uint32_t BindlessTable::samplerCount;
+uint32_t BindlessTable::materialCount;
+AllocatedBuffer BindlessTable::materialBuffer;
+
+void BindlessTable::init() {
+    ZoneScopedN("BindlessTable::init");
+    if (!enabled) {
+        return;
+    }
+
+    VkPhysicalDeviceVulkan12Properties properties12 {};
+    properties12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES;
+    VkPhysicalDeviceProperties2 properties {};
+    properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+    properties.pNext = &properties12;
+    vkGetPhysicalDeviceProperties2(XTPVulkan::gpu, &properties);
+
+    textureCapacity = std::min({VulkanRenderInfo::INSTANCE->getBindlessTextureCount(),
+                                properties12.maxDescriptorSetUpdateAfterBindSampledImages,
+                                properties12.maxPerStageDescriptorUpdateAfterBindSampledImages});
+    samplerCapacity = std::min({VulkanRenderInfo::INSTANCE->getBindlessSamplerCount(),
+                                properties12.maxDescriptorSetUpdateAfterBindSamplers,
+                                properties12.maxPerStageDescriptorUpdateAfterBindSamplers,
+                                properties.properties.limits.maxSamplerAllocationCount});
+    materialCapacity = VulkanRenderInfo::INSTANCE->getBindlessMaterialCount();
+    textureCount = 0;
+    samplerCount = 0;
+    materialCount = 0;
+
+    const std::array<VkDescriptorSetLayoutBinding, 2> bindings {{
+        {TEXTURE_BINDING, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, textureCapacity, VK_SHADER_STAGE_ALL_GRAPHICS, nullptr},
+        {SAMPLER_BINDING, VK_DESCRIPTOR_TYPE_SAMPLER, samplerCapacity, VK_SHADER_STAGE_ALL_GRAPHICS, nullptr}
+    }};
+    //Slots are written while frames using other slots are in flight, and most of them are never written at all.
+    constexpr VkDescriptorBindingFlags bindingFlag = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT |
+                                                     VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+                                                     VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+    const std::array<VkDescriptorBindingFlags, 2> bindingFlags {bindingFlag, bindingFlag};
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo {};
+    bindingFlagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+    bindingFlagsInfo.bindingCount = bindingFlags.size();
+    bindingFlagsInfo.pBindingFlags = bindingFlags.data();
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo {};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.pNext = &bindingFlagsInfo;
+    layoutInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+    layoutInfo.bindingCount = bindings.size();
+    layoutInfo.pBindings = bindings.data();
+    if (vkCreateDescriptorSetLayout(XTPVulkan::device, &layoutInfo, nullptr, &layout) != VK_SUCCESS) {
+        XTPVulkan::logger->logCritical("Failed To Create Bindless Descriptor Set Layout!");
+    }
+
+    const std::array<VkDescriptorPoolSize, 2> poolSizes {{
+        {VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, textureCapacity},
+        {VK_DESCRIPTOR_TYPE_SAMPLER, samplerCapacity}
+    }};
+    VkDescriptorPoolCreateInfo poolInfo {};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+    poolInfo.maxSets = 1;
+    poolInfo.poolSizeCount = poolSizes.size();
+    poolInfo.pPoolSizes = poolSizes.data();
+    if (vkCreateDescriptorPool(XTPVulkan::device, &poolInfo, nullptr, &pool) != VK_SUCCESS) {
+        XTPVulkan::logger->logCritical("Failed To Create Bindless Descriptor Pool!");
+    }
+
+    VkDescriptorSetAllocateInfo allocateInfo {};
+    allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocateInfo.descriptorPool = pool;
+    allocateInfo.descriptorSetCount = 1;
+    allocateInfo.pSetLayouts = &layout;
+    if (vkAllocateDescriptorSets(XTPVulkan::device, &allocateInfo, &set) != VK_SUCCESS) {
+        XTPVulkan::logger->logCritical("Failed To Allocate Bindless Descriptor Set!");
+    }
+
+    materialBuffer = XTPVulkan::createSimpleBuffer(static_cast<VkDeviceSize>(materialCapacity) * sizeof(BindlessMaterialData),
+                                                   VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+                                                   VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT, VMA_MEMORY_USAGE_GPU_ONLY, false);
+
+    XTPVulkan::logger->logDebug("Created Bindless Table With {} Textures, {} Samplers And {} Materials",
+                                textureCapacity, samplerCapacity, materialCapacity);
+}
+
+void BindlessTable::cleanUp() {
+    if (!enabled) {
+        return;
+    }
+    XTPVulkan::destroyAllocatedBuffer(&materialBuffer);
+    vkDestroyDescriptorPool(XTPVulkan::device, pool, nullptr);
+    vkDestroyDescriptorSetLayout(XTPVulkan::device, layout, nullptr);
+    materialBuffer = {};
+    pool = VK_NULL_HANDLE;
+    layout = VK_NULL_HANDLE;
+    set = VK_NULL_HANDLE;
+}
+
+uint32_t BindlessTable::addImage(const AllocatedImage &image) {
+    if (!enabled) {
+        return 0;
+    }
+    if (textureCount == textureCapacity) {
+        XTPVulkan::logger->logError("Bindless Table Is Out Of Texture Slots!", false);
+        return 0;
+    }
+
+    VkDescriptorImageInfo imageInfo {};
+    imageInfo.imageView = image.imageView;
+    imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+    VkWriteDescriptorSet write {};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = set;
+    write.dstBinding = TEXTURE_BINDING;
+    write.dstArrayElement = textureCount;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+    write.pImageInfo = &imageInfo;
+    vkUpdateDescriptorSets(XTPVulkan::device, 1, &write, 0, nullptr);
+
+    return textureCount++;
+}
+
+uint32_t BindlessTable::addSampler(VkSampler sampler) {
+    if (!enabled) {
+        return 0;
+    }
+    if (samplerCount == samplerCapacity) {
+        XTPVulkan::logger->logError("Bindless Table Is Out Of Sampler Slots!", false);
+        return 0;
+    }
+
+    VkDescriptorImageInfo samplerInfo {};
+    samplerInfo.sampler = sampler;
+
+    VkWriteDescriptorSet write {};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = set;
+    write.dstBinding = SAMPLER_BINDING;
+    write.dstArrayElement = samplerCount;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
+    write.pImageInfo = &samplerInfo;
+    vkUpdateDescriptorSets(XTPVulkan::device, 1, &write, 0, nullptr);
+
+    return samplerCount++;
+}
+
+uint32_t BindlessTable::addMaterial(const BindlessMaterialData &data) {
+    if (!enabled) {
+        return Material::NO_BINDLESS_INDEX;
+    }
+    if (materialCount == materialCapacity) {
+        XTPVulkan::logger->logError("Bindless Table Is Out Of Material Slots!", false);
+        return Material::NO_BINDLESS_INDEX;
+    }
+
+    //The upload lands before the next frame is submitted, and no earlier frame can reference a slot that wasn't used yet.
+    UploadManager::uploadBuffer(&data, sizeof(BindlessMaterialData), materialBuffer,
+                                static_cast<VkDeviceSize>(materialCount) * sizeof(BindlessMaterialData));
+    return materialCount++;
+}
+
+VkDeviceAddress BindlessTable::getMaterialBufferAddress() {
+    return enabled ? materialBuffer.gpuAddress : 0;
+}
+
+VkDescriptorSetLayout BindlessTable::getLayout() {
+    return layout;
+}
+
+void BindlessTable::bind(VkCommandBuffer commandBuffer, ShaderObject *shader) {
+    if (!enabled || !shader->usesBindlessTable()) {
+        return;
+    }
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, shader->getLayout(), shader->getBindlessSet(),
+                            1, &set, 0, nullptr);
+}
+
+BindlessMaterial::BindlessMaterial(const BindlessMaterialData &data): index(BindlessTable::addMaterial(data)) {}
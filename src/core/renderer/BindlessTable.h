@@ -0,0 +1,101 @@
+#ifndef BINDLESSTABLE_H
+#define BINDLESSTABLE_H
+
+#include <cstdint>
+
+#include "Material.h"
+#include "buffer/AllocatedBuffer.h"
+#include "glm/glm.hpp"
+#include "vulkan/vulkan.h"
+
+struct AllocatedImage;
+
+//One material in the BindlessTable's material buffer, laid out like the std430 struct shaders declare for it. Texture
+//and sampler fields are indices into the table's arrays, NO_TEXTURE if the material doesn't have that texture.
+struct BindlessMaterialData {
+    static constexpr uint32_t NO_TEXTURE = UINT32_MAX;
+
+    glm::vec4 baseColorFactor {1};
+    //w is unused.
+    glm::vec4 emissiveFactor {0};
+    float metallicFactor = 1;
+    float roughnessFactor = 1;
+    uint32_t baseColorTexture = NO_TEXTURE;
+    uint32_t metallicRoughnessTexture = NO_TEXTURE;
+    uint32_t normalTexture = NO_TEXTURE;
+    uint32_t occlusionTexture = NO_TEXTURE;
+    uint32_t emissiveTexture = NO_TEXTURE;
+    uint32_t sampler = 0;
+};
+
+//One descriptor set, bound once per shader, that holds every loaded image and sampler, plus a device local buffer of
+//BindlessMaterialData reached through its device address. Images and samplers are added when they are created, and
+//their index in the table is stored in AllocatedImage. Index 0 is always the error texture and its sampler.
+//
+//Shaders that return true from ShaderObject::usesBindlessTable get the table as the set after their own ones:
+//    layout(set = N, binding = 0) uniform texture2D textures[];
+//    layout(set = N, binding = 1) uniform sampler samplers[];
+//Only available if the device supports descriptor indexing with update after bind, otherwise enabled stays false and
+//images are only used through their own descriptor sets.
+class BindlessTable {
+public:
+    static constexpr uint32_t TEXTURE_BINDING = 0;
+    static constexpr uint32_t SAMPLER_BINDING = 1;
+
+    static bool enabled;
+
+    static void init();
+
+    static void cleanUp();
+
+    //Returns the image's index in the texture array, or 0 if the table is disabled or full.
+    static uint32_t addImage(const AllocatedImage &image);
+
+    //Returns the sampler's index in the sampler array, or 0 if the table is disabled or full.
+    static uint32_t addSampler(VkSampler sampler);
+
+    //Material records can't be changed once added, since frames in flight may still read them, so changing a material
+    //means adding a new one. Returns Material::NO_BINDLESS_INDEX if the table is disabled or full.
+    static uint32_t addMaterial(const BindlessMaterialData &data);
+
+    [[nodiscard]] static VkDeviceAddress getMaterialBufferAddress();
+
+    [[nodiscard]] static VkDescriptorSetLayout getLayout();
+
+    //Binds the table to the shader's bindless set. Does nothing if the shader doesn't use the table.
+    static void bind(VkCommandBuffer commandBuffer, ShaderObject* shader);
+
+private:
+    static VkDescriptorSetLayout layout;
+    static VkDescriptorPool pool;
+    static VkDescriptorSet set;
+    static uint32_t textureCapacity;
+    static uint32_t samplerCapacity;
+    static uint32_t materialCapacity;
+    static uint32_t textureCount;
+    static uint32_t samplerCount;
+    static uint32_t materialCount;
+    static AllocatedBuffer materialBuffer;
+};
+
+//A material that is nothing but a record in the BindlessTable. It doesn't bind anything, so the IndirectBatcher draws
+//renderables using different BindlessMaterials in the same batch, passing each one's index in IndirectObjectData.
+class BindlessMaterial final : public Material {
+public:
+    explicit BindlessMaterial(const BindlessMaterialData &data);
+
+    bool initialized() override {
+        return true;
+    }
+
+    uint32_t getBindlessIndex() override {
+        return index;
+    }
+
+private:
+    uint32_t index;
+};
+
+
+
+#endif //BINDLESSTABLE_H
@@ -0,0 +1,240 @@
+#include "CompressedTexture.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+
+#include "AssetFile.h"
+#include "XTPVulkan.h"
+
+static constexpr uint8_t KTX2_IDENTIFIER[12] = {0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+//The identifier, the nine 32 bit header fields and the index of the data format, key/value and supercompression data.
+static constexpr size_t KTX2_LEVEL_INDEX_OFFSET = 12 + 9 * 4 + 4 * 4 + 2 * 8;
+
+static constexpr uint32_t DDS_MAGIC = 0x20534444; //"DDS "
+static constexpr size_t DDS_HEADER_SIZE = 4 + 124;
+static constexpr size_t DDS_DX10_HEADER_SIZE = 20;
+static constexpr uint32_t DDS_PIXEL_FORMAT_FOURCC = 0x4;
+
+static constexpr uint32_t makeFourCC(const char a, const char b, const char c, const char d) {
+    return static_cast<uint32_t>(a) | static_cast<uint32_t>(b) << 8 | static_cast<uint32_t>(c) << 16 |
+           static_cast<uint32_t>(d) << 24;
+}
+
+//The length of a full mip chain, floor(log2(max(width, height))) + 1.
+static uint32_t getMaxLevelCount(const uint32_t width, const uint32_t height) {
+    uint32_t levelCount = 1;
+    for (uint32_t size = std::max(width, height); size > 1; size >>= 1) {
+        ++levelCount;
+    }
+    return levelCount;
+}
+
+template<typename T>
+static T read(const AssetFile &file, const size_t offset) {
+    T value;
+    memcpy(&value, file.data() + offset, sizeof(T));
+    return value;
+}
+
+bool CompressedTextureLoader::isCompressedTexturePath(const std::string &path) {
+    std::string extension = std::filesystem::path(path).extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](const unsigned char c) {
+        return std::tolower(c);
+    });
+    return extension == ".ktx2" || extension == ".dds";
+}
+
+bool CompressedTextureLoader::load(const std::string &path, const bool srgb, CompressedTexture &texture) {
+    ZoneScopedN("CompressedTextureLoader::load");
+    //Mapped, so the levels are copied straight from the page cache or the archive into the texture.
+    const AssetFile file(path);
+    if (!file.isOpen()) {
+        XTPVulkan::logger->logError("Failed To Open Compressed Texture '{}'!", false, path);
+        return false;
+    }
+
+    if (file.size() >= sizeof(KTX2_IDENTIFIER) && memcmp(file.data(), KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) == 0) {
+        return loadKTX2(path, file, texture);
+    }
+    if (file.size() >= DDS_HEADER_SIZE && read<uint32_t>(file, 0) == DDS_MAGIC) {
+        return loadDDS(path, file, srgb, texture);
+    }
+
+    XTPVulkan::logger->logError("'{}' Is Neither A KTX2 Nor A DDS File!", false, path);
+    return false;
+}
+
+bool CompressedTextureLoader::loadKTX2(const std::string &path, const AssetFile &file,
+                                       CompressedTexture &texture) {
+    if (file.size() < KTX2_LEVEL_INDEX_OFFSET) {
+        XTPVulkan::logger->logError("KTX2 File '{}' Is Truncated!", false, path);
+        return false;
+    }
+
+    const auto format = static_cast<VkFormat>(read<uint32_t>(file, 12));
+    const auto width = read<uint32_t>(file, 20);
+    const auto height = read<uint32_t>(file, 24);
+    const auto depth = read<uint32_t>(file, 28);
+    const auto layerCount = read<uint32_t>(file, 32);
+    const auto faceCount = read<uint32_t>(file, 36);
+    //0 means the loader is expected to generate the mip levels, which isn't possible for compressed formats.
+    const uint32_t levelCount = std::max(read<uint32_t>(file, 40), 1u);
+    const auto supercompressionScheme = read<uint32_t>(file, 44);
+
+    if (getBlockSize(format) == 0) {
+        XTPVulkan::logger->logError("KTX2 File '{}' Isn't BC1, BC3, BC5 Or BC7 Compressed!", false, path);
+        return false;
+    }
+    if (supercompressionScheme != 0) {
+        XTPVulkan::logger->logError("KTX2 File '{}' Is Supercompressed!", false, path);
+        return false;
+    }
+    if (depth > 1 || layerCount > 1 || faceCount != 1) {
+        XTPVulkan::logger->logError("KTX2 File '{}' Isn't A Single 2D Image!", false, path);
+        return false;
+    }
+    if (width == 0 || height == 0 || levelCount > getMaxLevelCount(width, height)) {
+        XTPVulkan::logger->logError("KTX2 File '{}' Has An Invalid Size Or Mip Level Count!", false, path);
+        return false;
+    }
+    if (file.size() < KTX2_LEVEL_INDEX_OFFSET + levelCount * 3 * sizeof(uint64_t)) {
+        XTPVulkan::logger->logError("KTX2 File '{}' Is Truncated!", false, path);
+        return false;
+    }
+
+    texture.format = format;
+    texture.width = width;
+    texture.height = height;
+    texture.levelOffsets.resize(levelCount);
+
+    //Levels are stored smallest first, with padding between them, so they are packed in order here instead.
+    VkDeviceSize size = 0;
+    for (uint32_t level = 0; level < levelCount; ++level) {
+        texture.levelOffsets[level] = size;
+        size += getLevelSize(format, width, height, level);
+    }
+    texture.data.resize(size);
+
+    for (uint32_t level = 0; level < levelCount; ++level) {
+        const size_t entry = KTX2_LEVEL_INDEX_OFFSET + level * 3 * sizeof(uint64_t);
+        const auto byteOffset = read<uint64_t>(file, entry);
+        const auto byteLength = read<uint64_t>(file, entry + sizeof(uint64_t));
+
+        if (byteLength != getLevelSize(format, width, height, level) || byteOffset > file.size() ||
+            byteLength > file.size() - byteOffset) {
+            XTPVulkan::logger->logError("KTX2 File '{}' Has An Invalid Mip Level!", false, path);
+            return false;
+        }
+        memcpy(texture.data.data() + texture.levelOffsets[level], file.data() + byteOffset, byteLength);
+    }
+
+    return true;
+}
+
+bool CompressedTextureLoader::loadDDS(const std::string &path, const AssetFile &file, const bool srgb,
+                                      CompressedTexture &texture) {
+    const auto height = read<uint32_t>(file, 12);
+    const auto width = read<uint32_t>(file, 16);
+    const uint32_t levelCount = std::max(read<uint32_t>(file, 28), 1u);
+    const auto pixelFormatFlags = read<uint32_t>(file, 80);
+    const auto fourCC = read<uint32_t>(file, 84);
+
+    if ((pixelFormatFlags & DDS_PIXEL_FORMAT_FOURCC) == 0) {
+        XTPVulkan::logger->logError("DDS File '{}' Isn't Block Compressed!", false, path);
+        return false;
+    }
+
+    size_t dataOffset = DDS_HEADER_SIZE;
+    VkFormat format = VK_FORMAT_UNDEFINED;
+    if (fourCC == makeFourCC('D', 'X', '1', '0')) {
+        if (file.size() < DDS_HEADER_SIZE + DDS_DX10_HEADER_SIZE) {
+            XTPVulkan::logger->logError("DDS File '{}' Is Truncated!", false, path);
+            return false;
+        }
+        dataOffset += DDS_DX10_HEADER_SIZE;
+
+        //DXGI_FORMAT values.
+        switch (read<uint32_t>(file, DDS_HEADER_SIZE)) {
+            case 71: format = VK_FORMAT_BC1_RGBA_UNORM_BLOCK; break;
+            case 72: format = VK_FORMAT_BC1_RGBA_SRGB_BLOCK; break;
+            case 77: format = VK_FORMAT_BC3_UNORM_BLOCK; break;
+            case 78: format = VK_FORMAT_BC3_SRGB_BLOCK; break;
+            case 83: format = VK_FORMAT_BC5_UNORM_BLOCK; break;
+            case 84: format = VK_FORMAT_BC5_SNORM_BLOCK; break;
+            case 98: format = VK_FORMAT_BC7_UNORM_BLOCK; break;
+            case 99: format = VK_FORMAT_BC7_SRGB_BLOCK; break;
+            default: break;
+        }
+        if (read<uint32_t>(file, DDS_HEADER_SIZE + 12) > 1) {
+            XTPVulkan::logger->logError("DDS File '{}' Isn't A Single 2D Image!", false, path);
+            return false;
+        }
+    } else if (fourCC == makeFourCC('D', 'X', 'T', '1')) {
+        format = srgb ? VK_FORMAT_BC1_RGBA_SRGB_BLOCK : VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+    } else if (fourCC == makeFourCC('D', 'X', 'T', '5')) {
+        format = srgb ? VK_FORMAT_BC3_SRGB_BLOCK : VK_FORMAT_BC3_UNORM_BLOCK;
+    } else if (fourCC == makeFourCC('A', 'T', 'I', '2') || fourCC == makeFourCC('B', 'C', '5', 'U')) {
+        format = VK_FORMAT_BC5_UNORM_BLOCK;
+    }
+
+    if (format == VK_FORMAT_UNDEFINED) {
+        XTPVulkan::logger->logError("DDS File '{}' Isn't BC1, BC3, BC5 Or BC7 Compressed!", false, path);
+        return false;
+    }
+    if (width == 0 || height == 0 || levelCount > getMaxLevelCount(width, height)) {
+        XTPVulkan::logger->logError("DDS File '{}' Has An Invalid Size Or Mip Level Count!", false, path);
+        return false;
+    }
+
+    //DDS files store their levels largest first and without padding, which is already how they are uploaded.
+    texture.format = format;
+    texture.width = width;
+    texture.height = height;
+    texture.levelOffsets.resize(levelCount);
+    VkDeviceSize size = 0;
+    for (uint32_t level = 0; level < levelCount; ++level) {
+        texture.levelOffsets[level] = size;
+        size += getLevelSize(format, width, height, level);
+    }
+
+    if (dataOffset > file.size() || size > file.size() - dataOffset) {
+        XTPVulkan::logger->logError("DDS File '{}' Is Truncated!", false, path);
+        return false;
+    }
+    texture.data.assign(file.data() + dataOffset, file.data() + dataOffset + size);
+
+    return true;
+}
+
+VkDeviceSize CompressedTextureLoader::getBlockSize(const VkFormat format) {
+    switch (format) {
+        case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+        case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+            return 8;
+        case VK_FORMAT_BC3_UNORM_BLOCK:
+        case VK_FORMAT_BC3_SRGB_BLOCK:
+        case VK_FORMAT_BC5_UNORM_BLOCK:
+        case VK_FORMAT_BC5_SNORM_BLOCK:
+        case VK_FORMAT_BC7_UNORM_BLOCK:
+        case VK_FORMAT_BC7_SRGB_BLOCK:
+            return 16;
+        default:
+            return 0;
+    }
+}
+
+bool CompressedTextureLoader::isSrgbFormat(const VkFormat format) {
+    return format == VK_FORMAT_R8G8B8A8_SRGB || format == VK_FORMAT_B8G8R8A8_SRGB;
+}
+
+VkDeviceSize CompressedTextureLoader::getLevelSize(const VkFormat format, const uint32_t width, const uint32_t height,
+                                                   const uint32_t level) {
+    //Every format here uses 4x4 blocks.
+    const VkDeviceSize blocksWide = (std::max(width >> level, 1u) + 3) / 4;
+    const VkDeviceSize blocksHigh = (std::max(height >> level, 1u) + 3) / 4;
+    return blocksWide * blocksHigh * getBlockSize(format);
+}
@@ -0,0 +1,46 @@
+#ifndef COMPRESSEDTEXTURE_H
+#define COMPRESSEDTEXTURE_H
+
+#include <string>
+#include <vector>
+
+#include "vulkan/vulkan.h"
+
+class AssetFile;
+
+//A block compressed texture with every mip level already in it, ready to be copied into an image as is.
+struct CompressedTexture {
+    VkFormat format;
+    uint32_t width;
+    uint32_t height;
+    //Where each mip level starts in data, the first one being the full size image.
+    std::vector<VkDeviceSize> levelOffsets;
+    std::vector<char> data;
+};
+
+//Loads BC1, BC3, BC5 and BC7 textures from KTX2 and DDS files. KTX2 files have to be stored without supercompression.
+class CompressedTextureLoader {
+public:
+    //True if the path has a file extension this loader handles, which is all that is used to pick a loader.
+    [[nodiscard]] static bool isCompressedTexturePath(const std::string &path);
+
+    //srgb picks the format of DDS files that don't store whether they are sRGB themselves. Returns false and logs why if
+    //the file can't be loaded.
+    static bool load(const std::string &path, bool srgb, CompressedTexture &texture);
+
+    [[nodiscard]] static VkDeviceSize getBlockSize(VkFormat format);
+
+    //Whether a texture requested in this uncompressed format should be loaded as sRGB.
+    [[nodiscard]] static bool isSrgbFormat(VkFormat format);
+
+private:
+    static bool loadKTX2(const std::string &path, const AssetFile &file, CompressedTexture &texture);
+
+    static bool loadDDS(const std::string &path, const AssetFile &file, bool srgb, CompressedTexture &texture);
+
+    [[nodiscard]] static VkDeviceSize getLevelSize(VkFormat format, uint32_t width, uint32_t height, uint32_t level);
+};
+
+
+
+#endif //COMPRESSEDTEXTURE_H
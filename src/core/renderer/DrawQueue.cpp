@@ -0,0 +1,61 @@
+#include "DrawQueue.h"
+
+#include <algorithm>
+
+std::vector<DrawItem> DrawQueue::scratch;
+std::vector<uint32_t> DrawQueue::histogram;
+
+uint64_t DrawQueue::makeSortKey(const uint32_t shaderId, const uint32_t materialId, const uint32_t meshId,
+                                const float normalizedDepth) {
+    constexpr uint64_t depthMax = (1ull << DEPTH_BITS) - 1;
+    const auto depth = static_cast<uint64_t>(std::clamp(normalizedDepth, 0.0f, 1.0f) * depthMax);
+
+    return (static_cast<uint64_t>(shaderId) & ((1ull << SHADER_BITS) - 1)) << (MATERIAL_BITS + MESH_BITS + DEPTH_BITS) |
+           (static_cast<uint64_t>(materialId) & ((1ull << MATERIAL_BITS) - 1)) << (MESH_BITS + DEPTH_BITS) |
+           (static_cast<uint64_t>(meshId) & ((1ull << MESH_BITS) - 1)) << DEPTH_BITS |
+           depth;
+}
+
+void DrawQueue::sort(std::vector<DrawItem> &items) {
+    ZoneScopedN("DrawQueue::sort");
+    if (items.size() < 2) {
+        return;
+    }
+
+    constexpr uint32_t bucketCount = 1u << DIGIT_BITS;
+    constexpr uint64_t digitMask = bucketCount - 1;
+
+    //Only digits that differ between items change the order, and in most scenes the shader and material digits are
+    //the same for almost everything.
+    uint64_t differingBits = 0;
+    for (const DrawItem &item: items) {
+        differingBits |= item.sortKey ^ items[0].sortKey;
+    }
+
+    scratch.resize(items.size());
+    histogram.resize(bucketCount);
+
+    for (uint32_t digit = 0; digit < DIGIT_COUNT; ++digit) {
+        const uint32_t shift = digit * DIGIT_BITS;
+        if (((differingBits >> shift) & digitMask) == 0) {
+            continue;
+        }
+
+        std::fill(histogram.begin(), histogram.end(), 0);
+        for (const DrawItem &item: items) {
+            histogram[(item.sortKey >> shift) & digitMask]++;
+        }
+
+        uint32_t offset = 0;
+        for (uint32_t &count: histogram) {
+            const uint32_t bucketSize = count;
+            count = offset;
+            offset += bucketSize;
+        }
+
+        for (const DrawItem &item: items) {
+            scratch[histogram[(item.sortKey >> shift) & digitMask]++] = item;
+        }
+        items.swap(scratch);
+    }
+}
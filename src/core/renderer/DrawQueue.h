@@ -0,0 +1,33 @@
+#ifndef DRAWQUEUE_H
+#define DRAWQUEUE_H
+
+#include <vector>
+
+#include "XTPVulkan.h"
+
+//Orders draw items so that items sharing a shader, then a material, then a mesh end up next to each other, and items
+//with the same state are drawn front to back. The order is given by DrawItem::sortKey, which is built by makeSortKey.
+class DrawQueue {
+public:
+    static constexpr uint32_t SHADER_BITS = 12;
+    static constexpr uint32_t MATERIAL_BITS = 20;
+    static constexpr uint32_t MESH_BITS = 16;
+    static constexpr uint32_t DEPTH_BITS = 16;
+
+    //Ids that don't fit into their bits wrap around, which only makes the order less efficient, never wrong.
+    static uint64_t makeSortKey(uint32_t shaderId, uint32_t materialId, uint32_t meshId, float normalizedDepth);
+
+    //A stable least significant digit radix sort. Digits that are the same for every item are skipped.
+    static void sort(std::vector<DrawItem> &items);
+
+private:
+    static constexpr uint32_t DIGIT_BITS = 16;
+    static constexpr uint32_t DIGIT_COUNT = 64 / DIGIT_BITS;
+
+    static std::vector<DrawItem> scratch;
+    static std::vector<uint32_t> histogram;
+};
+
+
+
+#endif //DRAWQUEUE_H
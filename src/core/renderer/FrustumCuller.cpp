@@ -0,0 +1,153 @@
+#include "FrustumCuller.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define XTP_CULL_SSE
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define XTP_CULL_NEON
+#endif
+
+#include "renderable/Renderable.h"
+
+uint32_t FrustumCuller::lastCulledCount;
+std::vector<float> FrustumCuller::centerX;
+std::vector<float> FrustumCuller::centerY;
+std::vector<float> FrustumCuller::centerZ;
+std::vector<float> FrustumCuller::radii;
+std::vector<size_t> FrustumCuller::candidates;
+std::vector<uint32_t> FrustumCuller::visible;
+
+FrustumPlanes FrustumCuller::extractPlanes(const glm::mat4 &viewProjection) {
+    //glm matrices are column major, so the rows have to be gathered first.
+    glm::vec4 rows[4];
+    for (int row = 0; row < 4; ++row) {
+        rows[row] = glm::vec4(viewProjection[0][row], viewProjection[1][row], viewProjection[2][row],
+                              viewProjection[3][row]);
+    }
+
+    FrustumPlanes frustum {};
+    frustum.planes[0] = rows[3] + rows[0]; //Left
+    frustum.planes[1] = rows[3] - rows[0]; //Right
+    frustum.planes[2] = rows[3] + rows[1]; //Bottom
+    frustum.planes[3] = rows[3] - rows[1]; //Top
+    frustum.planes[4] = rows[3] + rows[2]; //Near
+    frustum.planes[5] = rows[3] - rows[2]; //Far
+
+    //Normalized, so the distance of a point to a plane can be compared to a radius.
+    for (glm::vec4 &plane: frustum.planes) {
+        plane /= glm::length(glm::vec3(plane));
+    }
+    return frustum;
+}
+
+void FrustumCuller::cull(std::vector<DrawItem> &items, const glm::mat4 &viewProjection) {
+    ZoneScopedN("FrustumCuller::cull");
+    centerX.clear();
+    centerY.clear();
+    centerZ.clear();
+    radii.clear();
+    candidates.clear();
+
+    for (size_t i = 0; i < items.size(); ++i) {
+        Renderable* renderable = items[i].renderable;
+        if (!renderable->frustumCullable()) {
+            continue;
+        }
+        const MeshBounds bounds = renderable->getMesh()->getBounds();
+        if (!bounds.valid) {
+            continue;
+        }
+
+        const glm::mat4 transform = renderable->getTransform();
+        const glm::vec3 center = transform * glm::vec4(bounds.center, 1);
+        //Non-uniform scales stretch the sphere by at most the largest scale of the three axes.
+        const float scale = std::sqrt(std::max({
+            glm::dot(glm::vec3(transform[0]), glm::vec3(transform[0])),
+            glm::dot(glm::vec3(transform[1]), glm::vec3(transform[1])),
+            glm::dot(glm::vec3(transform[2]), glm::vec3(transform[2]))
+        }));
+
+        centerX.emplace_back(center.x);
+        centerY.emplace_back(center.y);
+        centerZ.emplace_back(center.z);
+        radii.emplace_back(bounds.radius * scale);
+        candidates.emplace_back(i);
+    }
+
+    lastCulledCount = 0;
+    if (candidates.empty()) {
+        return;
+    }
+
+    //Padded with spheres that are always visible, so the last group of four doesn't need a special case.
+    const size_t count = (candidates.size() + 3) & ~static_cast<size_t>(3);
+    centerX.resize(count, 0);
+    centerY.resize(count, 0);
+    centerZ.resize(count, 0);
+    radii.resize(count, INFINITY);
+    visible.resize(count);
+
+    testSpheres(extractPlanes(viewProjection), count);
+
+    size_t write = 0;
+    size_t candidate = 0;
+    for (size_t read = 0; read < items.size(); ++read) {
+        if (candidate < candidates.size() && candidates[candidate] == read) {
+            if (!visible[candidate++]) {
+                continue;
+            }
+        }
+        items[write++] = items[read];
+    }
+    lastCulledCount = static_cast<uint32_t>(items.size() - write);
+    items.resize(write);
+}
+
+void FrustumCuller::testSpheres(const FrustumPlanes &frustum, const size_t count) {
+    ZoneScopedN("FrustumCuller::testSpheres");
+#if defined(XTP_CULL_SSE)
+    for (size_t i = 0; i < count; i += 4) {
+        const __m128 x = _mm_loadu_ps(&centerX[i]);
+        const __m128 y = _mm_loadu_ps(&centerY[i]);
+        const __m128 z = _mm_loadu_ps(&centerZ[i]);
+        const __m128 negativeRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(&radii[i]));
+
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (const glm::vec4 &plane: frustum.planes) {
+            __m128 distance = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(plane.x)), _mm_set1_ps(plane.w));
+            distance = _mm_add_ps(distance, _mm_mul_ps(y, _mm_set1_ps(plane.y)));
+            distance = _mm_add_ps(distance, _mm_mul_ps(z, _mm_set1_ps(plane.z)));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, negativeRadius));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&visible[i]), _mm_castps_si128(inside));
+    }
+#elif defined(XTP_CULL_NEON)
+    for (size_t i = 0; i < count; i += 4) {
+        const float32x4_t x = vld1q_f32(&centerX[i]);
+        const float32x4_t y = vld1q_f32(&centerY[i]);
+        const float32x4_t z = vld1q_f32(&centerZ[i]);
+        const float32x4_t negativeRadius = vnegq_f32(vld1q_f32(&radii[i]));
+
+        uint32x4_t inside = vdupq_n_u32(UINT32_MAX);
+        for (const glm::vec4 &plane: frustum.planes) {
+            float32x4_t distance = vmlaq_n_f32(vdupq_n_f32(plane.w), x, plane.x);
+            distance = vmlaq_n_f32(distance, y, plane.y);
+            distance = vmlaq_n_f32(distance, z, plane.z);
+            inside = vandq_u32(inside, vcgeq_f32(distance, negativeRadius));
+        }
+        vst1q_u32(&visible[i], inside);
+    }
+#else
+    for (size_t i = 0; i < count; ++i) {
+        bool inside = true;
+        for (const glm::vec4 &plane: frustum.planes) {
+            inside &= plane.x * centerX[i] + plane.y * centerY[i] + plane.z * centerZ[i] + plane.w >= -radii[i];
+        }
+        visible[i] = inside;
+    }
+#endif
+}
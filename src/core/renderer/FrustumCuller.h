@@ -0,0 +1,42 @@
+#ifndef FRUSTUMCULLER_H
+#define FRUSTUMCULLER_H
+
+#include <vector>
+
+#include "XTPVulkan.h"
+#include "glm/glm.hpp"
+
+//The six planes of a view frustum, as (normal, distance) with the normals pointing inwards.
+struct FrustumPlanes {
+    glm::vec4 planes[6];
+};
+
+//Removes renderables whose bounding spheres are entirely outside the view frustum from a draw list. The spheres are
+//transformed into world space and stored as a structure of arrays, so four of them are tested against a plane at once.
+class FrustumCuller {
+public:
+    //How many renderables the most recent call to cull removed.
+    static uint32_t lastCulledCount;
+
+    //viewProjection must map to OpenGL style clip space, like XTPVulkan::projectionMatrix does.
+    static FrustumPlanes extractPlanes(const glm::mat4 &viewProjection);
+
+    //Renderables that aren't frustumCullable or whose mesh has no bounds are always kept. The order of items is kept.
+    static void cull(std::vector<DrawItem> &items, const glm::mat4 &viewProjection);
+
+private:
+    static std::vector<float> centerX;
+    static std::vector<float> centerY;
+    static std::vector<float> centerZ;
+    static std::vector<float> radii;
+    static std::vector<size_t> candidates;
+    static std::vector<uint32_t> visible;
+
+    //Writes a non-zero value to visible for every sphere at least partially inside the frustum. count must be a
+    //multiple of 4.
+    static void testSpheres(const FrustumPlanes &frustum, size_t count);
+};
+
+
+
+#endif //FRUSTUMCULLER_H
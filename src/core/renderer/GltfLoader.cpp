@@ -0,0 +1,489 @@
+#ifdef XTP_USE_GLTF_LOADING
+#include "GltfLoader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+
+#include "AssetFile.h"
+#include "BindlessTable.h"
+#include "JobSystem.h"
+#include "stb_image.h"
+#include "tiny_gltf.h"
+#include "XTPVulkan.h"
+#include "glm/gtc/matrix_transform.hpp"
+#include "glm/gtc/quaternion.hpp"
+#include "glm/gtc/type_ptr.hpp"
+#include "renderable/SimpleMesh.h"
+
+struct DecodedImage {
+    stbi_uc* pixels = nullptr;
+    int width = 0;
+    int height = 0;
+};
+
+//Images are decoded later together with the primitives, so loading them only keeps the encoded bytes. Images stored in
+//a buffer view are read straight from the buffer instead of being copied.
+static bool keepEncodedImage(tinygltf::Image *image, const int, std::string *, std::string *, int, int,
+                             const unsigned char *bytes, const int size, void *) {
+    if (image->bufferView < 0) {
+        image->image.assign(bytes, bytes + size);
+    }
+    return true;
+}
+
+static float readComponent(const unsigned char *data, const int componentType, const bool normalized) {
+    switch (componentType) {
+        case TINYGLTF_COMPONENT_TYPE_FLOAT: {
+            float value;
+            memcpy(&value, data, sizeof(float));
+            return value;
+        }
+        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+            return normalized ? *data / 255.0f : *data;
+        case TINYGLTF_COMPONENT_TYPE_BYTE: {
+            const auto value = static_cast<int8_t>(*data);
+            return normalized ? std::max(value / 127.0f, -1.0f) : value;
+        }
+        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT: {
+            uint16_t value;
+            memcpy(&value, data, sizeof(uint16_t));
+            return normalized ? value / 65535.0f : value;
+        }
+        case TINYGLTF_COMPONENT_TYPE_SHORT: {
+            int16_t value;
+            memcpy(&value, data, sizeof(int16_t));
+            return normalized ? std::max(value / 32767.0f, -1.0f) : value;
+        }
+        default:
+            return 0;
+    }
+}
+
+//Returns where the accessor's first element starts and sets stride to the distance between elements, or returns nullptr
+//if the accessor reaches outside of its buffer. Accessors without a buffer view are all zeros, which is left to the
+//caller.
+static const unsigned char *getAccessorData(const tinygltf::Model &model, const tinygltf::Accessor &accessor,
+                                            size_t &stride) {
+    if (accessor.sparse.isSparse || accessor.bufferView < 0 ||
+        accessor.bufferView >= static_cast<int>(model.bufferViews.size())) {
+        return nullptr;
+    }
+    const tinygltf::BufferView &bufferView = model.bufferViews[accessor.bufferView];
+    if (bufferView.buffer < 0 || bufferView.buffer >= static_cast<int>(model.buffers.size())) {
+        return nullptr;
+    }
+    const int byteStride = accessor.ByteStride(bufferView);
+    if (byteStride <= 0) {
+        return nullptr;
+    }
+    stride = byteStride;
+
+    const std::vector<unsigned char> &buffer = model.buffers[bufferView.buffer].data;
+    const size_t elementSize = tinygltf::GetComponentSizeInBytes(accessor.componentType) *
+                               tinygltf::GetNumComponentsInType(accessor.type);
+    const size_t start = bufferView.byteOffset + accessor.byteOffset;
+    if (accessor.count > 0 && start + stride * (accessor.count - 1) + elementSize > buffer.size()) {
+        return nullptr;
+    }
+    return buffer.data() + start;
+}
+
+template<glm::length_t N>
+static bool readAttribute(const tinygltf::Model &model, const tinygltf::Primitive &primitive, const char *name,
+                          std::vector<GltfVertex> &vertices, glm::vec<N, float> GltfVertex::*member) {
+    const auto attribute = primitive.attributes.find(name);
+    if (attribute == primitive.attributes.end()) {
+        return true;
+    }
+    if (attribute->second < 0 || attribute->second >= static_cast<int>(model.accessors.size())) {
+        return false;
+    }
+
+    const tinygltf::Accessor &accessor = model.accessors[attribute->second];
+    if (accessor.count != vertices.size()) {
+        return false;
+    }
+    if (accessor.bufferView < 0 && !accessor.sparse.isSparse) {
+        for (GltfVertex &vertex: vertices) {
+            vertex.*member = glm::vec<N, float>(0);
+        }
+        return true;
+    }
+
+    size_t stride;
+    const unsigned char *data = getAccessorData(model, accessor, stride);
+    if (data == nullptr) {
+        return false;
+    }
+    const int componentSize = tinygltf::GetComponentSizeInBytes(accessor.componentType);
+    const int componentCount = std::min(static_cast<int>(N), tinygltf::GetNumComponentsInType(accessor.type));
+
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        const unsigned char *element = data + i * stride;
+        glm::vec<N, float> &value = vertices[i].*member;
+        for (int component = 0; component < componentCount; ++component) {
+            value[component] = readComponent(element + component * componentSize, accessor.componentType,
+                                             accessor.normalized);
+        }
+    }
+    return true;
+}
+
+static bool readIndices(const tinygltf::Model &model, const tinygltf::Primitive &primitive, const size_t vertexCount,
+                        std::vector<uint32_t> &indices) {
+    //Primitives without indices draw their vertices in order.
+    if (primitive.indices < 0) {
+        indices.resize(vertexCount);
+        for (size_t i = 0; i < vertexCount; ++i) {
+            indices[i] = static_cast<uint32_t>(i);
+        }
+        return true;
+    }
+    if (primitive.indices >= static_cast<int>(model.accessors.size())) {
+        return false;
+    }
+
+    const tinygltf::Accessor &accessor = model.accessors[primitive.indices];
+    size_t stride;
+    const unsigned char *data = getAccessorData(model, accessor, stride);
+    if (data == nullptr) {
+        return false;
+    }
+
+    indices.resize(accessor.count);
+    for (size_t i = 0; i < accessor.count; ++i) {
+        const unsigned char *element = data + i * stride;
+        switch (accessor.componentType) {
+            case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+                indices[i] = *element;
+                break;
+            case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT: {
+                uint16_t index;
+                memcpy(&index, element, sizeof(uint16_t));
+                indices[i] = index;
+                break;
+            }
+            case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
+                memcpy(&indices[i], element, sizeof(uint32_t));
+                break;
+            default:
+                return false;
+        }
+        if (indices[i] >= vertexCount) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//Called on the pool's threads, so errors are only logged.
+static std::shared_ptr<Mesh> decodePrimitive(const tinygltf::Model &model, const tinygltf::Primitive &primitive,
+                                             const std::string &path) {
+    if (primitive.mode != -1 && primitive.mode != TINYGLTF_MODE_TRIANGLES) {
+        XTPVulkan::logger->logError("Skipping Primitive In '{}' That Isn't A Triangle List!", false, path);
+        return nullptr;
+    }
+    const auto position = primitive.attributes.find("POSITION");
+    if (position == primitive.attributes.end() || position->second < 0 ||
+        position->second >= static_cast<int>(model.accessors.size())) {
+        XTPVulkan::logger->logError("Skipping Primitive In '{}' Without Positions!", false, path);
+        return nullptr;
+    }
+
+    std::vector<GltfVertex> vertices(model.accessors[position->second].count);
+    std::vector<uint32_t> indices;
+    if (vertices.empty() ||
+        !readAttribute(model, primitive, "POSITION", vertices, &GltfVertex::pos) ||
+        !readAttribute(model, primitive, "NORMAL", vertices, &GltfVertex::normal) ||
+        !readAttribute(model, primitive, "TEXCOORD_0", vertices, &GltfVertex::uv) ||
+        !readAttribute(model, primitive, "TANGENT", vertices, &GltfVertex::tangent) ||
+        !readIndices(model, primitive, vertices.size(), indices)) {
+        XTPVulkan::logger->logError("Skipping Primitive In '{}' With Invalid Or Sparse Accessors!", false, path);
+        return nullptr;
+    }
+
+    return std::make_shared<SimpleMesh<GltfVertex>>(std::move(vertices), std::move(indices));
+}
+
+static DecodedImage decodeImage(const tinygltf::Model &model, const tinygltf::Image &image, const std::string &path) {
+    const unsigned char *bytes = image.image.data();
+    size_t size = image.image.size();
+    if (image.bufferView >= 0) {
+        //Checked like the accessors' buffer views, since the file can point them anywhere.
+        if (image.bufferView >= static_cast<int>(model.bufferViews.size()) ||
+            model.bufferViews[image.bufferView].buffer < 0 ||
+            model.bufferViews[image.bufferView].buffer >= static_cast<int>(model.buffers.size())) {
+            XTPVulkan::logger->logError("Image '{}' In '{}' Has An Invalid Buffer View!", false, image.name, path);
+            return {};
+        }
+        const tinygltf::BufferView &bufferView = model.bufferViews[image.bufferView];
+        const std::vector<unsigned char> &buffer = model.buffers[bufferView.buffer].data;
+        if (bufferView.byteOffset > buffer.size() || bufferView.byteLength > buffer.size() - bufferView.byteOffset) {
+            XTPVulkan::logger->logError("Image '{}' In '{}' Is Truncated!", false, image.name, path);
+            return {};
+        }
+        bytes = buffer.data() + bufferView.byteOffset;
+        size = bufferView.byteLength;
+    }
+
+    DecodedImage decoded;
+    int channels;
+    decoded.pixels = stbi_load_from_memory(bytes, static_cast<int>(size), &decoded.width, &decoded.height, &channels,
+                                           STBI_rgb_alpha);
+    if (decoded.pixels == nullptr) {
+        XTPVulkan::logger->logError("Failed To Decode Image '{}' In '{}'!", false, image.name, path);
+    }
+    return decoded;
+}
+
+static glm::mat4 getLocalTransform(const tinygltf::Node &node) {
+    if (node.matrix.size() == 16) {
+        glm::mat4 matrix;
+        for (int i = 0; i < 16; ++i) {
+            glm::value_ptr(matrix)[i] = static_cast<float>(node.matrix[i]);
+        }
+        return matrix;
+    }
+
+    glm::mat4 transform(1);
+    if (node.translation.size() == 3) {
+        transform = glm::translate(transform, glm::vec3(node.translation[0], node.translation[1], node.translation[2]));
+    }
+    if (node.rotation.size() == 4) {
+        //glTF stores quaternions as x, y, z, w.
+        transform *= glm::mat4_cast(glm::quat(static_cast<float>(node.rotation[3]), static_cast<float>(node.rotation[0]),
+                                              static_cast<float>(node.rotation[1]), static_cast<float>(node.rotation[2])));
+    }
+    if (node.scale.size() == 3) {
+        transform = glm::scale(transform, glm::vec3(node.scale[0], node.scale[1], node.scale[2]));
+    }
+    return transform;
+}
+
+static void addNode(const tinygltf::Model &model, const int nodeIndex, const glm::mat4 &parentTransform,
+                    std::vector<bool> &visited, GltfModel &result) {
+    if (nodeIndex < 0 || nodeIndex >= static_cast<int>(model.nodes.size()) || visited[nodeIndex]) {
+        return;
+    }
+    visited[nodeIndex] = true;
+
+    const tinygltf::Node &node = model.nodes[nodeIndex];
+    const glm::mat4 transform = parentTransform * getLocalTransform(node);
+    if (node.mesh >= 0 && node.mesh < static_cast<int>(result.meshes.size())) {
+        result.nodes.push_back({node.name, transform, node.mesh});
+    }
+    for (const int child: node.children) {
+        addNode(model, child, transform, visited, result);
+    }
+}
+
+static int32_t getTextureImage(const tinygltf::Model &model, const int textureIndex) {
+    if (textureIndex < 0 || textureIndex >= static_cast<int>(model.textures.size())) {
+        return -1;
+    }
+    const int source = model.textures[textureIndex].source;
+    return source >= 0 && source < static_cast<int>(model.images.size()) ? source : -1;
+}
+
+bool GltfLoader::load(const std::string &path, const bool isBinary, GltfModel &model, const char *sceneToLoad) {
+    ZoneScopedN("GltfLoader::load");
+    const AssetFile file(path);
+    if (!file.isOpen()) {
+        XTPVulkan::logger->logError("Failed To Open glTF File '{}'!", false, path);
+        return false;
+    }
+    if (file.size() > std::numeric_limits<unsigned int>::max()) {
+        XTPVulkan::logger->logError("glTF File '{}' Is Larger Than 4 GiB!", false, path);
+        return false;
+    }
+
+    tinygltf::Model gltf;
+    {
+        ZoneScopedN("GltfLoader::load#parse");
+        tinygltf::TinyGLTF parser;
+        parser.SetImageLoader(keepEncodedImage, nullptr);
+        std::string error, warning;
+        const std::string baseDirectory = std::filesystem::path(path).parent_path().string();
+        const bool parsed = isBinary
+                                ? parser.LoadBinaryFromMemory(&gltf, &error, &warning, file.data(),
+                                                              static_cast<unsigned int>(file.size()), baseDirectory)
+                                : parser.LoadASCIIFromString(&gltf, &error, &warning,
+                                                             reinterpret_cast<const char*>(file.data()),
+                                                             static_cast<unsigned int>(file.size()), baseDirectory);
+        if (!warning.empty()) {
+            XTPVulkan::logger->logWarning("glTF File '{}': {}", path, warning);
+        }
+        if (!parsed) {
+            XTPVulkan::logger->logError("Failed To Parse glTF File '{}': {}", false, path, error);
+            return false;
+        }
+    }
+
+    std::vector<int> rootNodes;
+    if (sceneToLoad != nullptr) {
+        const auto scene = std::find_if(gltf.scenes.begin(), gltf.scenes.end(), [sceneToLoad](const tinygltf::Scene &scene) {
+            return scene.name == sceneToLoad;
+        });
+        if (scene == gltf.scenes.end()) {
+            XTPVulkan::logger->logError("glTF File '{}' Has No Scene Named '{}'!", false, path, sceneToLoad);
+            return false;
+        }
+        rootNodes = scene->nodes;
+    } else if (!gltf.scenes.empty()) {
+        rootNodes = gltf.scenes[std::clamp(gltf.defaultScene, 0, static_cast<int>(gltf.scenes.size()) - 1)].nodes;
+    } else {
+        //Files without scenes are only meant to be used as libraries of meshes, but every node that isn't a child of
+        //another one is still treated as a root.
+        std::vector<bool> isChild(gltf.nodes.size(), false);
+        for (const tinygltf::Node &node: gltf.nodes) {
+            for (const int child: node.children) {
+                if (child >= 0 && child < static_cast<int>(isChild.size())) {
+                    isChild[child] = true;
+                }
+            }
+        }
+        for (size_t node = 0; node < gltf.nodes.size(); ++node) {
+            if (!isChild[node]) {
+                rootNodes.push_back(static_cast<int>(node));
+            }
+        }
+    }
+
+    //Base color and emissive textures hold colors, everything else holds data that mustn't be converted from sRGB.
+    std::vector<bool> srgbImages(gltf.images.size(), false);
+    model.materials.reserve(gltf.materials.size());
+    for (const tinygltf::Material &material: gltf.materials) {
+        const tinygltf::PbrMetallicRoughness &pbr = material.pbrMetallicRoughness;
+        GltfMaterial &result = model.materials.emplace_back();
+        if (pbr.baseColorFactor.size() == 4) {
+            result.baseColorFactor = glm::vec4(pbr.baseColorFactor[0], pbr.baseColorFactor[1], pbr.baseColorFactor[2],
+                                               pbr.baseColorFactor[3]);
+        }
+        result.metallicFactor = static_cast<float>(pbr.metallicFactor);
+        result.roughnessFactor = static_cast<float>(pbr.roughnessFactor);
+        if (material.emissiveFactor.size() == 3) {
+            result.emissiveFactor = glm::vec3(material.emissiveFactor[0], material.emissiveFactor[1],
+                                              material.emissiveFactor[2]);
+        }
+        result.baseColorImage = getTextureImage(gltf, pbr.baseColorTexture.index);
+        result.metallicRoughnessImage = getTextureImage(gltf, pbr.metallicRoughnessTexture.index);
+        result.normalImage = getTextureImage(gltf, material.normalTexture.index);
+        result.occlusionImage = getTextureImage(gltf, material.occlusionTexture.index);
+        result.emissiveImage = getTextureImage(gltf, material.emissiveTexture.index);
+        result.doubleSided = material.doubleSided;
+
+        if (result.baseColorImage >= 0) {
+            srgbImages[result.baseColorImage] = true;
+        }
+        if (result.emissiveImage >= 0) {
+            srgbImages[result.emissiveImage] = true;
+        }
+    }
+
+    //Every primitive and every image is one task, so a file with few large meshes still decodes its images alongside.
+    std::vector<std::pair<int, int>> primitives;
+    model.meshes.resize(gltf.meshes.size());
+    for (size_t mesh = 0; mesh < gltf.meshes.size(); ++mesh) {
+        model.meshes[mesh].resize(gltf.meshes[mesh].primitives.size());
+        for (size_t primitive = 0; primitive < gltf.meshes[mesh].primitives.size(); ++primitive) {
+            primitives.emplace_back(static_cast<int>(mesh), static_cast<int>(primitive));
+        }
+    }
+    std::vector<DecodedImage> decodedImages(gltf.images.size());
+
+    {
+        ZoneScopedN("GltfLoader::load#decode");
+        JobSystem::parallelFor(primitives.size() + decodedImages.size(), 1, [&](const size_t first, const size_t last) {
+            for (size_t index = first; index < last; ++index) {
+                if (index < primitives.size()) {
+                    const auto [mesh, primitive] = primitives[index];
+                    const tinygltf::Primitive &source = gltf.meshes[mesh].primitives[primitive];
+                    model.meshes[mesh][primitive] = {decodePrimitive(gltf, source, path), source.material};
+                } else {
+                    const size_t image = index - primitives.size();
+                    decodedImages[image] = decodeImage(gltf, gltf.images[image], path);
+                }
+            }
+        });
+    }
+
+    //Primitives that failed to decode are left out.
+    VkDeviceSize vertexBytes = 0;
+    VkDeviceSize indexBytes = 0;
+    for (std::vector<GltfPrimitive> &mesh: model.meshes) {
+        mesh.erase(std::remove_if(mesh.begin(), mesh.end(), [](const GltfPrimitive &primitive) {
+            return primitive.mesh == nullptr;
+        }), mesh.end());
+        for (const GltfPrimitive &primitive: mesh) {
+            //Every mesh is aligned to the vertex size inside the pool, which can cost up to one vertex of padding.
+            vertexBytes += (primitive.mesh->getVertexCount() + 1) * sizeof(GltfVertex);
+            indexBytes += primitive.mesh->getIndexCount() * sizeof(uint32_t);
+        }
+    }
+
+    {
+        ZoneScopedN("GltfLoader::load#upload");
+        MeshPool::reserve(vertexBytes, indexBytes);
+        for (const std::vector<GltfPrimitive> &mesh: model.meshes) {
+            for (const GltfPrimitive &primitive: mesh) {
+                primitive.mesh->init();
+            }
+        }
+
+        model.images.reserve(decodedImages.size());
+        for (size_t i = 0; i < decodedImages.size(); ++i) {
+            const DecodedImage &image = decodedImages[i];
+            if (image.pixels == nullptr) {
+                model.images.push_back(XTPVulkan::errorTexure);
+                continue;
+            }
+            model.images.push_back(XTPVulkan::createImage(image.pixels, static_cast<VkDeviceSize>(image.width) * image.height * 4,
+                                                          srgbImages[i] ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM,
+                                                          image.width, image.height));
+            stbi_image_free(image.pixels);
+        }
+
+        if (BindlessTable::enabled) {
+            //One sampler is shared by every texture of the model. Its maxLod comes from the image it is created for, so
+            //that is the one with the most mip levels.
+            uint32_t sampler = 0;
+            const auto largest = std::max_element(model.images.begin(), model.images.end(),
+                [](const AllocatedImage &a, const AllocatedImage &b) {
+                    return a.mipLevels < b.mipLevels;
+                });
+            if (largest != model.images.end() && largest->image != XTPVulkan::errorTexure.image) {
+                XTPVulkan::createSampler(*largest);
+                sampler = largest->bindlessSamplerIndex;
+            }
+
+            const auto getTexture = [&model](const int32_t image) {
+                return image >= 0 ? model.images[image].bindlessIndex : BindlessMaterialData::NO_TEXTURE;
+            };
+            for (GltfMaterial &material: model.materials) {
+                BindlessMaterialData data;
+                data.baseColorFactor = material.baseColorFactor;
+                data.emissiveFactor = glm::vec4(material.emissiveFactor, 0);
+                data.metallicFactor = material.metallicFactor;
+                data.roughnessFactor = material.roughnessFactor;
+                data.baseColorTexture = getTexture(material.baseColorImage);
+                data.metallicRoughnessTexture = getTexture(material.metallicRoughnessImage);
+                data.normalTexture = getTexture(material.normalImage);
+                data.occlusionTexture = getTexture(material.occlusionImage);
+                data.emissiveTexture = getTexture(material.emissiveImage);
+                data.sampler = sampler;
+                material.bindlessIndex = BindlessTable::addMaterial(data);
+            }
+        }
+    }
+
+    std::vector<bool> visited(gltf.nodes.size(), false);
+    for (const int node: rootNodes) {
+        addNode(gltf, node, glm::mat4(1), visited, model);
+    }
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef GLTFLOADER_H
+#define GLTFLOADER_H
+
+#ifdef XTP_USE_GLTF_LOADING
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "AllocatedImage.h"
+#include "Material.h"
+#include "glm/glm.hpp"
+
+class Mesh;
+
+//The vertex every glTF primitive is converted to. Attributes a primitive doesn't have are left at these values.
+struct GltfVertex {
+    glm::vec3 pos {0};
+    glm::vec3 normal {0};
+    glm::vec2 uv {0};
+    glm::vec4 tangent {0, 0, 0, 1};
+};
+
+struct GltfPrimitive {
+    std::shared_ptr<Mesh> mesh;
+    //Index into GltfModel::materials, -1 if the primitive uses the default material.
+    int32_t material = -1;
+};
+
+//The metallic roughness material of the glTF spec. Texture coordinate sets and samplers aren't kept, every texture is
+//sampled with TEXCOORD_0 and the renderer's own sampler.
+struct GltfMaterial {
+    glm::vec4 baseColorFactor {1};
+    float metallicFactor = 1;
+    float roughnessFactor = 1;
+    glm::vec3 emissiveFactor {0};
+    //Indices into GltfModel::images, -1 if the material doesn't have the texture.
+    int32_t baseColorImage = -1;
+    int32_t metallicRoughnessImage = -1;
+    int32_t normalImage = -1;
+    int32_t occlusionImage = -1;
+    int32_t emissiveImage = -1;
+    bool doubleSided = false;
+    //The material's record in the BindlessTable, Material::NO_BINDLESS_INDEX if the table is disabled.
+    uint32_t bindlessIndex = Material::NO_BINDLESS_INDEX;
+};
+
+//A node of the loaded scene that draws a mesh.
+struct GltfNode {
+    std::string name;
+    //The node's transform multiplied by the transforms of all of its parents.
+    glm::mat4 transform {1};
+    //Index into GltfModel::meshes.
+    int32_t mesh;
+};
+
+struct GltfModel {
+    //The primitives of every mesh in the file, which are already initialized.
+    std::vector<std::vector<GltfPrimitive>> meshes;
+    std::vector<GltfMaterial> materials;
+    //Images that fail to decode are the error texture.
+    std::vector<AllocatedImage> images;
+    std::vector<GltfNode> nodes;
+};
+
+//Loads glTF and GLB files into the mesh pool. The file is mapped instead of read, every primitive's accessors and every
+//image are decoded in parallel, and the pool is grown once for the whole file, so all of the meshes and images are
+//uploaded in the same UploadManager batch. Only triangle list primitives are loaded.
+class GltfLoader {
+public:
+    //sceneToLoad is the name of the scene whose nodes end up in GltfModel::nodes, or nullptr for the file's default
+    //scene. Returns false and logs why if the file can't be loaded. Must be called on the render thread, since it
+    //allocates from the MeshPool and adds the images to XTPVulkan::allLoadedImages.
+    static bool load(const std::string &path, bool isBinary, GltfModel &model, const char* sceneToLoad = nullptr);
+};
+
+#endif
+
+#endif //GLTFLOADER_H
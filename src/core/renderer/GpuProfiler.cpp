@@ -0,0 +1,154 @@
+#include "GpuProfiler.h"
+
+#include "Profiler.h"
+#include "TimeManager.h"
+#include "VulkanRenderInfo.h"
+#include "XTPVulkan.h"
+
+VkQueryPool GpuProfiler::queryPool = VK_NULL_HANDLE;
+uint32_t GpuProfiler::zonesPerFrame;
+uint64_t GpuProfiler::timestampMask;
+std::vector<GpuProfiler::FrameQueries> GpuProfiler::frames;
+GpuProfiler::FrameQueries* GpuProfiler::recordingFrame = nullptr;
+uint32_t GpuProfiler::recordingFrameIndex;
+std::vector<uint32_t> GpuProfiler::openZones;
+bool GpuProfiler::warnedAboutCapacity = false;
+
+void GpuProfiler::init() {
+    ZoneScopedN("GpuProfiler::init");
+    uint32_t queueFamilyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(XTPVulkan::gpu, &queueFamilyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(XTPVulkan::gpu, &queueFamilyCount, queueFamilies.data());
+    const uint32_t validBits = queueFamilies[XTPVulkan::queueIndices.graphicsFamily.value()].timestampValidBits;
+    if (validBits == 0) {
+        timestampMask = 0;
+        XTPVulkan::logger->logWarning("The Graphics Queue Does Not Support Timestamps, GPU Zones Will Not Be Recorded");
+        return;
+    }
+    timestampMask = validBits >= 64 ? UINT64_MAX : (1ull << validBits) - 1;
+
+    const uint32_t maxFramesInFlight = VulkanRenderInfo::INSTANCE->getMaxFramesInFlight();
+    zonesPerFrame = VulkanRenderInfo::INSTANCE->getMaxGpuProfileZones();
+    frames = std::vector<FrameQueries>(maxFramesInFlight);
+
+    VkQueryPoolCreateInfo createInfo {};
+    createInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    createInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    createInfo.queryCount = maxFramesInFlight * zonesPerFrame * 2;
+    if (vkCreateQueryPool(XTPVulkan::device, &createInfo, nullptr, &queryPool) != VK_SUCCESS) {
+        XTPVulkan::logger->logCritical("Failed To Create The GPU Profiler's Query Pool!");
+    }
+    //Reading a query that was never reset is invalid, so every range starts out reset.
+    vkResetQueryPool(XTPVulkan::device, queryPool, 0, createInfo.queryCount);
+}
+
+void GpuProfiler::cleanUp() {
+    if (queryPool != VK_NULL_HANDLE) {
+        vkDestroyQueryPool(XTPVulkan::device, queryPool, nullptr);
+        queryPool = VK_NULL_HANDLE;
+    }
+    frames.clear();
+    openZones.clear();
+    recordingFrame = nullptr;
+}
+
+void GpuProfiler::collect(const uint32_t frameIndex) {
+    ZoneScopedN("GpuProfiler::collect");
+    if (queryPool == VK_NULL_HANDLE || !frames[frameIndex].recorded) {
+        return;
+    }
+    FrameQueries &frame = frames[frameIndex];
+    frame.recorded = false;
+
+    const uint32_t queryCount = static_cast<uint32_t>(frame.zones.size() * 2);
+    std::vector<uint64_t> timestamps(queryCount);
+    //The frame's fence has been waited on, so the results are available without waiting for them.
+    if (vkGetQueryPoolResults(XTPVulkan::device, queryPool, frameIndex * zonesPerFrame * 2, queryCount,
+                              timestamps.size() * sizeof(uint64_t), timestamps.data(), sizeof(uint64_t),
+                              VK_QUERY_RESULT_64_BIT) != VK_SUCCESS) {
+        return;
+    }
+
+    //Zones are in the order they were opened, so the first one starts first.
+    const double period = XTPVulkan::gpuProperties.limits.timestampPeriod;
+    const uint64_t firstTimestamp = timestamps[0] & timestampMask;
+    const auto toNanos = [&frame, period, firstTimestamp](const uint64_t timestamp) {
+        const uint64_t ticks = ((timestamp & timestampMask) - firstTimestamp) & timestampMask;
+        return frame.submitNanos + static_cast<int64_t>(static_cast<double>(ticks) * period);
+    };
+    std::vector<ProfileZoneRecord> zones;
+    zones.reserve(frame.zones.size());
+    for (size_t i = 0; i < frame.zones.size(); ++i) {
+        zones.push_back({frame.zones[i].name, toNanos(timestamps[i * 2]), toNanos(timestamps[i * 2 + 1]),
+                         frame.zones[i].depth, Profiler::GPU_THREAD});
+    }
+    Profiler::addGpuZones(frame.frameNumber, std::move(zones));
+}
+
+void GpuProfiler::beginFrame(VkCommandBuffer commandBuffer, const uint32_t frameIndex) {
+    if (queryPool == VK_NULL_HANDLE || !Profiler::isEnabled()) {
+        recordingFrame = nullptr;
+        return;
+    }
+    recordingFrame = &frames[frameIndex];
+    recordingFrameIndex = frameIndex;
+    recordingFrame->frameNumber = Profiler::getFrameNumber();
+    recordingFrame->zones.clear();
+    //collect() has already read this range, and the GPU is done with it.
+    vkResetQueryPool(XTPVulkan::device, queryPool, frameIndex * zonesPerFrame * 2, zonesPerFrame * 2);
+    beginZone(commandBuffer, "Frame");
+}
+
+void GpuProfiler::endFrame(VkCommandBuffer commandBuffer) {
+    if (recordingFrame == nullptr) {
+        return;
+    }
+    while (!openZones.empty()) {
+        endZone(commandBuffer);
+    }
+    recordingFrame->recorded = !recordingFrame->zones.empty();
+    recordingFrame = nullptr;
+}
+
+void GpuProfiler::markSubmitted(const uint32_t frameIndex) {
+    if (!frames.empty()) {
+        frames[frameIndex].submitNanos = TimeManager::getCurrentTimeNano();
+    }
+}
+
+void GpuProfiler::beginZone(VkCommandBuffer commandBuffer, const char* name) {
+    if (recordingFrame == nullptr) {
+        return;
+    }
+    const uint32_t zone = static_cast<uint32_t>(recordingFrame->zones.size());
+    if (zone == zonesPerFrame) {
+        if (!warnedAboutCapacity) {
+            warnedAboutCapacity = true;
+            XTPVulkan::logger->logWarning("More Than {} GPU Zones In A Frame, The Rest Are Skipped", zonesPerFrame);
+        }
+        //Still pushed, so the matching endZone() has something to pop.
+        openZones.push_back(UINT32_MAX);
+        return;
+    }
+    recordingFrame->zones.push_back({name, static_cast<uint32_t>(openZones.size())});
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queryPool,
+                        (recordingFrameIndex * zonesPerFrame + zone) * 2);
+    openZones.push_back(zone);
+}
+
+void GpuProfiler::endZone(VkCommandBuffer commandBuffer) {
+    if (recordingFrame == nullptr || openZones.empty()) {
+        return;
+    }
+    const uint32_t zone = openZones.back();
+    openZones.pop_back();
+    if (zone != UINT32_MAX) {
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPool,
+                            (recordingFrameIndex * zonesPerFrame + zone) * 2 + 1);
+    }
+}
+
+bool GpuProfiler::isRecording() {
+    return recordingFrame != nullptr;
+}
@@ -0,0 +1,66 @@
+#ifndef GPUPROFILER_H
+#define GPUPROFILER_H
+
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+//Times spans of a frame's command buffer with pairs of timestamps and hands them to the Profiler as GPU zones once the
+//frame has finished. Each frame in flight has its own range of getMaxGpuProfileZones() pairs in one query pool, zones
+//past that are skipped. Only used from the render thread, and only records while the Profiler is enabled.
+class GpuProfiler {
+public:
+    static void init();
+
+    static void cleanUp();
+
+    //Called once the fence of the given frame has been waited on, before it is recorded again. Reads the timestamps the
+    //frame wrote last time.
+    static void collect(uint32_t frameIndex);
+
+    //Called right after the command buffer is begun.
+    static void beginFrame(VkCommandBuffer commandBuffer, uint32_t frameIndex);
+
+    //Called right before the command buffer is ended. Closes any zone left open.
+    static void endFrame(VkCommandBuffer commandBuffer);
+
+    //Called right after the frame is submitted, to line its zones up with the CPU ones.
+    static void markSubmitted(uint32_t frameIndex);
+
+    //Zones can be nested, but must be opened and closed in the same command buffer outside of a render pass instance.
+    //name must outlive the Profiler, see Profiler::internName().
+    static void beginZone(VkCommandBuffer commandBuffer, const char* name);
+
+    static void endZone(VkCommandBuffer commandBuffer);
+
+    //Whether the frame being recorded is timed, for callers that have to do work to name their zones.
+    [[nodiscard]] static bool isRecording();
+
+private:
+    struct GpuZone {
+        const char* name;
+        uint32_t depth;
+    };
+
+    struct FrameQueries {
+        uint64_t frameNumber;
+        //Zone i uses queries 2i and 2i + 1 of the frame's range.
+        std::vector<GpuZone> zones;
+        int64_t submitNanos;
+        bool recorded;
+    };
+
+    static VkQueryPool queryPool;
+    static uint32_t zonesPerFrame;
+    //Masks off the bits of a timestamp the queue doesn't write. Zero if the queue doesn't support timestamps.
+    static uint64_t timestampMask;
+    static std::vector<FrameQueries> frames;
+    static FrameQueries* recordingFrame;
+    static uint32_t recordingFrameIndex;
+    static std::vector<uint32_t> openZones;
+    static bool warnedAboutCapacity;
+};
+
+
+
+#endif //GPUPROFILER_H
@@ -0,0 +1,182 @@
+#include "GpuStatistics.h"
+
+#include "Events.h"
+#include "MemoryBudgetEvent.h"
+#include "VulkanRenderInfo.h"
+#include "XTPVulkan.h"
+
+bool GpuStatistics::pipelineStatisticsSupported = false;
+bool GpuStatistics::inheritedQueriesSupported = false;
+bool GpuStatistics::memoryBudgetSupported = false;
+VkQueryPool GpuStatistics::queryPool = VK_NULL_HANDLE;
+uint32_t GpuStatistics::passesPerFrame;
+std::vector<GpuStatistics::FrameQueries> GpuStatistics::frames;
+GpuStatistics::FrameQueries* GpuStatistics::recordingFrame = nullptr;
+uint32_t GpuStatistics::recordingFrameIndex;
+bool GpuStatistics::passOpen = false;
+uint32_t GpuStatistics::frameNumber;
+uint32_t GpuStatistics::framesSinceDetailedStatistics;
+std::vector<bool> GpuStatistics::heapsOverThreshold;
+
+//How many statistics are in PIPELINE_STATISTICS. They are written in the order of their bits, which PassStatistics follows.
+static constexpr uint32_t STATISTIC_COUNT = 6;
+
+void GpuStatistics::init() {
+    ZoneScopedN("GpuStatistics::init");
+    frameNumber = 0;
+    //So detailed statistics are calculated on the first frame.
+    framesSinceDetailedStatistics = VulkanRenderInfo::INSTANCE->getMemoryStatisticsInterval();
+    heapsOverThreshold.clear();
+
+    if (!VulkanRenderInfo::INSTANCE->usePipelineStatistics()) {
+        return;
+    }
+    if (!pipelineStatisticsSupported) {
+        XTPVulkan::logger->logWarning("Pipeline Statistics Queries Aren't Supported, Pass Statistics Are Disabled");
+        return;
+    }
+
+    const uint32_t maxFramesInFlight = VulkanRenderInfo::INSTANCE->getMaxFramesInFlight();
+    passesPerFrame = VulkanRenderInfo::INSTANCE->getMaxPipelineStatisticsPasses();
+    frames = std::vector<FrameQueries>(maxFramesInFlight);
+
+    VkQueryPoolCreateInfo createInfo {};
+    createInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    createInfo.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+    createInfo.queryCount = maxFramesInFlight * passesPerFrame;
+    createInfo.pipelineStatistics = PIPELINE_STATISTICS;
+    if (vkCreateQueryPool(XTPVulkan::device, &createInfo, nullptr, &queryPool) != VK_SUCCESS) {
+        XTPVulkan::logger->logCritical("Failed To Create The Pipeline Statistics Query Pool!");
+    }
+    vkResetQueryPool(XTPVulkan::device, queryPool, 0, createInfo.queryCount);
+}
+
+void GpuStatistics::cleanUp() {
+    if (queryPool != VK_NULL_HANDLE) {
+        vkDestroyQueryPool(XTPVulkan::device, queryPool, nullptr);
+        queryPool = VK_NULL_HANDLE;
+    }
+    frames.clear();
+    recordingFrame = nullptr;
+    passOpen = false;
+}
+
+void GpuStatistics::collect(const uint32_t frameIndex) {
+    ZoneScopedN("GpuStatistics::collect");
+    collectMemoryStatistics();
+
+    std::vector<PassStatistics> &passes = XTPVulkan::lastGpuStatistics.passes;
+    passes.clear();
+    if (queryPool == VK_NULL_HANDLE || !frames[frameIndex].recorded) {
+        return;
+    }
+    FrameQueries &frame = frames[frameIndex];
+    frame.recorded = false;
+
+    std::vector<uint64_t> results(frame.passNames.size() * STATISTIC_COUNT);
+    //The frame's fence has been waited on, so the results are available without waiting for them.
+    if (vkGetQueryPoolResults(XTPVulkan::device, queryPool, frameIndex * passesPerFrame,
+                              static_cast<uint32_t>(frame.passNames.size()), results.size() * sizeof(uint64_t),
+                              results.data(), STATISTIC_COUNT * sizeof(uint64_t), VK_QUERY_RESULT_64_BIT) != VK_SUCCESS) {
+        return;
+    }
+    passes.reserve(frame.passNames.size());
+    for (size_t i = 0; i < frame.passNames.size(); ++i) {
+        const uint64_t* statistics = &results[i * STATISTIC_COUNT];
+        passes.push_back({frame.passNames[i], statistics[0], statistics[1], statistics[2], statistics[3], statistics[4],
+                          statistics[5]});
+    }
+}
+
+void GpuStatistics::beginFrame(const uint32_t frameIndex) {
+    //Without inherited queries, no query can be active while secondary command buffers are executed.
+    if (queryPool == VK_NULL_HANDLE || (XTPVulkan::recordingChunkCount > 0 && !inheritedQueriesSupported)) {
+        recordingFrame = nullptr;
+        return;
+    }
+    recordingFrame = &frames[frameIndex];
+    recordingFrameIndex = frameIndex;
+    recordingFrame->passNames.clear();
+    //collect() has already read this range, and the GPU is done with it.
+    vkResetQueryPool(XTPVulkan::device, queryPool, frameIndex * passesPerFrame, passesPerFrame);
+}
+
+void GpuStatistics::endFrame(VkCommandBuffer commandBuffer) {
+    if (recordingFrame == nullptr) {
+        return;
+    }
+    endPass(commandBuffer);
+    recordingFrame->recorded = !recordingFrame->passNames.empty();
+    recordingFrame = nullptr;
+}
+
+void GpuStatistics::beginPass(VkCommandBuffer commandBuffer, const std::string &name) {
+    if (recordingFrame == nullptr || passOpen || recordingFrame->passNames.size() == passesPerFrame) {
+        return;
+    }
+    vkCmdBeginQuery(commandBuffer, queryPool,
+                    recordingFrameIndex * passesPerFrame + static_cast<uint32_t>(recordingFrame->passNames.size()), 0);
+    recordingFrame->passNames.push_back(name);
+    passOpen = true;
+}
+
+void GpuStatistics::endPass(VkCommandBuffer commandBuffer) {
+    if (recordingFrame == nullptr || !passOpen) {
+        return;
+    }
+    vkCmdEndQuery(commandBuffer, queryPool,
+                  recordingFrameIndex * passesPerFrame + static_cast<uint32_t>(recordingFrame->passNames.size()) - 1);
+    passOpen = false;
+}
+
+VkQueryPipelineStatisticFlags GpuStatistics::getInheritedPipelineStatistics() {
+    return queryPool != VK_NULL_HANDLE && inheritedQueriesSupported ? PIPELINE_STATISTICS : 0;
+}
+
+void GpuStatistics::collectMemoryStatistics() {
+    //Lets VMA fetch a fresh budget from VK_EXT_memory_budget.
+    vmaSetCurrentFrameIndex(XTPVulkan::allocator, ++frameNumber);
+
+    const VkPhysicalDeviceMemoryProperties* memoryProperties;
+    vmaGetMemoryProperties(XTPVulkan::allocator, &memoryProperties);
+    VmaBudget budgets[VK_MAX_MEMORY_HEAPS];
+    vmaGetHeapBudgets(XTPVulkan::allocator, budgets);
+
+    std::vector<MemoryHeapStatistics> &heaps = XTPVulkan::lastGpuStatistics.heaps;
+    heaps.resize(memoryProperties->memoryHeapCount);
+    heapsOverThreshold.resize(memoryProperties->memoryHeapCount);
+
+    const bool detailed = ++framesSinceDetailedStatistics >= VulkanRenderInfo::INSTANCE->getMemoryStatisticsInterval();
+    VmaTotalStatistics totalStatistics;
+    if (detailed) {
+        framesSinceDetailedStatistics = 0;
+        vmaCalculateStatistics(XTPVulkan::allocator, &totalStatistics);
+    }
+
+    const double threshold = VulkanRenderInfo::INSTANCE->getMemoryBudgetThreshold();
+    for (uint32_t i = 0; i < memoryProperties->memoryHeapCount; ++i) {
+        MemoryHeapStatistics &heap = heaps[i];
+        const VmaBudget &budget = budgets[i];
+        heap.flags = memoryProperties->memoryHeaps[i].flags;
+        heap.size = memoryProperties->memoryHeaps[i].size;
+        heap.usage = budget.usage;
+        heap.budget = budget.budget;
+        heap.blockBytes = budget.statistics.blockBytes;
+        heap.allocationBytes = budget.statistics.allocationBytes;
+        heap.blockCount = budget.statistics.blockCount;
+        heap.allocationCount = budget.statistics.allocationCount;
+        if (detailed) {
+            heap.unusedRangeCount = totalStatistics.memoryHeap[i].unusedRangeCount;
+            heap.largestUnusedRange = totalStatistics.memoryHeap[i].unusedRangeSizeMax;
+        }
+
+        const bool overThreshold = heap.budget > 0 &&
+                                   static_cast<double>(heap.usage) >= static_cast<double>(heap.budget) * threshold;
+        if (overThreshold && !heapsOverThreshold[i]) {
+            Events::callFunctionOnAllEventsOfType<MemoryBudgetEvent>([i, &heap](MemoryBudgetEvent *event) {
+                event->onMemoryBudgetThreshold(i, heap);
+            });
+        }
+        heapsOverThreshold[i] = overThreshold;
+    }
+}
@@ -0,0 +1,107 @@
+#ifndef GPUSTATISTICS_H
+#define GPUSTATISTICS_H
+
+#include <string>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+//What the GPU did while drawing one pass, from a VK_QUERY_TYPE_PIPELINE_STATISTICS query around it.
+struct PassStatistics {
+    std::string name;
+    uint64_t inputAssemblyVertices;
+    uint64_t inputAssemblyPrimitives;
+    uint64_t vertexShaderInvocations;
+    uint64_t clippingInvocations;
+    //The primitives left after clipping, i.e. the ones that are rasterized.
+    uint64_t clippingPrimitives;
+    uint64_t fragmentShaderInvocations;
+};
+
+//One memory heap, from vmaGetHeapBudgets(). With VK_EXT_memory_budget usage and budget come from the driver and include
+//other processes, otherwise they are estimated from this process's allocations and 80% of the heap's size.
+struct MemoryHeapStatistics {
+    VkMemoryHeapFlags flags;
+    VkDeviceSize size;
+    VkDeviceSize usage;
+    VkDeviceSize budget;
+    //The memory VMA has allocated from Vulkan, and how much of that is handed out.
+    VkDeviceSize blockBytes;
+    VkDeviceSize allocationBytes;
+    uint32_t blockCount;
+    uint32_t allocationCount;
+    //The free space between allocations, from vmaCalculateStatistics(). Only updated every
+    //getMemoryStatisticsInterval() frames, since it walks every allocation.
+    uint32_t unusedRangeCount;
+    VkDeviceSize largestUnusedRange;
+};
+
+struct GpuFrameStatistics {
+    //The previous frame drawn into the same frame slot, since the current one hasn't been drawn yet. Empty if pipeline
+    //statistics are disabled or unsupported.
+    std::vector<PassStatistics> passes;
+    std::vector<MemoryHeapStatistics> heaps;
+};
+
+//Collects pipeline statistics for every pass and the allocator's memory budgets into XTPVulkan::lastGpuStatistics each
+//frame, and calls MemoryBudgetEvent when a heap's usage gets close to its budget. Only used from the render thread.
+class GpuStatistics {
+public:
+    //Set while the device is created.
+    static bool pipelineStatisticsSupported;
+    static bool inheritedQueriesSupported;
+    static bool memoryBudgetSupported;
+
+    static constexpr VkQueryPipelineStatisticFlags PIPELINE_STATISTICS =
+        VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT |
+        VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT |
+        VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |
+        VK_QUERY_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS_BIT |
+        VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT |
+        VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT;
+
+    static void init();
+
+    static void cleanUp();
+
+    //Called once the fence of the given frame has been waited on, before it is recorded again.
+    static void collect(uint32_t frameIndex);
+
+    //Called right after the command buffer is begun.
+    static void beginFrame(uint32_t frameIndex);
+
+    //Called right before the command buffer is ended. Closes the pass if one is still open.
+    static void endFrame(VkCommandBuffer commandBuffer);
+
+    //Passes can't be nested, and must be begun and ended in the same command buffer outside of a render pass instance.
+    static void beginPass(VkCommandBuffer commandBuffer, const std::string &name);
+
+    static void endPass(VkCommandBuffer commandBuffer);
+
+    //What secondary command buffers executed inside a pass have to inherit, see
+    //VkCommandBufferInheritanceInfo::pipelineStatistics.
+    [[nodiscard]] static VkQueryPipelineStatisticFlags getInheritedPipelineStatistics();
+
+private:
+    struct FrameQueries {
+        std::vector<std::string> passNames;
+        bool recorded;
+    };
+
+    static VkQueryPool queryPool;
+    static uint32_t passesPerFrame;
+    static std::vector<FrameQueries> frames;
+    static FrameQueries* recordingFrame;
+    static uint32_t recordingFrameIndex;
+    static bool passOpen;
+    static uint32_t frameNumber;
+    static uint32_t framesSinceDetailedStatistics;
+    //Whether each heap is over the threshold, so the event is only called when it crosses it.
+    static std::vector<bool> heapsOverThreshold;
+
+    static void collectMemoryStatistics();
+};
+
+
+
+#endif //GPUSTATISTICS_H
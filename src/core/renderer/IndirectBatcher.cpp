@@ -0,0 +1,222 @@
+#include "IndirectBatcher.h"
+
+#include <algorithm>
+#include <cstring>
+#include <tuple>
+
+#include "BindlessTable.h"
+
+std::vector<DrawItem> IndirectBatcher::items;
+bool IndirectBatcher::useMultiDrawIndirect;
+std::vector<DrawItem> IndirectBatcher::lastItems;
+std::vector<IndirectBatcher::MeshRange> IndirectBatcher::meshRanges;
+std::vector<IndirectBatcher::MeshRange> IndirectBatcher::lastMeshRanges;
+std::vector<Renderable*> IndirectBatcher::orderedRenderables;
+std::vector<uint32_t> IndirectBatcher::orderedMaterialIndices;
+std::vector<VkDrawIndexedIndirectCommand> IndirectBatcher::commands;
+std::vector<IndirectBatch> IndirectBatcher::batches;
+uint64_t IndirectBatcher::commandGeneration;
+std::vector<uint64_t> IndirectBatcher::uploadedCommandGeneration;
+std::vector<AllocatedBuffer> IndirectBatcher::commandBuffers;
+std::vector<AllocatedBuffer> IndirectBatcher::objectBuffers;
+
+void IndirectBatcher::init() {
+    const uint32_t maxFramesInFlight = VulkanRenderInfo::INSTANCE->getMaxFramesInFlight();
+    commandBuffers = std::vector<AllocatedBuffer>(maxFramesInFlight);
+    objectBuffers = std::vector<AllocatedBuffer>(maxFramesInFlight);
+    uploadedCommandGeneration = std::vector<uint64_t>(maxFramesInFlight);
+    //Generation 0 means nothing has been uploaded yet.
+    commandGeneration = 1;
+}
+
+void IndirectBatcher::cleanUp() {
+    for (AllocatedBuffer &buffer: commandBuffers) {
+        if (buffer.internalBuffer != VK_NULL_HANDLE) {
+            XTPVulkan::destroyAllocatedBuffer(&buffer);
+        }
+    }
+    for (AllocatedBuffer &buffer: objectBuffers) {
+        if (buffer.internalBuffer != VK_NULL_HANDLE) {
+            XTPVulkan::destroyAllocatedBuffer(&buffer);
+        }
+    }
+    commandBuffers.clear();
+    objectBuffers.clear();
+    items.clear();
+    lastItems.clear();
+    meshRanges.clear();
+    lastMeshRanges.clear();
+    orderedRenderables.clear();
+    orderedMaterialIndices.clear();
+    batches.clear();
+    commands.clear();
+}
+
+void IndirectBatcher::build(const uint32_t frameIndex) {
+    ZoneScopedN("IndirectBatcher::build");
+    meshRanges.clear();
+    meshRanges.reserve(items.size());
+    for (const DrawItem &item: items) {
+        Mesh* mesh = item.renderable->getMesh().get();
+        meshRanges.push_back({mesh, mesh->getIndexCount(), mesh->getFirstIndex(), mesh->getVertexOffset(),
+                              mesh->getVertexBuffer().internalBuffer, mesh->getIndexBuffer().internalBuffer});
+    }
+
+    const bool changed = items.size() != lastItems.size() || meshRanges != lastMeshRanges ||
+        !std::equal(items.begin(), items.end(), lastItems.begin(), [](const DrawItem &a, const DrawItem &b) {
+            return a.renderable == b.renderable && a.material == b.material && a.shader == b.shader;
+        });
+
+    if (changed) {
+        lastItems = items;
+        lastMeshRanges = meshRanges;
+        rebuildBatches();
+    }
+
+    if (orderedRenderables.empty()) {
+        return;
+    }
+
+    ensureCapacity(objectBuffers[frameIndex], orderedRenderables.size() * sizeof(IndirectObjectData),
+                   VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT);
+    auto* objectData = static_cast<IndirectObjectData*>(objectBuffers[frameIndex].info.pMappedData);
+    for (size_t i = 0; i < orderedRenderables.size(); ++i) {
+        objectData[i].transform = orderedRenderables[i]->getTransform();
+        objectData[i].materialIndex = orderedMaterialIndices[i];
+    }
+
+    if (uploadedCommandGeneration[frameIndex] != commandGeneration) {
+        ensureCapacity(commandBuffers[frameIndex], commands.size() * sizeof(VkDrawIndexedIndirectCommand),
+                       VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT);
+        memcpy(commandBuffers[frameIndex].info.pMappedData, commands.data(),
+               commands.size() * sizeof(VkDrawIndexedIndirectCommand));
+        uploadedCommandGeneration[frameIndex] = commandGeneration;
+    }
+}
+
+void IndirectBatcher::record(VkCommandBuffer commandBuffer, const uint32_t frameIndex) {
+    ZoneScopedN("IndirectBatcher::record");
+    if (batches.empty()) {
+        return;
+    }
+
+    const IndirectDrawPushConstants pushConstants {
+        XTPVulkan::globalSceneDataBuffers[frameIndex].gpuAddress,
+        objectBuffers[frameIndex].gpuAddress,
+        BindlessTable::getMaterialBufferAddress()
+    };
+
+    //Binding the pool up front means batches of pooled meshes don't bind anything themselves.
+    MeshPool::bind(commandBuffer);
+
+    ShaderObject* currentShader = nullptr;
+    Material* currentMaterial = nullptr;
+    for (const IndirectBatch &batch: batches) {
+        if (batch.shader != currentShader) {
+            currentShader = batch.shader;
+            currentShader->prepareForRender(commandBuffer);
+            const VkShaderStageFlags stages = currentShader->usesBindlessTable()
+                                                  ? VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT
+                                                  : VK_SHADER_STAGE_VERTEX_BIT;
+            vkCmdPushConstants(commandBuffer, currentShader->getLayout(), stages, 0, sizeof(IndirectDrawPushConstants),
+                               &pushConstants);
+            BindlessTable::bind(commandBuffer, currentShader);
+            currentMaterial = nullptr;
+        }
+        if (batch.material != currentMaterial) {
+            currentMaterial = batch.material;
+            if (currentMaterial != nullptr) {
+                currentMaterial->prepareForRender(commandBuffer, currentShader);
+            }
+        }
+
+        batch.mesh->bind(commandBuffer);
+
+        if (useMultiDrawIndirect) {
+            vkCmdDrawIndexedIndirect(commandBuffer, commandBuffers[frameIndex].internalBuffer,
+                                     batch.firstCommand * sizeof(VkDrawIndexedIndirectCommand), batch.commandCount,
+                                     sizeof(VkDrawIndexedIndirectCommand));
+        } else {
+            for (uint32_t i = batch.firstCommand; i < batch.firstCommand + batch.commandCount; ++i) {
+                const VkDrawIndexedIndirectCommand &command = commands[i];
+                vkCmdDrawIndexed(commandBuffer, command.indexCount, command.instanceCount, command.firstIndex,
+                                 command.vertexOffset, command.firstInstance);
+            }
+        }
+    }
+}
+
+void IndirectBatcher::rebuildBatches() {
+    ZoneScopedN("IndirectBatcher::rebuildBatches");
+    struct SortEntry {
+        DrawItem item;
+        //nullptr for bindless materials, which don't need a batch of their own.
+        Material* batchMaterial;
+        uint32_t materialIndex;
+        //The range compared in build(), rather than asking the mesh again, since a StreamedMesh can finish loading in
+        //between.
+        MeshRange range;
+    };
+
+    std::vector<SortEntry> entries;
+    entries.reserve(items.size());
+    for (size_t i = 0; i < items.size(); ++i) {
+        const DrawItem &item = items[i];
+        const uint32_t materialIndex = item.material->getBindlessIndex();
+        Material* batchMaterial = materialIndex == Material::NO_BINDLESS_INDEX ? item.material : nullptr;
+        entries.push_back({item, batchMaterial, materialIndex, meshRanges[i]});
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const SortEntry &a, const SortEntry &b) {
+        return std::tie(a.item.shader, a.batchMaterial, a.range.vertexBuffer, a.range.indexBuffer, a.range.mesh) <
+               std::tie(b.item.shader, b.batchMaterial, b.range.vertexBuffer, b.range.indexBuffer, b.range.mesh);
+    });
+
+    orderedRenderables.clear();
+    orderedMaterialIndices.clear();
+    commands.clear();
+    batches.clear();
+    orderedRenderables.reserve(entries.size());
+    orderedMaterialIndices.reserve(entries.size());
+
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const SortEntry &entry = entries[i];
+        const bool newBatch = batches.empty() || entry.item.shader != entries[i - 1].item.shader ||
+                              entry.batchMaterial != entries[i - 1].batchMaterial ||
+                              entry.range.vertexBuffer != entries[i - 1].range.vertexBuffer ||
+                              entry.range.indexBuffer != entries[i - 1].range.indexBuffer;
+        if (newBatch) {
+            batches.push_back({entry.item.shader, entry.batchMaterial, entry.range.mesh,
+                               static_cast<uint32_t>(commands.size()), 0});
+        }
+
+        //Consecutive renderables with the same mesh are instances of the same command.
+        if (newBatch || entry.range.mesh != entries[i - 1].range.mesh) {
+            commands.push_back({entry.range.indexCount, 0, entry.range.firstIndex, entry.range.vertexOffset,
+                                static_cast<uint32_t>(orderedRenderables.size())});
+            batches.back().commandCount++;
+        }
+        commands.back().instanceCount++;
+        orderedRenderables.emplace_back(entry.item.renderable);
+        orderedMaterialIndices.emplace_back(entry.materialIndex);
+    }
+
+    commandGeneration++;
+}
+
+bool IndirectBatcher::MeshRange::operator==(const MeshRange &other) const {
+    return mesh == other.mesh && indexCount == other.indexCount && firstIndex == other.firstIndex &&
+           vertexOffset == other.vertexOffset && vertexBuffer == other.vertexBuffer && indexBuffer == other.indexBuffer;
+}
+
+void IndirectBatcher::ensureCapacity(AllocatedBuffer &buffer, const VkDeviceSize size, const VkBufferUsageFlags usage) {
+    if (buffer.internalBuffer != VK_NULL_HANDLE && buffer.info.size >= size) {
+        return;
+    }
+    if (buffer.internalBuffer != VK_NULL_HANDLE) {
+        XTPVulkan::destroyAllocatedBuffer(&buffer);
+    }
+    //Grow geometrically, so adding renderables one at a time does not recreate the buffer every frame.
+    buffer = XTPVulkan::createSimpleBuffer(std::max<VkDeviceSize>(size, buffer.info.size * 2), usage,
+                                           VMA_MEMORY_USAGE_CPU_TO_GPU, false);
+}
@@ -0,0 +1,90 @@
+#ifndef INDIRECTBATCHER_H
+#define INDIRECTBATCHER_H
+
+#include <vector>
+
+#include "XTPVulkan.h"
+#include "glm/glm.hpp"
+
+//The push constants passed to every shader that draws indirectly. objectDataAddress points to one IndirectObjectData per
+//object, which the vertex shader indexes with gl_InstanceIndex. materialDataAddress is
+//BindlessTable::getMaterialBufferAddress(), or 0 if the table is disabled.
+struct IndirectDrawPushConstants {
+    VkDeviceAddress sceneDataAddress;
+    VkDeviceAddress objectDataAddress;
+    VkDeviceAddress materialDataAddress;
+};
+
+struct IndirectObjectData {
+    glm::mat4 transform;
+    //Index of the object's BindlessMaterialData, or Material::NO_BINDLESS_INDEX if its material isn't bindless.
+    uint32_t materialIndex;
+    //Keeps the struct a multiple of 16 bytes, like its std430 counterpart.
+    uint32_t padding[3];
+};
+
+//A run of indirect commands sharing a shader, material and vertex/index buffers, which is issued with a single draw call.
+//Bindless materials don't split batches, so material is nullptr for a batch of them.
+struct IndirectBatch {
+    ShaderObject* shader;
+    Material* material;
+    Mesh* mesh;
+    uint32_t firstCommand;
+    uint32_t commandCount;
+};
+
+//Draws every renderable whose shader returns true from ShaderObject::drawsIndirect. Renderables are grouped into batches,
+//and renderables sharing a mesh become instances of a single VkDrawIndexedIndirectCommand, so the only per object work
+//each frame is copying its transform. Since every SimpleMesh lives in the MeshPool, all of them end up in one batch per
+//shader and material, or per shader if their materials are bindless.
+class IndirectBatcher {
+public:
+    //Filled by XTPVulkan::prepareDrawList every frame.
+    static std::vector<DrawItem> items;
+    //Whether one vkCmdDrawIndexedIndirect can be issued per batch. If not, each command of a batch is drawn separately.
+    static bool useMultiDrawIndirect;
+
+    static void init();
+
+    static void cleanUp();
+
+    //Writes this frame's transforms, and the commands if the set of renderables changed, into the frame's buffers.
+    static void build(uint32_t frameIndex);
+
+    static void record(VkCommandBuffer commandBuffer, uint32_t frameIndex);
+
+private:
+    //What an item's command was built from. A mesh can change its range and buffers behind the same pointer, e.g. a
+    //StreamedMesh once it has loaded, and a renderable can return a different mesh, so both are compared every frame
+    //rather than just the renderable.
+    struct MeshRange {
+        Mesh* mesh;
+        uint32_t indexCount;
+        uint32_t firstIndex;
+        int32_t vertexOffset;
+        VkBuffer vertexBuffer;
+        VkBuffer indexBuffer;
+
+        bool operator==(const MeshRange &other) const;
+    };
+
+    static std::vector<DrawItem> lastItems;
+    static std::vector<MeshRange> meshRanges;
+    static std::vector<MeshRange> lastMeshRanges;
+    static std::vector<Renderable*> orderedRenderables;
+    static std::vector<uint32_t> orderedMaterialIndices;
+    static std::vector<VkDrawIndexedIndirectCommand> commands;
+    static std::vector<IndirectBatch> batches;
+    static uint64_t commandGeneration;
+    static std::vector<uint64_t> uploadedCommandGeneration;
+    static std::vector<AllocatedBuffer> commandBuffers;
+    static std::vector<AllocatedBuffer> objectBuffers;
+
+    static void rebuildBatches();
+
+    static void ensureCapacity(AllocatedBuffer& buffer, VkDeviceSize size, VkBufferUsageFlags usage);
+};
+
+
+
+#endif //INDIRECTBATCHER_H
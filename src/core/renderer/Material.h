@@ -4,6 +4,8 @@
 
 class Material {
 public:
+    static constexpr uint32_t NO_BINDLESS_INDEX = UINT32_MAX;
+
     virtual ~Material() = default;
 
     virtual void cleanUp() {}
@@ -13,6 +15,12 @@ public:
     virtual void prepareForRender(VkCommandBuffer commandBuffer, ShaderObject* object) {}
 
     virtual void init(ShaderObject* shader) {}
+
+    //The material's index in the BindlessTable's material buffer. Materials that have one must not bind anything in
+    //prepareForRender, so renderables using different ones can be drawn together.
+    virtual uint32_t getBindlessIndex() {
+        return NO_BINDLESS_INDEX;
+    }
 };
 
 #endif //MATERIAL_H
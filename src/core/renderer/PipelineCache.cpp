@@ -0,0 +1,198 @@
+#include "PipelineCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <utility>
+
+#include "VulkanRenderInfo.h"
+#include "XTPVulkan.h"
+
+VkPipelineCache PipelineCache::cache;
+std::vector<std::thread> PipelineCache::workers;
+std::deque<std::function<void()>> PipelineCache::jobs;
+std::mutex PipelineCache::jobMutex;
+std::condition_variable PipelineCache::jobAvailable;
+std::condition_variable PipelineCache::jobsFinished;
+uint32_t PipelineCache::runningJobs;
+bool PipelineCache::stopping;
+std::exception_ptr PipelineCache::compileError;
+
+void PipelineCache::init() {
+    ZoneScopedN("PipelineCache::init");
+    const std::vector<char> data = loadCacheData();
+
+    VkPipelineCacheCreateInfo cacheInfo {};
+    cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    cacheInfo.initialDataSize = data.size();
+    cacheInfo.pInitialData = data.empty() ? nullptr : data.data();
+
+    if (vkCreatePipelineCache(XTPVulkan::device, &cacheInfo, nullptr, &cache) != VK_SUCCESS) {
+        XTPVulkan::logger->logCritical("Failed To Create Pipeline Cache!");
+    }
+
+    stopping = false;
+    runningJobs = 0;
+    const uint32_t threadCount = std::max(1u, VulkanRenderInfo::INSTANCE->getPipelineCompileThreadCount());
+    for (uint32_t i = 0; i < threadCount; ++i) {
+        workers.emplace_back(workerLoop);
+    }
+}
+
+void PipelineCache::cleanUp() {
+    waitIdle();
+    {
+        std::lock_guard lock(jobMutex);
+        stopping = true;
+    }
+    jobAvailable.notify_all();
+    for (std::thread &worker: workers) {
+        worker.join();
+    }
+    workers.clear();
+
+    save();
+    vkDestroyPipelineCache(XTPVulkan::device, cache, nullptr);
+}
+
+void PipelineCache::compile(std::function<void()> &&job) {
+    {
+        std::lock_guard lock(jobMutex);
+        jobs.emplace_back(std::move(job));
+    }
+    jobAvailable.notify_one();
+}
+
+void PipelineCache::waitIdle() {
+    ZoneScopedN("PipelineCache::waitIdle");
+    std::unique_lock lock(jobMutex);
+    jobsFinished.wait(lock, [] { return jobs.empty() && runningJobs == 0; });
+}
+
+void PipelineCache::rethrowCompileErrors() {
+    std::lock_guard lock(jobMutex);
+    if (compileError != nullptr) {
+        std::rethrow_exception(std::exchange(compileError, nullptr));
+    }
+}
+
+void PipelineCache::save() {
+    ZoneScopedN("PipelineCache::save");
+    size_t dataSize = 0;
+    if (vkGetPipelineCacheData(XTPVulkan::device, cache, &dataSize, nullptr) != VK_SUCCESS || dataSize == 0) {
+        return;
+    }
+    std::vector<char> data(dataSize);
+    if (vkGetPipelineCacheData(XTPVulkan::device, cache, &dataSize, data.data()) != VK_SUCCESS) {
+        XTPVulkan::logger->logError("Failed To Get Pipeline Cache Data!", false);
+        return;
+    }
+
+    const std::string path = VulkanRenderInfo::INSTANCE->getPipelineCachePath();
+    //Written next to the real file first, so a crash while saving can't leave a truncated cache behind.
+    const std::string temporaryPath = path + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            XTPVulkan::logger->logError("Failed To Open '{}' To Save The Pipeline Cache!", false, temporaryPath);
+            return;
+        }
+        const FileHeader header = createHeader(dataSize);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(data.data(), static_cast<std::streamsize>(dataSize));
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporaryPath, path, error);
+    if (error) {
+        XTPVulkan::logger->logError("Failed To Save The Pipeline Cache To '{}': {}", false, path, error.message());
+        return;
+    }
+    XTPVulkan::logger->logDebug("Saved {} Bytes Of Pipeline Cache Data", dataSize);
+}
+
+PipelineCache::FileHeader PipelineCache::createHeader(const uint64_t dataSize) {
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(XTPVulkan::gpu, &properties);
+
+    FileHeader header {};
+    header.magic = FILE_MAGIC;
+    header.version = FILE_VERSION;
+    header.vendorID = properties.vendorID;
+    header.deviceID = properties.deviceID;
+    header.driverVersion = properties.driverVersion;
+    memcpy(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE);
+    header.dataSize = dataSize;
+    return header;
+}
+
+std::vector<char> PipelineCache::loadCacheData() {
+    const std::string path = VulkanRenderInfo::INSTANCE->getPipelineCachePath();
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        XTPVulkan::logger->logDebug("No Pipeline Cache Found At '{}'", path);
+        return {};
+    }
+
+    FileHeader header {};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    const FileHeader expected = createHeader(header.dataSize);
+    if (!file || header.magic != expected.magic || header.version != expected.version ||
+        header.vendorID != expected.vendorID || header.deviceID != expected.deviceID ||
+        header.driverVersion != expected.driverVersion ||
+        memcmp(header.pipelineCacheUUID, expected.pipelineCacheUUID, VK_UUID_SIZE) != 0) {
+        XTPVulkan::logger->logInformation(
+            "Ignoring Pipeline Cache At '{}', It Was Written For Another Device Or Driver", path);
+        return {};
+    }
+
+    //dataSize is checked against what the file actually has before anything is allocated for it.
+    std::error_code error;
+    const uintmax_t fileSize = std::filesystem::file_size(path, error);
+    if (error || fileSize < sizeof(header) || header.dataSize > fileSize - sizeof(header)) {
+        XTPVulkan::logger->logWarning("Ignoring Truncated Pipeline Cache At '{}'", path);
+        return {};
+    }
+
+    std::vector<char> data(header.dataSize);
+    file.read(data.data(), static_cast<std::streamsize>(header.dataSize));
+    if (!file) {
+        XTPVulkan::logger->logWarning("Ignoring Truncated Pipeline Cache At '{}'", path);
+        return {};
+    }
+    XTPVulkan::logger->logDebug("Loaded {} Bytes Of Pipeline Cache Data", header.dataSize);
+    return data;
+}
+
+void PipelineCache::workerLoop() {
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock lock(jobMutex);
+            jobAvailable.wait(lock, [] { return stopping || !jobs.empty(); });
+            if (jobs.empty()) {
+                return;
+            }
+            job = std::move(jobs.front());
+            jobs.pop_front();
+            runningJobs++;
+        }
+
+        std::exception_ptr error = nullptr;
+        try {
+            job();
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        {
+            std::lock_guard lock(jobMutex);
+            if (error != nullptr && compileError == nullptr) {
+                compileError = error;
+            }
+            runningJobs--;
+        }
+        jobsFinished.notify_all();
+    }
+}
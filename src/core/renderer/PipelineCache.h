@@ -0,0 +1,70 @@
+#ifndef PIPELINECACHE_H
+#define PIPELINECACHE_H
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+//Owns the VkPipelineCache every pipeline is created with, and the threads pipelines are compiled on. The cache is saved
+//to VulkanRenderInfo::getPipelineCachePath() on clean up, and only loaded again if it was written for the same device
+//and driver version, since drivers are free to reject (or worse, misread) data from another driver.
+class PipelineCache {
+public:
+    static VkPipelineCache cache;
+
+    static void init();
+
+    //Saves the cache and destroys it. Waits for pending compiles first.
+    static void cleanUp();
+
+    //Runs the job on a compile thread. The job must be safe to run concurrently with other compile jobs, which
+    //vkCreateGraphicsPipelines is, since the cache is internally synchronized.
+    static void compile(std::function<void()> &&job);
+
+    static void waitIdle();
+
+    //Rethrows the first exception thrown by a compile job, on the calling thread.
+    static void rethrowCompileErrors();
+
+    static void save();
+
+private:
+    //Written in front of the data returned by vkGetPipelineCacheData.
+    struct FileHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t vendorID;
+        uint32_t deviceID;
+        uint32_t driverVersion;
+        uint8_t pipelineCacheUUID[VK_UUID_SIZE];
+        uint64_t dataSize;
+    };
+
+    static constexpr uint32_t FILE_MAGIC = 0x43505458; //"XTPC"
+    static constexpr uint32_t FILE_VERSION = 1;
+
+    static std::vector<std::thread> workers;
+    static std::deque<std::function<void()>> jobs;
+    static std::mutex jobMutex;
+    static std::condition_variable jobAvailable;
+    static std::condition_variable jobsFinished;
+    static uint32_t runningJobs;
+    static bool stopping;
+    static std::exception_ptr compileError;
+
+    static FileHeader createHeader(uint64_t dataSize);
+
+    static std::vector<char> loadCacheData();
+
+    static void workerLoop();
+};
+
+
+
+#endif //PIPELINECACHE_H
@@ -0,0 +1,85 @@
+#include "ProfilerPanel.h"
+
+#ifdef XTP_USE_IMGUI_UI
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "imgui.h"
+#include "Profiler.h"
+
+std::string ProfilerPanel::csvPath = "xtp-profile.csv";
+std::string ProfilerPanel::chromeTracePath = "xtp-profile.json";
+std::string ProfilerPanel::exportStatus;
+ProfileFrameSummary ProfilerPanel::summary;
+
+void ProfilerPanel::draw() {
+    ImGui::Begin("Profiler");
+
+    bool enabled = Profiler::isEnabled();
+    if (ImGui::Checkbox("Record", &enabled)) {
+        Profiler::setEnabled(enabled);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Export CSV")) {
+        exportStatus = Profiler::exportCsv(csvPath) ? "Exported To " + csvPath : "Failed To Write " + csvPath;
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Export Chrome Trace")) {
+        exportStatus = Profiler::exportChromeTrace(chromeTracePath) ? "Exported To " + chromeTracePath :
+                           "Failed To Write " + chromeTracePath;
+    }
+    if (!exportStatus.empty()) {
+        ImGui::TextUnformatted(exportStatus.c_str());
+    }
+
+    //Only the shown frame is copied, the averages are kept up to date by the Profiler.
+    if (!Profiler::summarizeLatestFrame(summary)) {
+        ImGui::TextUnformatted("No Frames Recorded");
+        ImGui::End();
+        return;
+    }
+    const std::vector<std::string> threadNames = Profiler::getThreadNames();
+
+    const ProfileFrame &frame = summary.frame;
+    ImGui::Text("Frame %llu: %.3f ms, %.3f ms Average Over %zu Frames", static_cast<unsigned long long>(frame.number),
+                static_cast<double>(frame.endNanos - frame.startNanos) / 1000000.0,
+                static_cast<double>(summary.totalFrameNanos) / 1000000.0 / static_cast<double>(summary.frameCount),
+                summary.frameCount);
+
+    //Sorted so each zone comes right after the zone it is nested in.
+    std::vector<std::pair<ProfileZoneRecord, ProfileZoneTotal>> zones;
+    zones.reserve(summary.zoneTotals.size());
+    size_t totalIndex = 0;
+    for (const std::vector<ProfileZoneRecord>* frameZones: {&frame.cpuZones, &frame.gpuZones}) {
+        for (const ProfileZoneRecord &zone: *frameZones) {
+            zones.emplace_back(zone, summary.zoneTotals[totalIndex++]);
+        }
+    }
+    std::stable_sort(zones.begin(), zones.end(), [](const auto &a, const auto &b) {
+        return a.first.thread != b.first.thread ? a.first.thread < b.first.thread :
+                   a.first.startNanos < b.first.startNanos;
+    });
+
+    if (ImGui::BeginTable("Zones", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_ScrollY)) {
+        ImGui::TableSetupColumn("Thread");
+        ImGui::TableSetupColumn("Zone");
+        ImGui::TableSetupColumn("ms");
+        ImGui::TableSetupColumn("Average ms");
+        ImGui::TableHeadersRow();
+        for (const auto &[zone, total]: zones) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(zone.thread == Profiler::GPU_THREAD ? "GPU" : threadNames[zone.thread].c_str());
+            ImGui::TableNextColumn();
+            ImGui::Text("%*s%s", static_cast<int>(zone.depth * 2), "", zone.name);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", static_cast<double>(zone.endNanos - zone.startNanos) / 1000000.0);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", static_cast<double>(total.nanos) / 1000000.0 / static_cast<double>(total.count));
+        }
+        ImGui::EndTable();
+    }
+    ImGui::End();
+}
+#endif
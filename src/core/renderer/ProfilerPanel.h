@@ -0,0 +1,27 @@
+#ifndef PROFILERPANEL_H
+#define PROFILERPANEL_H
+
+#ifdef XTP_USE_IMGUI_UI
+#include <string>
+
+#include "Profiler.h"
+
+//An ImGui window showing the Profiler's zones for a recent frame next to their averages over every kept frame, with
+//buttons to toggle recording and export what was recorded. Call draw() from a RenderDebugUIEvent.
+class ProfilerPanel {
+public:
+    static std::string csvPath;
+    static std::string chromeTracePath;
+
+    static void draw();
+
+private:
+    static std::string exportStatus;
+    //Reused every draw, so the shown frame's zones don't need new allocations.
+    static ProfileFrameSummary summary;
+};
+#endif
+
+
+
+#endif //PROFILERPANEL_H
@@ -0,0 +1,581 @@
+#include "UploadManager.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "AllocatedImage.h"
+#include "XTPVulkan.h"
+
+std::mutex UploadManager::mutex;
+VkSemaphore UploadManager::timeline;
+uint64_t UploadManager::nextTimelineValue;
+AllocatedBuffer UploadManager::stagingRing;
+VkDeviceSize UploadManager::ringSize;
+VkDeviceSize UploadManager::ringHead;
+VkDeviceSize UploadManager::ringUsed;
+VkDeviceSize UploadManager::copyAlignment;
+bool UploadManager::dedicatedQueue;
+UploadManager::UploadBatch UploadManager::currentBatch;
+std::deque<UploadManager::UploadBatch> UploadManager::submittedBatches;
+std::vector<UploadManager::UploadBatch> UploadManager::freeBatches;
+
+//The stages and accesses that may read uploaded data on the graphics queue.
+static constexpr VkPipelineStageFlags UPLOAD_CONSUMER_STAGES = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT |
+                                                               VK_PIPELINE_STAGE_VERTEX_INPUT_BIT |
+                                                               VK_PIPELINE_STAGE_VERTEX_SHADER_BIT |
+                                                               VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT |
+                                                               VK_PIPELINE_STAGE_TRANSFER_BIT;
+static constexpr VkAccessFlags UPLOAD_CONSUMER_ACCESS = VK_ACCESS_INDIRECT_COMMAND_READ_BIT |
+                                                        VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT |
+                                                        VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_UNIFORM_READ_BIT |
+                                                        VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT;
+
+bool UploadHandle::isComplete() const {
+    return UploadManager::getCompletedValue() >= value;
+}
+
+void UploadHandle::wait() const {
+    if (isComplete()) {
+        return;
+    }
+    UploadManager::flush();
+
+    VkSemaphoreWaitInfo waitInfo {};
+    waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores = &UploadManager::timeline;
+    waitInfo.pValues = &value;
+    vkWaitSemaphores(XTPVulkan::device, &waitInfo, UINT64_MAX);
+}
+
+void UploadManager::init() {
+    ZoneScopedN("UploadManager::init");
+    dedicatedQueue = XTPVulkan::queueIndices.transferFamily.has_value();
+
+    VkSemaphoreTypeCreateInfo typeInfo {};
+    typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+    typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    typeInfo.initialValue = 0;
+
+    VkSemaphoreCreateInfo semaphoreInfo {};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphoreInfo.pNext = &typeInfo;
+
+    if (vkCreateSemaphore(XTPVulkan::device, &semaphoreInfo, nullptr, &timeline) != VK_SUCCESS) {
+        XTPVulkan::logger->logCritical("Failed To Create Upload Timeline Semaphore!");
+    }
+    //Each batch uses two values, one for the transfer submit and one for the graphics submit.
+    nextTimelineValue = 2;
+
+    ringSize = VulkanRenderInfo::INSTANCE->getStagingBufferSize();
+    ringHead = 0;
+    ringUsed = 0;
+    stagingRing = XTPVulkan::createSimpleBuffer(ringSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_ONLY, false);
+
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(XTPVulkan::gpu, &properties);
+    //16 bytes covers the texel size of every uncompressed and block compressed format.
+    copyAlignment = std::max<VkDeviceSize>(16, properties.limits.optimalBufferCopyOffsetAlignment);
+
+    currentBatch = createBatch();
+
+    if (dedicatedQueue) {
+        XTPVulkan::logger->logInformation("Uploading On Dedicated Transfer Queue Family #{}",
+                                          XTPVulkan::queueIndices.transferFamily.value());
+    }
+}
+
+void UploadManager::cleanUp() {
+    vkDeviceWaitIdle(XTPVulkan::device);
+    reclaimCompletedBatches();
+
+    auto destroyBatch = [](UploadBatch &batch) {
+        vkDestroyCommandPool(XTPVulkan::device, batch.transferCommandPool, nullptr);
+        if (batch.graphicsCommandPool != batch.transferCommandPool) {
+            vkDestroyCommandPool(XTPVulkan::device, batch.graphicsCommandPool, nullptr);
+        }
+        for (AllocatedBuffer &buffer: batch.temporaryBuffers) {
+            XTPVulkan::destroyAllocatedBuffer(&buffer);
+        }
+    };
+    destroyBatch(currentBatch);
+    for (UploadBatch &batch: freeBatches) {
+        destroyBatch(batch);
+    }
+    freeBatches.clear();
+
+    XTPVulkan::destroyAllocatedBuffer(&stagingRing);
+    vkDestroySemaphore(XTPVulkan::device, timeline, nullptr);
+}
+
+UploadHandle UploadManager::uploadBuffer(const void *data, const VkDeviceSize size, const AllocatedBuffer &destination,
+                                         const VkDeviceSize destinationOffset) {
+    ZoneScopedN("UploadManager::uploadBuffer");
+    std::lock_guard lock(mutex);
+    if (size == 0) {
+        return {0};
+    }
+
+    VkBuffer stagingBuffer;
+    const VkDeviceSize stagingOffset = stage(data, size, stagingBuffer);
+    beginBatch();
+
+    const VkBufferCopy copy {stagingOffset, destinationOffset, size};
+    vkCmdCopyBuffer(currentBatch.transferCommandBuffer, stagingBuffer, destination.internalBuffer, 1, &copy);
+    releaseToGraphics(destination.internalBuffer, destinationOffset, size);
+
+    return {currentBatch.timelineValue};
+}
+
+UploadHandle UploadManager::uploadImage(const void *data, const VkDeviceSize size, const AllocatedImage &image,
+                                        const uint32_t width, const uint32_t height) {
+    ZoneScopedN("UploadManager::uploadImage");
+    std::lock_guard lock(mutex);
+
+    VkBuffer stagingBuffer;
+    const VkDeviceSize stagingOffset = stage(data, size, stagingBuffer);
+    beginBatch();
+
+    const uint32_t levelCount = std::max(image.mipLevels, 1u);
+
+    VkImageMemoryBarrier barrier {};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image.image;
+    barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, levelCount, 0, 1};
+    barrier.srcAccessMask = 0;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    vkCmdPipelineBarrier(currentBatch.transferCommandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+    VkBufferImageCopy region {};
+    region.bufferOffset = stagingOffset;
+    region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+    region.imageExtent = {width, height, 1};
+    vkCmdCopyBufferToImage(currentBatch.transferCommandBuffer, stagingBuffer, image.image,
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+    if (levelCount == 1) {
+        releaseImageToGraphics(image.image, 1, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                               VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+    } else {
+        //Blits need a graphics queue, so the rest of the levels are generated after the ownership transfer.
+        releaseImageToGraphics(image.image, levelCount, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                               VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT);
+        generateMipmaps(image.image, width, height, levelCount);
+    }
+
+    return {currentBatch.timelineValue};
+}
+
+UploadHandle UploadManager::uploadImageLevels(const void *data, const VkDeviceSize size, const AllocatedImage &image,
+                                              const uint32_t width, const uint32_t height,
+                                              const std::vector<VkDeviceSize> &levelOffsets) {
+    ZoneScopedN("UploadManager::uploadImageLevels");
+    std::lock_guard lock(mutex);
+
+    VkBuffer stagingBuffer;
+    const VkDeviceSize stagingOffset = stage(data, size, stagingBuffer);
+    beginBatch();
+
+    const auto levelCount = static_cast<uint32_t>(levelOffsets.size());
+
+    VkImageMemoryBarrier barrier {};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image.image;
+    barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, levelCount, 0, 1};
+    barrier.srcAccessMask = 0;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    vkCmdPipelineBarrier(currentBatch.transferCommandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+    std::vector<VkBufferImageCopy> regions(levelCount);
+    for (uint32_t level = 0; level < levelCount; ++level) {
+        regions[level].bufferOffset = stagingOffset + levelOffsets[level];
+        regions[level].imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level, 0, 1};
+        regions[level].imageExtent = {std::max(width >> level, 1u), std::max(height >> level, 1u), 1};
+    }
+    vkCmdCopyBufferToImage(currentBatch.transferCommandBuffer, stagingBuffer, image.image,
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, levelCount, regions.data());
+
+    releaseImageToGraphics(image.image, levelCount, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                           VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+
+    return {currentBatch.timelineValue};
+}
+
+UploadHandle UploadManager::copyBuffer(const AllocatedBuffer &source, const AllocatedBuffer &destination,
+                                       const VkDeviceSize size, const VkDeviceSize sourceOffset,
+                                       const VkDeviceSize destinationOffset) {
+    ZoneScopedN("UploadManager::copyBuffer");
+    std::lock_guard lock(mutex);
+    beginBatch();
+
+    const VkCommandBuffer commandBuffer = currentBatch.graphicsCommandBuffer;
+
+    //Makes sure uploads into the source buffer earlier in the batch have landed.
+    VkMemoryBarrier barrier {};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier,
+                         0, nullptr, 0, nullptr);
+
+    const VkBufferCopy copy {sourceOffset, destinationOffset, size};
+    vkCmdCopyBuffer(commandBuffer, source.internalBuffer, destination.internalBuffer, 1, &copy);
+
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = UPLOAD_CONSUMER_ACCESS;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, UPLOAD_CONSUMER_STAGES, 0, 1, &barrier, 0,
+                         nullptr, 0, nullptr);
+
+    return {currentBatch.timelineValue};
+}
+
+void UploadManager::flush() {
+    ZoneScopedN("UploadManager::flush");
+    std::lock_guard lock(mutex);
+    reclaimCompletedBatches();
+    if (currentBatch.recording) {
+        submitBatch();
+    }
+}
+
+void UploadManager::waitIdle() {
+    flush();
+    const UploadHandle handle {nextTimelineValue - 2};
+    handle.wait();
+    std::lock_guard lock(mutex);
+    reclaimCompletedBatches();
+}
+
+uint64_t UploadManager::getCompletedValue() {
+    uint64_t value;
+    vkGetSemaphoreCounterValue(XTPVulkan::device, timeline, &value);
+    return value;
+}
+
+bool UploadManager::usesDedicatedTransferQueue() {
+    return dedicatedQueue;
+}
+
+UploadManager::UploadBatch UploadManager::createBatch() {
+    UploadBatch batch {};
+
+    auto createPool = [](const uint32_t queueFamily) {
+        VkCommandPoolCreateInfo poolInfo {};
+        poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        poolInfo.queueFamilyIndex = queueFamily;
+
+        VkCommandPool pool;
+        if (vkCreateCommandPool(XTPVulkan::device, &poolInfo, nullptr, &pool) != VK_SUCCESS) {
+            XTPVulkan::logger->logCritical("Failed To Create Upload Command Pool!");
+        }
+        return pool;
+    };
+
+    auto allocateCommandBuffer = [](const VkCommandPool pool) {
+        VkCommandBufferAllocateInfo allocInfo {};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.commandPool = pool;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocInfo.commandBufferCount = 1;
+
+        VkCommandBuffer commandBuffer;
+        if (vkAllocateCommandBuffers(XTPVulkan::device, &allocInfo, &commandBuffer) != VK_SUCCESS) {
+            XTPVulkan::logger->logCritical("Failed To Allocate Upload Command Buffer!");
+        }
+        return commandBuffer;
+    };
+
+    const uint32_t graphicsFamily = XTPVulkan::queueIndices.graphicsFamily.value();
+    batch.transferCommandPool = createPool(dedicatedQueue ? XTPVulkan::queueIndices.transferFamily.value() : graphicsFamily);
+    batch.transferCommandBuffer = allocateCommandBuffer(batch.transferCommandPool);
+    if (dedicatedQueue) {
+        batch.graphicsCommandPool = createPool(graphicsFamily);
+        batch.graphicsCommandBuffer = allocateCommandBuffer(batch.graphicsCommandPool);
+    } else {
+        batch.graphicsCommandPool = batch.transferCommandPool;
+        batch.graphicsCommandBuffer = batch.transferCommandBuffer;
+    }
+    return batch;
+}
+
+void UploadManager::beginBatch() {
+    if (currentBatch.recording) {
+        return;
+    }
+
+    VkCommandBufferBeginInfo beginInfo {};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    vkBeginCommandBuffer(currentBatch.transferCommandBuffer, &beginInfo);
+    if (dedicatedQueue) {
+        vkBeginCommandBuffer(currentBatch.graphicsCommandBuffer, &beginInfo);
+    }
+    currentBatch.timelineValue = nextTimelineValue;
+    nextTimelineValue += 2;
+    currentBatch.recording = true;
+}
+
+void UploadManager::submitBatch() {
+    ZoneScopedN("UploadManager::submitBatch");
+    vkEndCommandBuffer(currentBatch.transferCommandBuffer);
+
+    const uint64_t transferValue = currentBatch.timelineValue - 1;
+    const uint64_t graphicsValue = currentBatch.timelineValue;
+
+    VkTimelineSemaphoreSubmitInfo transferTimelineInfo {};
+    transferTimelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+    transferTimelineInfo.signalSemaphoreValueCount = 1;
+    transferTimelineInfo.pSignalSemaphoreValues = dedicatedQueue ? &transferValue : &graphicsValue;
+
+    VkSubmitInfo transferSubmit {};
+    transferSubmit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    transferSubmit.pNext = &transferTimelineInfo;
+    transferSubmit.commandBufferCount = 1;
+    transferSubmit.pCommandBuffers = &currentBatch.transferCommandBuffer;
+    transferSubmit.signalSemaphoreCount = 1;
+    transferSubmit.pSignalSemaphores = &timeline;
+
+    //Uploading threads can get here through stage() or UploadHandle::wait() while the render thread submits a frame.
+    std::lock_guard queueLock(XTPVulkan::queueMutex);
+    if (vkQueueSubmit(dedicatedQueue ? XTPVulkan::transferQueue : XTPVulkan::graphicsQueue, 1, &transferSubmit,
+                      VK_NULL_HANDLE) != VK_SUCCESS) {
+        XTPVulkan::logger->logCritical("Failed To Submit Uploads!");
+    }
+
+    if (dedicatedQueue) {
+        //The acquires are submitted to the graphics queue ahead of the frame's draw commands, so the draws are ordered
+        //after them without having to wait on the semaphore themselves.
+        vkEndCommandBuffer(currentBatch.graphicsCommandBuffer);
+
+        constexpr VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+        VkTimelineSemaphoreSubmitInfo graphicsTimelineInfo {};
+        graphicsTimelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+        graphicsTimelineInfo.waitSemaphoreValueCount = 1;
+        graphicsTimelineInfo.pWaitSemaphoreValues = &transferValue;
+        graphicsTimelineInfo.signalSemaphoreValueCount = 1;
+        graphicsTimelineInfo.pSignalSemaphoreValues = &graphicsValue;
+
+        VkSubmitInfo graphicsSubmit {};
+        graphicsSubmit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        graphicsSubmit.pNext = &graphicsTimelineInfo;
+        graphicsSubmit.waitSemaphoreCount = 1;
+        graphicsSubmit.pWaitSemaphores = &timeline;
+        graphicsSubmit.pWaitDstStageMask = &waitStage;
+        graphicsSubmit.commandBufferCount = 1;
+        graphicsSubmit.pCommandBuffers = &currentBatch.graphicsCommandBuffer;
+        graphicsSubmit.signalSemaphoreCount = 1;
+        graphicsSubmit.pSignalSemaphores = &timeline;
+
+        if (vkQueueSubmit(XTPVulkan::graphicsQueue, 1, &graphicsSubmit, VK_NULL_HANDLE) != VK_SUCCESS) {
+            XTPVulkan::logger->logCritical("Failed To Submit Upload Ownership Transfers!");
+        }
+    }
+
+    currentBatch.recording = false;
+    submittedBatches.emplace_back(std::move(currentBatch));
+
+    if (freeBatches.empty()) {
+        currentBatch = createBatch();
+    } else {
+        currentBatch = std::move(freeBatches.back());
+        freeBatches.pop_back();
+    }
+}
+
+void UploadManager::reclaimCompletedBatches() {
+    const uint64_t completed = getCompletedValue();
+    while (!submittedBatches.empty() && submittedBatches.front().timelineValue <= completed) {
+        UploadBatch batch = std::move(submittedBatches.front());
+        submittedBatches.pop_front();
+
+        //Batches complete in order, so the oldest staging bytes are always the first ones freed.
+        ringUsed -= batch.ringBytes;
+        batch.ringBytes = 0;
+        for (AllocatedBuffer &buffer: batch.temporaryBuffers) {
+            XTPVulkan::destroyAllocatedBuffer(&buffer);
+        }
+        batch.temporaryBuffers.clear();
+
+        vkResetCommandPool(XTPVulkan::device, batch.transferCommandPool, 0);
+        if (dedicatedQueue) {
+            vkResetCommandPool(XTPVulkan::device, batch.graphicsCommandPool, 0);
+        }
+        freeBatches.emplace_back(std::move(batch));
+    }
+    if (ringUsed == 0) {
+        ringHead = 0;
+    }
+}
+
+VkDeviceSize UploadManager::stage(const void *data, const VkDeviceSize size, VkBuffer &stagingBuffer) {
+    //Uploads that could never fit into the ring get a staging buffer of their own, freed once the batch completes.
+    if (size > ringSize) {
+        AllocatedBuffer temporary = XTPVulkan::createSimpleBuffer(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                                                  VMA_MEMORY_USAGE_CPU_ONLY, false);
+        memcpy(temporary.info.pMappedData, data, size);
+        currentBatch.temporaryBuffers.emplace_back(temporary);
+        stagingBuffer = temporary.internalBuffer;
+        return 0;
+    }
+
+    while (true) {
+        VkDeviceSize offset = (ringHead + copyAlignment - 1) / copyAlignment * copyAlignment;
+        VkDeviceSize consumed = offset - ringHead + size;
+        //Allocations never wrap around the end of the ring, the bytes left at the end are skipped instead.
+        if (offset + size > ringSize) {
+            offset = 0;
+            consumed = ringSize - ringHead + size;
+        }
+
+        if (ringUsed + consumed <= ringSize) {
+            ringHead = offset + size;
+            ringUsed += consumed;
+            currentBatch.ringBytes += consumed;
+
+            memcpy(static_cast<char*>(stagingRing.info.pMappedData) + offset, data, size);
+            stagingBuffer = stagingRing.internalBuffer;
+            return offset;
+        }
+
+        //The ring is full, so submit what has been recorded so far and wait for the oldest batch to free its bytes.
+        ZoneScopedN("UploadManager::stage#waitForSpace");
+        if (currentBatch.recording) {
+            submitBatch();
+        }
+        if (submittedBatches.empty()) {
+            XTPVulkan::logger->logCritical("Upload Staging Ring Is Full Without Any Pending Uploads!");
+        }
+        const uint64_t value = submittedBatches.front().timelineValue;
+        VkSemaphoreWaitInfo waitInfo {};
+        waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores = &timeline;
+        waitInfo.pValues = &value;
+        vkWaitSemaphores(XTPVulkan::device, &waitInfo, UINT64_MAX);
+        reclaimCompletedBatches();
+    }
+}
+
+void UploadManager::releaseToGraphics(VkBuffer buffer, const VkDeviceSize offset, const VkDeviceSize size) {
+    VkBufferMemoryBarrier barrier {};
+    barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    barrier.buffer = buffer;
+    barrier.offset = offset;
+    barrier.size = size;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+    if (dedicatedQueue) {
+        barrier.srcQueueFamilyIndex = XTPVulkan::queueIndices.transferFamily.value();
+        barrier.dstQueueFamilyIndex = XTPVulkan::queueIndices.graphicsFamily.value();
+        barrier.dstAccessMask = 0;
+        vkCmdPipelineBarrier(currentBatch.transferCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = UPLOAD_CONSUMER_ACCESS;
+        vkCmdPipelineBarrier(currentBatch.graphicsCommandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                             UPLOAD_CONSUMER_STAGES, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+    } else {
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstAccessMask = UPLOAD_CONSUMER_ACCESS;
+        vkCmdPipelineBarrier(currentBatch.transferCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             UPLOAD_CONSUMER_STAGES, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+    }
+}
+
+void UploadManager::releaseImageToGraphics(VkImage image, const uint32_t levelCount, const VkImageLayout newLayout,
+                                           const VkPipelineStageFlags dstStage, const VkAccessFlags dstAccess) {
+    VkImageMemoryBarrier barrier {};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout = newLayout;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image;
+    barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, levelCount, 0, 1};
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    if (dedicatedQueue) {
+        //The release and the acquire have to describe the same layout transition.
+        barrier.srcQueueFamilyIndex = XTPVulkan::queueIndices.transferFamily.value();
+        barrier.dstQueueFamilyIndex = XTPVulkan::queueIndices.graphicsFamily.value();
+        barrier.dstAccessMask = 0;
+        vkCmdPipelineBarrier(currentBatch.transferCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = dstAccess;
+        vkCmdPipelineBarrier(currentBatch.graphicsCommandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, dstStage, 0, 0,
+                             nullptr, 0, nullptr, 1, &barrier);
+    } else {
+        barrier.dstAccessMask = dstAccess;
+        vkCmdPipelineBarrier(currentBatch.transferCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, dstStage, 0, 0,
+                             nullptr, 0, nullptr, 1, &barrier);
+    }
+}
+
+void UploadManager::generateMipmaps(VkImage image, const uint32_t width, const uint32_t height,
+                                    const uint32_t levelCount) {
+    const VkCommandBuffer commandBuffer = currentBatch.graphicsCommandBuffer;
+
+    VkImageMemoryBarrier barrier {};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image;
+    barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+
+    auto levelWidth = static_cast<int32_t>(width);
+    auto levelHeight = static_cast<int32_t>(height);
+    for (uint32_t level = 1; level < levelCount; ++level) {
+        //Each level is blitted from the one before it, which is done being written to by then.
+        barrier.subresourceRange.baseMipLevel = level - 1;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0,
+                             nullptr, 0, nullptr, 1, &barrier);
+
+        const int32_t nextWidth = std::max(levelWidth / 2, 1);
+        const int32_t nextHeight = std::max(levelHeight / 2, 1);
+
+        VkImageBlit blit {};
+        blit.srcOffsets[1] = {levelWidth, levelHeight, 1};
+        blit.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level - 1, 0, 1};
+        blit.dstOffsets[1] = {nextWidth, nextHeight, 1};
+        blit.dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level, 0, 1};
+        vkCmdBlitImage(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image,
+                       VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit, VK_FILTER_LINEAR);
+
+        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0,
+                             nullptr, 0, nullptr, 1, &barrier);
+
+        levelWidth = nextWidth;
+        levelHeight = nextHeight;
+    }
+
+    barrier.subresourceRange.baseMipLevel = levelCount - 1;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0,
+                         nullptr, 0, nullptr, 1, &barrier);
+}
@@ -0,0 +1,117 @@
+#ifndef UPLOADMANAGER_H
+#define UPLOADMANAGER_H
+
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include "buffer/AllocatedBuffer.h"
+
+struct AllocatedImage;
+
+//Refers to the batch an upload was recorded into. The upload is visible to any graphics work submitted after the batch,
+//which always happens before the next frame is submitted.
+struct UploadHandle {
+    uint64_t value = 0;
+
+    [[nodiscard]] bool isComplete() const;
+
+    //Submits the batch if it hasn't been yet.
+    void wait() const;
+};
+
+//Uploads data to device local buffers and images without stalling the render loop. Data is copied into a persistent ring
+//staging buffer, and all uploads recorded during a frame are submitted together right before the frame's draw commands.
+//If the device has a dedicated transfer queue family the copies run on it, and ownership of the written ranges is then
+//transferred to the graphics queue family. Completion is tracked with a timeline semaphore.
+//
+//Every function can be called from any thread. None of them wait for the upload to happen, use the returned handle for
+//that. A batch can also be submitted early when the ring is full or a handle is waited on, so submits hold
+//XTPVulkan::queueMutex.
+class UploadManager {
+public:
+    static void init();
+
+    static void cleanUp();
+
+    static UploadHandle uploadBuffer(const void* data, VkDeviceSize size, const AllocatedBuffer &destination,
+                                     VkDeviceSize destinationOffset = 0);
+
+    //Uploads the image's first mip level and generates the rest of them by blitting, so the image's format has to
+    //support linear filtering, blit source and blit destination if it has more than one. The image is transitioned to
+    //VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL.
+    static UploadHandle uploadImage(const void* data, VkDeviceSize size, const AllocatedImage &image, uint32_t width,
+                                    uint32_t height);
+
+    //Uploads every mip level of the image in a single copy, levelOffsets being where each level starts in data. Used for
+    //block compressed images, which can't be blitted into.
+    static UploadHandle uploadImageLevels(const void* data, VkDeviceSize size, const AllocatedImage &image,
+                                          uint32_t width, uint32_t height, const std::vector<VkDeviceSize> &levelOffsets);
+
+    //Copies between two device buffers on the graphics queue, after all uploads of the same batch. Like the uploads, it
+    //has only happened once the returned handle is complete.
+    static UploadHandle copyBuffer(const AllocatedBuffer &source, const AllocatedBuffer &destination, VkDeviceSize size,
+                                   VkDeviceSize sourceOffset = 0, VkDeviceSize destinationOffset = 0);
+
+    //Submits everything recorded since the last flush. The render thread calls this right before submitting a frame.
+    static void flush();
+
+    //Submits everything recorded so far and waits for all of it to finish.
+    static void waitIdle();
+
+    [[nodiscard]] static uint64_t getCompletedValue();
+
+    [[nodiscard]] static bool usesDedicatedTransferQueue();
+
+private:
+    friend struct UploadHandle;
+
+    struct UploadBatch {
+        VkCommandPool transferCommandPool;
+        VkCommandBuffer transferCommandBuffer;
+        //Only separate from the transfer command buffer if there is a dedicated transfer queue. Holds the ownership
+        //acquires and the device to device copies.
+        VkCommandPool graphicsCommandPool;
+        VkCommandBuffer graphicsCommandBuffer;
+        uint64_t timelineValue;
+        VkDeviceSize ringBytes;
+        std::vector<AllocatedBuffer> temporaryBuffers;
+        bool recording;
+    };
+
+    static std::mutex mutex;
+    static VkSemaphore timeline;
+    static uint64_t nextTimelineValue;
+    static AllocatedBuffer stagingRing;
+    static VkDeviceSize ringSize;
+    static VkDeviceSize ringHead;
+    static VkDeviceSize ringUsed;
+    static VkDeviceSize copyAlignment;
+    static bool dedicatedQueue;
+    static UploadBatch currentBatch;
+    static std::deque<UploadBatch> submittedBatches;
+    static std::vector<UploadBatch> freeBatches;
+
+    static UploadBatch createBatch();
+
+    static void beginBatch();
+
+    static void submitBatch();
+
+    static void reclaimCompletedBatches();
+
+    static VkDeviceSize stage(const void* data, VkDeviceSize size, VkBuffer &stagingBuffer);
+
+    static void releaseToGraphics(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize size);
+
+    //Transitions the first levelCount mip levels of an image written on the transfer command buffer to newLayout, and
+    //makes them visible to dstAccess on the graphics command buffer.
+    static void releaseImageToGraphics(VkImage image, uint32_t levelCount, VkImageLayout newLayout,
+                                       VkPipelineStageFlags dstStage, VkAccessFlags dstAccess);
+
+    static void generateMipmaps(VkImage image, uint32_t width, uint32_t height, uint32_t levelCount);
+};
+
+
+
+#endif //UPLOADMANAGER_H
@@ -1,6 +1,9 @@
 
 #ifndef VULKANRENDERDATA_H
 #define VULKANRENDERDATA_H
+#include <algorithm>
+#include <string>
+#include <thread>
 #include <vector>
 #include <vulkan/vulkan_core.h>
 
@@ -27,7 +30,8 @@ public:
     }
 
     virtual std::vector<std::string> getRequiredDeviceExtensions() {
-        return {"VK_KHR_dynamic_rendering", "VK_KHR_buffer_device_address", "VK_KHR_shader_non_semantic_info"};
+        return {"VK_KHR_dynamic_rendering", "VK_KHR_synchronization2", "VK_KHR_buffer_device_address",
+                "VK_KHR_shader_non_semantic_info"};
     }
 
     virtual uint32_t getTickRateMilis() {
@@ -97,6 +101,134 @@ public:
         return 2;
     }
 
+    //If this is greater than 1, draws are split into this many chunks which are recorded into secondary command buffers in
+    //parallel on the JobSystem. Otherwise, everything is recorded into the primary command buffer on the render thread.
+    virtual uint32_t getRecordingThreadCount() {
+        return 1;
+    }
+
+    //Writes log lines on a background thread instead of the thread logging them. Lines below WARNING are dropped if more
+    //than getLogQueueCapacity() of them are waiting to be written.
+    virtual bool useDeferredLogging() {
+        return true;
+    }
+
+    virtual size_t getLogQueueCapacity() {
+        return 8192;
+    }
+
+    //How many worker threads the JobSystem starts. The thread waiting on a batch of jobs works on it as well, so this
+    //leaves one core for it by default.
+    virtual uint32_t getJobWorkerCount() {
+        return std::max(std::thread::hardware_concurrency(), 2u) - 1;
+    }
+
+    //Whether the Profiler starts out recording. It can be toggled at any time with Profiler::setEnabled().
+    virtual bool useProfiler() {
+        return false;
+    }
+
+    //How many of the most recent frames the Profiler keeps.
+    virtual size_t getProfilerFrameCount() {
+        return 300;
+    }
+
+    //How many GPU zones a frame can have, which sizes the GpuProfiler's query pool.
+    virtual uint32_t getMaxGpuProfileZones() {
+        return 64;
+    }
+
+    //Queries vertex, clipping and fragment counts for every pass if the device supports pipeline statistics queries.
+    virtual bool usePipelineStatistics() {
+        return true;
+    }
+
+    //How many passes a frame can have pipeline statistics for, which sizes GpuStatistics' query pool.
+    virtual uint32_t getMaxPipelineStatisticsPasses() {
+        return 32;
+    }
+
+    //The fraction of a heap's budget its usage can reach before MemoryBudgetEvent is called.
+    virtual double getMemoryBudgetThreshold() {
+        return 0.9;
+    }
+
+    //How many frames apart the allocator's detailed statistics are calculated, since that walks every allocation.
+    virtual uint32_t getMemoryStatisticsInterval() {
+        return 60;
+    }
+
+    //The size in bytes the mesh pool's vertex and index buffers start out with. Both grow when they run out of space.
+    virtual VkDeviceSize getInitialMeshPoolSize() {
+        return 16 * 1024 * 1024;
+    }
+
+    //The size of the ring buffer uploads are staged in. Larger uploads get a staging buffer of their own.
+    virtual VkDeviceSize getStagingBufferSize() {
+        return 64 * 1024 * 1024;
+    }
+
+    //The initial size of each frame's transient buffer. It grows if a frame allocates more than this.
+    virtual VkDeviceSize getTransientBufferSize() {
+        return 16 * 1024 * 1024;
+    }
+
+    //Skips drawing renderables whose bounds are entirely outside the view frustum.
+    virtual bool useFrustumCulling() {
+        return true;
+    }
+
+    //Draws SimpleIndexBufferedRenderables between their last two ticks, by Ticker::getInterpolationAlpha(), instead of
+    //at the last one. Smooths out movement when frames are drawn faster than ticks run, but shows it a tick later.
+    virtual bool interpolateTickState() {
+        return true;
+    }
+
+    //Draws with VK_KHR_dynamic_rendering instead of a VkRenderPass and framebuffers.
+    virtual bool useDynamicRendering() {
+        return true;
+    }
+
+    //Where the pipeline cache is loaded from on start up and saved to on clean up.
+    virtual std::string getPipelineCachePath() {
+        return "pipeline_cache.bin";
+    }
+
+    //How many threads compile pipelines in the background.
+    virtual uint32_t getPipelineCompileThreadCount() {
+        return std::max(1u, std::thread::hardware_concurrency() / 2);
+    }
+
+    //How many threads the AssetStreamer decodes assets on.
+    virtual uint32_t getStreamingThreadCount() {
+        return std::max(1u, std::thread::hardware_concurrency() / 4);
+    }
+
+    //How many bytes of streamed assets are uploaded per frame at most.
+    virtual VkDeviceSize getStreamingUploadBudget() {
+        return 32 * 1024 * 1024;
+    }
+
+    //Puts every loaded image, sampler and BindlessMaterial into one descriptor set if the device supports descriptor
+    //indexing, see BindlessTable.
+    virtual bool useBindlessTable() {
+        return true;
+    }
+
+    //How many images, samplers and materials the BindlessTable has room for. The first two are clamped to the device's
+    //limits.
+    virtual uint32_t getBindlessTextureCount() {
+        return 16384;
+    }
+
+    virtual uint32_t getBindlessSamplerCount() {
+        return 256;
+    }
+
+    virtual uint32_t getBindlessMaterialCount() {
+        return 16384;
+    }
+
     virtual float getFOV() {
         return 90;
     }
@@ -17,6 +17,9 @@
 #include "TimeManager.h"
 #include "ShaderRegisterEvent.h"
 #include "glm/glm.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <ranges>
 #include "AllocatedImage.h"
 #define STB_IMAGE_IMPLEMENTATION
@@ -33,12 +36,27 @@
 #define FrameMark
 #endif
 
+#include "AssetFile.h"
+#include "DrawQueue.h"
+#include "FrustumCuller.h"
+#include "IndirectBatcher.h"
+#include "PipelineCache.h"
+#include "buffer/MeshPool.h"
+#include "buffer/TransientAllocator.h"
 #include "RenderDebugUIEvent.h"
+#include "RenderGraphEvent.h"
 #include "VkFormatParser.h"
+#include "CompressedTexture.h"
+#include "AssetStreamer.h"
+#include "BindlessTable.h"
+#include "GltfLoader.h"
+#include "GpuProfiler.h"
 
 VkInstance XTPVulkan::instance;
 VkQueue XTPVulkan::presentQueue;
 VkQueue XTPVulkan::graphicsQueue;
+VkQueue XTPVulkan::transferQueue;
+std::mutex XTPVulkan::queueMutex;
 #ifdef ISDEBUG
 VkDebugUtilsMessengerEXT XTPVulkan::debugUtilsMessenger;
 #endif
@@ -60,6 +78,8 @@ VkSurfaceKHR XTPVulkan::surface;
 std::vector<bool> XTPVulkan::i;
 std::vector<bool> XTPVulkan::doesSceneBufferNeedToBeUpdated;
 AllocatedImage XTPVulkan::depthImage;
+FrameTimings XTPVulkan::lastFrameTimings;
+GpuFrameStatistics XTPVulkan::lastGpuStatistics;
 uint32_t XTPVulkan::mostRecentFrameRendered;
 VkSwapchainKHR XTPVulkan::swapchain;
 std::vector<VkImage> XTPVulkan::swapchainImages;
@@ -67,15 +87,31 @@ VkFormat XTPVulkan::swapchainImageFormat;
 std::vector<VkImageView> XTPVulkan::swapchainImageViews;
 VkExtent2D XTPVulkan::swapchainExtent;
 std::vector<VkFramebuffer> XTPVulkan::swapchainFramebuffers;
-std::unordered_map<std::shared_ptr<ShaderObject>, std::unordered_map<std::shared_ptr<Material>, std::vector<
-    std::shared_ptr<Renderable> > > > XTPVulkan::toRender;
+std::vector<AllocatedImage> XTPVulkan::offscreenImages;
+bool XTPVulkan::headless = false;
+std::vector<std::shared_ptr<ShaderObject>> XTPVulkan::shaders;
+std::vector<std::shared_ptr<Material>> XTPVulkan::materials;
+std::vector<RenderableEntry> XTPVulkan::renderables;
+std::shared_ptr<const std::vector<std::shared_ptr<Renderable>>> XTPVulkan::tickRenderables;
+std::vector<std::shared_ptr<Renderable>> XTPVulkan::addedRenderables;
+std::mutex XTPVulkan::addedRenderablesMutex;
+std::unordered_map<ShaderObject*, uint32_t> XTPVulkan::shaderIds;
+std::unordered_map<Material*, uint32_t> XTPVulkan::materialIds;
+std::unordered_map<Mesh*, MeshIdEntry> XTPVulkan::meshIds;
+std::vector<uint32_t> XTPVulkan::freeMeshIds;
 VkCommandPool XTPVulkan::commandPool;
+std::vector<std::vector<VkCommandPool>> XTPVulkan::secondaryCommandPools;
+std::vector<std::vector<VkCommandBuffer>> XTPVulkan::secondaryCommandBuffers;
+uint32_t XTPVulkan::recordingChunkCount;
+std::vector<DrawItem> XTPVulkan::drawList;
 std::vector<VkCommandBuffer> XTPVulkan::commandBuffers;
 std::vector<VkSemaphore> XTPVulkan::imageAvailableSemaphores;
 std::vector<VkSemaphore> XTPVulkan::renderFinishedSemaphores;
 std::vector<VkFence> XTPVulkan::inFlightFences;
 std::unique_ptr<vke::DescriptorAllocatorPool> XTPVulkan::allocatorPool;
 uint32_t XTPVulkan::currentFrameIndex;
+float XTPVulkan::tickInterpolationAlpha = 1;
+bool XTPVulkan::tickedSinceLastFrame = true;
 bool XTPVulkan::initialized = false;
 VmaAllocator XTPVulkan::allocator;
 VkPhysicalDeviceProperties XTPVulkan::gpuProperties;
@@ -89,6 +125,13 @@ std::vector<AllocatedBuffer> XTPVulkan::globalSceneDataBuffers;
 bool XTPVulkan::shouldUpdateProjectionMatrix = true;
 bool XTPVulkan::initializedErrorTex = false;
 VkRenderPass XTPVulkan::renderPass;
+bool XTPVulkan::dynamicRendering;
+PFN_vkCmdBeginRenderingKHR XTPVulkan::cmdBeginRendering;
+PFN_vkCmdEndRenderingKHR XTPVulkan::cmdEndRendering;
+PFN_vkCmdPipelineBarrier2KHR XTPVulkan::cmdPipelineBarrier2;
+RenderGraph XTPVulkan::frameGraph;
+RenderGraphResource XTPVulkan::frameColor;
+RenderGraphResource XTPVulkan::frameDepth;
 #ifdef ISDEBUG
 SimpleLogger *XTPVulkan::logger = new SimpleLogger("Debug Vulkan Renderer", DEBUG);
 #else
@@ -105,6 +148,11 @@ void XTPVulkan::init() {
 
     logger->logInformation("Initializing Vulkan!");
 
+    headless = XTPWindowing::windowBackend->isHeadless();
+    if (headless) {
+        logger->logInformation("Window Backend Is Headless, Rendering Into Offscreen Images!");
+    }
+
     logger->logDebug("Getting Vulkan Instance Extension Info");
     availableInstanceExtensions = getVkInstanceExtensionInfo();
     printAvailableVulkanProperties();
@@ -114,7 +162,9 @@ void XTPVulkan::init() {
     debugUtilsMessenger = getDebugMessenger();
 #endif
 
-    surface = createSurface();
+    if (!headless) {
+        surface = createSurface();
+    }
 
     QueueFamilyIndices indices;
     gpu = pickPhysicalDevice(indices);
@@ -124,21 +174,49 @@ void XTPVulkan::init() {
     availableDeviceExtensions = getVkDeviceExtensionInfo();
     printAvailableDeviceExtensions();
 
+    dynamicRendering = VulkanRenderInfo::INSTANCE->useDynamicRendering();
     device = createLogicalDevice();
-
-    swapchain = createSwapchain();
-
-    swapchainImageViews = createImageViews();
-
-    renderPass = createRenderPass();
+    if (dynamicRendering) {
+        //The device only targets Vulkan 1.2, so these come from the extension and aren't exported by the loader.
+        cmdBeginRendering = reinterpret_cast<PFN_vkCmdBeginRenderingKHR>(vkGetDeviceProcAddr(device, "vkCmdBeginRenderingKHR"));
+        cmdEndRendering = reinterpret_cast<PFN_vkCmdEndRenderingKHR>(vkGetDeviceProcAddr(device, "vkCmdEndRenderingKHR"));
+        if (cmdBeginRendering == nullptr || cmdEndRendering == nullptr) {
+            logger->logCritical("Failed To Load VK_KHR_dynamic_rendering Functions!");
+        }
+    }
+    cmdPipelineBarrier2 = reinterpret_cast<PFN_vkCmdPipelineBarrier2KHR>(vkGetDeviceProcAddr(device, "vkCmdPipelineBarrier2KHR"));
+    if (cmdPipelineBarrier2 == nullptr) {
+        logger->logCritical("Failed To Load VK_KHR_synchronization2 Functions!");
+    }
 
     allocator = createAllocator();
+    UploadManager::init();
+    TransientAllocator::init();
+    IndirectBatcher::init();
+    GpuProfiler::init();
+    GpuStatistics::init();
+    //Before the error texture is created, so it gets index 0.
+    BindlessTable::init();
+    PipelineCache::init();
+    AssetStreamer::init();
+
+    if (headless) {
+        createOffscreenTargets();
+    } else {
+        swapchain = createSwapchain();
+        swapchainImageViews = createImageViews();
+    }
+
+    renderPass = dynamicRendering ? VK_NULL_HANDLE : createRenderPass();
 
-    depthImage = createDepthImage();
+    if (!dynamicRendering) {
+        depthImage = createDepthImage();
+    }
     createFramebuffers();
 
     commandPool = createCommandPool();
     commandBuffers = createCommandBuffers();
+    createSecondaryCommandBuffers();
 
     createSyncObjects();
 
@@ -205,7 +283,8 @@ glm::mat4 XTPVulkan::calculateProjectionMatrix(const float fov, const float zNea
 void XTPVulkan::recordCommandBuffers(VkCommandBuffer commandBuffer, uint32_t imageIndex, uint32_t frameIndex) {
     ZoneScopedN("XTPVulkan::recordCommandBuffers");
 #ifdef XTP_USE_ADVANCED_TIMING
-    renderTimeNanos[frameIndex - 1 == -1 ? VulkanRenderInfo::INSTANCE->getMaxFramesInFlight(): frameIndex - 1] = fetchRenderTimeNanos();
+    const uint32_t maxFramesInFlight = VulkanRenderInfo::INSTANCE->getMaxFramesInFlight();
+    renderTimeNanos[(frameIndex + maxFramesInFlight - 1) % maxFramesInFlight] = fetchRenderTimeNanos();
 #endif
 
 
@@ -215,6 +294,8 @@ void XTPVulkan::recordCommandBuffers(VkCommandBuffer commandBuffer, uint32_t ima
     if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
         throw std::runtime_error("failed to begin recording command buffer!");
     }
+    GpuProfiler::beginFrame(commandBuffer, frameIndex);
+    GpuStatistics::beginFrame(frameIndex);
 
 #ifdef XTP_USE_ADVANCED_TIMING
     // Queries must be reset after each individual use.
@@ -222,87 +303,392 @@ void XTPVulkan::recordCommandBuffers(VkCommandBuffer commandBuffer, uint32_t ima
     vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, timeQueryPool, frameIndex * 2);
 #endif
 
-    VkRenderPassBeginInfo renderPassInfo{};
-    renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-    renderPassInfo.renderPass = renderPass;
-    renderPassInfo.framebuffer = swapchainFramebuffers[imageIndex];
+    prepareDrawList();
+    IndirectBatcher::build(frameIndex);
+
+    auto recordScene = [imageIndex, frameIndex](VkCommandBuffer commandBuffer) {
+        if (recordingChunkCount > 0) {
+            beginRendering(commandBuffer, imageIndex, true);
+            recordSecondaryCommandBuffers(commandBuffer, imageIndex, frameIndex);
+        } else {
+            beginRendering(commandBuffer, imageIndex, false);
+            IndirectBatcher::record(commandBuffer, frameIndex);
+            recordDraws(commandBuffer, 0, drawList.size(), imageIndex);
 
-    renderPassInfo.renderArea.offset = {0, 0};
-    renderPassInfo.renderArea.extent = swapchainExtent;
+#ifdef XTP_USE_IMGUI_UI
+            ImGui_ImplVulkan_NewFrame();
+            XTPWindowing::windowBackend->endFrame();
+            ImGui::NewFrame();
 
+            Events::callFunctionOnAllEventsOfType<RenderDebugUIEvent>([](auto event) {event->renderDebugUI();});
+
+            // make imgui calculate internal draw structures
+            ImGui::Render();
+            ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), commandBuffer);
+#endif
+        }
+
+        endRendering(commandBuffer, imageIndex);
+    };
+
+    if (dynamicRendering) {
+        buildFrameGraph(imageIndex, std::move(recordScene));
+        frameGraph.execute(commandBuffer);
+    } else {
+        GpuProfiler::beginZone(commandBuffer, "Scene");
+        GpuStatistics::beginPass(commandBuffer, "Scene");
+        recordScene(commandBuffer);
+        GpuStatistics::endPass(commandBuffer);
+        GpuProfiler::endZone(commandBuffer);
+    }
+
+#ifdef XTP_USE_ADVANCED_TIMING
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, timeQueryPool, frameIndex * 2 + 1);
+    timeQueryInitialized[frameIndex] = true;
+#endif
+    GpuStatistics::endFrame(commandBuffer);
+    GpuProfiler::endFrame(commandBuffer);
+    if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+        throw std::runtime_error("failed to record command buffer!");
+    }
+}
+
+void XTPVulkan::beginRendering(VkCommandBuffer commandBuffer, const uint32_t imageIndex, const bool secondaryContents) {
     std::array<VkClearValue, 2> clearValues{};
     clearValues[0].color = VulkanRenderInfo::INSTANCE->getClearColor();
     clearValues[1].depthStencil = {1.0f, 0};
 
-    renderPassInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
-    renderPassInfo.pClearValues = clearValues.data();
-    renderPassInfo.clearValueCount = clearValues.size();
-    renderPassInfo.pClearValues = clearValues.data();
+    if (!dynamicRendering) {
+        VkRenderPassBeginInfo renderPassInfo{};
+        renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+        renderPassInfo.renderPass = renderPass;
+        renderPassInfo.framebuffer = swapchainFramebuffers[imageIndex];
 
-    vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+        renderPassInfo.renderArea.offset = {0, 0};
+        renderPassInfo.renderArea.extent = swapchainExtent;
 
-    ShaderObject* currentShader = nullptr;
-    auto pairIterator = toRender.begin();
-    while (pairIterator != toRender.end()) {
-        bool isFirstShader = false;
-        if (currentShader == nullptr) {
-            currentShader = pairIterator->first.get();
-            isFirstShader = true;
+        renderPassInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
+        renderPassInfo.pClearValues = clearValues.data();
+
+        vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, secondaryContents ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS
+                                                                               : VK_SUBPASS_CONTENTS_INLINE);
+        return;
+    }
+
+    VkRenderingAttachmentInfoKHR colorAttachment {};
+    colorAttachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
+    colorAttachment.imageView = swapchainImageViews[imageIndex];
+    colorAttachment.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+    colorAttachment.clearValue = clearValues[0];
+
+    VkRenderingAttachmentInfoKHR depthAttachment {};
+    depthAttachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
+    depthAttachment.imageView = frameGraph.getImageView(frameDepth);
+    depthAttachment.imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+    depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    depthAttachment.clearValue = clearValues[1];
+
+    VkRenderingInfoKHR renderingInfo {};
+    renderingInfo.sType = VK_STRUCTURE_TYPE_RENDERING_INFO_KHR;
+    renderingInfo.flags = secondaryContents ? VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT_KHR : 0;
+    renderingInfo.renderArea = {{0, 0}, swapchainExtent};
+    renderingInfo.layerCount = 1;
+    renderingInfo.colorAttachmentCount = 1;
+    renderingInfo.pColorAttachments = &colorAttachment;
+    renderingInfo.pDepthAttachment = &depthAttachment;
+
+    cmdBeginRendering(commandBuffer, &renderingInfo);
+}
+
+void XTPVulkan::endRendering(VkCommandBuffer commandBuffer, const uint32_t imageIndex) {
+    if (!dynamicRendering) {
+        vkCmdEndRenderPass(commandBuffer);
+        return;
+    }
+    cmdEndRendering(commandBuffer);
+}
+
+void XTPVulkan::buildFrameGraph(const uint32_t imageIndex, RenderGraph::RecordFunction &&recordScene) {
+    ZoneScopedN("XTPVulkan::buildFrameGraph");
+    frameGraph.reset();
+
+    //The acquire semaphore is waited on in the color attachment output stage, and the image is cleared, so its previous
+    //contents can be discarded. Offscreen images are never presented, so they are left ready to be copied out instead.
+    frameColor = frameGraph.importImage("Swapchain", swapchainImages[imageIndex], swapchainImageViews[imageIndex],
+                                        VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_LAYOUT_UNDEFINED,
+                                        VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+                                        headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+                                        headless ? VK_PIPELINE_STAGE_2_TRANSFER_BIT : VK_PIPELINE_STAGE_2_NONE,
+                                        headless ? VK_ACCESS_2_TRANSFER_READ_BIT : VK_ACCESS_2_NONE);
+    frameDepth = frameGraph.createImage("Depth", {swapchainExtent.width, swapchainExtent.height, DEPTH_FORMAT, 0,
+                                                  VK_IMAGE_ASPECT_DEPTH_BIT});
+
+    std::vector<RenderGraphUse> sceneUses = {
+        {frameColor, RenderGraphAccess::COLOR_ATTACHMENT_WRITE},
+        {frameDepth, RenderGraphAccess::DEPTH_ATTACHMENT_WRITE}
+    };
+    Events::callFunctionOnAllEventsOfType<RenderGraphEvent>([&sceneUses](auto event) {
+        event->onBuildPassesBeforeScene(frameGraph, sceneUses);
+    });
+    frameGraph.addPass("Scene", sceneUses, std::move(recordScene));
+    Events::callFunctionOnAllEventsOfType<RenderGraphEvent>([](auto event) {
+        event->onBuildPassesAfterScene(frameGraph, frameColor, frameDepth);
+    });
+
+    frameGraph.compile();
+}
+
+void XTPVulkan::prepareDrawList() {
+    ZoneScopedN("XTPVulkan::prepareDrawList");
+    drawList.clear();
+    IndirectBatcher::items.clear();
+
+    bool renderablesChanged = false;
+    {
+        std::lock_guard lock(addedRenderablesMutex);
+        for (std::shared_ptr<Renderable> &renderable: addedRenderables) {
+            renderables.push_back({std::move(renderable)});
         }
-        if (pairIterator->first.get() != currentShader || isFirstShader) {
-            currentShader = pairIterator->first.get();
-            currentShader->prepareForRender(commandBuffer);
-            isFirstShader = false;
+        renderablesChanged = !addedRenderables.empty();
+        addedRenderables.clear();
+    }
+
+    //Everything that creates or destroys resources happens here on the render thread, so recording the draws afterwards
+    //only reads shared state and can be split across threads.
+    size_t index = 0;
+    while (index < renderables.size()) {
+        RenderableEntry &entry = renderables[index];
+        Renderable* renderable = entry.renderable.get();
+        if (renderable->shouldRemove()) {
+            renderable->remove();
+            if (entry.initialized) {
+                releaseMeshId(entry.mesh);
+            }
+            //The draw list is sorted afterwards, so the order of the entries doesn't matter.
+            entry = std::move(renderables.back());
+            renderables.pop_back();
+            renderablesChanged = true;
+            continue;
         }
-        auto materialIterator = pairIterator->second.begin();
-        while (materialIterator != pairIterator->second.end()) {
-            if (!materialIterator->first->initialized()) {
-                materialIterator->first->init(currentShader);
+        //This frame draws whatever the tick thread published last, however far it has gotten with the next tick.
+        renderable->acquireTickState();
+        if (!entry.initialized) {
+            const std::shared_ptr<ShaderObject> shader = renderable->getShader();
+            const std::shared_ptr<Material> material = renderable->getMaterial();
+            const std::shared_ptr<Mesh> mesh = renderable->getMesh();
+
+            if (!material->initialized()) {
+                material->init(shader.get());
             }
-            materialIterator->first->prepareForRender(commandBuffer, currentShader);
-            auto renderableIterator = materialIterator->second.begin();
-            while (renderableIterator != materialIterator->second.end()) {
-                bool removed = false;
-                if (renderableIterator->get()->shouldRemove()) {
-                    renderableIterator->get()->remove();
-                    renderableIterator = materialIterator->second.erase(renderableIterator);
-                    removed = true;
-                } else if (!renderableIterator->get()->hasInitialized()) {
-                    if (!renderableIterator->get()->getMesh()->initialized()) {
-                        renderableIterator->get()->getMesh()->init();
-                    }
-                    pairIterator->first->initRenderable(renderableIterator->get());
-                    renderableIterator->get()->init();
-                }
-                renderableIterator->get()->draw(commandBuffer, imageIndex);
-                if (!removed) ++renderableIterator;
+            if (!mesh->initialized()) {
+                mesh->init();
             }
-            ++materialIterator;
+            if (!renderable->hasInitialized()) {
+                shader->initRenderable(renderable);
+                renderable->init();
+            }
+
+            entry.shader = shader.get();
+            entry.material = material.get();
+            entry.mesh = mesh.get();
+            entry.shaderId = registerShader(shader);
+            entry.materialId = registerMaterial(material);
+            entry.meshId = acquireMeshId(entry.mesh);
+            entry.initialized = true;
+        }
+
+        //Still compiling, so there is nothing to draw it with yet.
+        if (!entry.shader->isReady()) {
+            ++index;
+            continue;
+        }
+        if (entry.shader->drawsIndirect()) {
+            IndirectBatcher::items.push_back({entry.shader, entry.material, renderable});
+        } else {
+            //The key is finished once culling has removed the items that won't be drawn.
+            drawList.push_back({entry.shader, entry.material, renderable, DrawQueue::makeSortKey(entry.shaderId,
+                entry.materialId, entry.meshId, 0)});
         }
-        ++pairIterator;
+        ++index;
     }
 
+    if (renderablesChanged) {
+        auto ticked = std::make_shared<std::vector<std::shared_ptr<Renderable>>>();
+        ticked->reserve(renderables.size());
+        for (const RenderableEntry &entry: renderables) {
+            ticked->push_back(entry.renderable);
+        }
+        std::atomic_store(&tickRenderables, std::shared_ptr<const std::vector<std::shared_ptr<Renderable>>>(std::move(ticked)));
+    }
+
+    if (VulkanRenderInfo::INSTANCE->useFrustumCulling()) {
+        FrustumCuller::cull(drawList, projectionMatrix * viewMatrix);
+    }
+
+    //Renderables with the same state are drawn front to back, so the depth test rejects more fragments.
+    const float zFar = VulkanRenderInfo::INSTANCE->getZFar();
+    for (DrawItem &item: drawList) {
+        if (item.renderable->frustumCullable()) {
+            const glm::vec4 position = viewMatrix * glm::vec4(glm::vec3(item.renderable->getTransform()[3]), 1);
+            const uint64_t depth = static_cast<uint64_t>(std::clamp(-position.z / zFar, 0.0f, 1.0f) *
+                                                         ((1ull << DrawQueue::DEPTH_BITS) - 1));
+            item.sortKey |= depth;
+        }
+    }
+    DrawQueue::sort(drawList);
+}
+
+void XTPVulkan::recordDraws(VkCommandBuffer commandBuffer, const size_t first, const size_t last, const uint32_t imageIndex) {
+    ZoneScopedN("XTPVulkan::recordDraws");
+    //Bindings are not shared between command buffers, so the pool has to be bound once in each of them.
+    MeshPool::bind(commandBuffer);
+
+    ShaderObject* currentShader = nullptr;
+    Material* currentMaterial = nullptr;
+    for (size_t index = first; index < last; ++index) {
+        const DrawItem &item = drawList[index];
+        if (item.shader != currentShader) {
+            currentShader = item.shader;
+            currentShader->prepareForRender(commandBuffer);
+            BindlessTable::bind(commandBuffer, currentShader);
+            currentMaterial = nullptr;
+        }
+        if (item.material != currentMaterial) {
+            currentMaterial = item.material;
+            currentMaterial->prepareForRender(commandBuffer, currentShader);
+        }
+        item.renderable->draw(commandBuffer, imageIndex);
+    }
+}
+
+void XTPVulkan::recordSecondaryCommandBuffers(VkCommandBuffer commandBuffer, const uint32_t imageIndex, const uint32_t frameIndex) {
+    ZoneScopedN("XTPVulkan::recordSecondaryCommandBuffers");
+    const std::vector<VkCommandBuffer> &secondaries = secondaryCommandBuffers[frameIndex];
+    const uint32_t chunkCount = recordingChunkCount;
+    const size_t chunkSize = (drawList.size() + chunkCount - 1) / chunkCount;
+
+    VkCommandBufferInheritanceRenderingInfoKHR renderingInheritanceInfo {};
+    renderingInheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO_KHR;
+    renderingInheritanceInfo.colorAttachmentCount = 1;
+    renderingInheritanceInfo.pColorAttachmentFormats = &swapchainImageFormat;
+    renderingInheritanceInfo.depthAttachmentFormat = DEPTH_FORMAT;
+    renderingInheritanceInfo.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+    VkCommandBufferInheritanceInfo inheritanceInfo {};
+    inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    if (dynamicRendering) {
+        inheritanceInfo.pNext = &renderingInheritanceInfo;
+    } else {
+        inheritanceInfo.renderPass = renderPass;
+        inheritanceInfo.subpass = 0;
+        inheritanceInfo.framebuffer = swapchainFramebuffers[imageIndex];
+    }
+    //They are executed inside the scene pass's pipeline statistics query.
+    inheritanceInfo.pipelineStatistics = GpuStatistics::getInheritedPipelineStatistics();
+
+    VkCommandBufferBeginInfo beginInfo {};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+    //The frame's fence has already been waited on, so nothing recorded from these pools is still in use.
+    for (const VkCommandPool pool: secondaryCommandPools[frameIndex]) {
+        vkResetCommandPool(device, pool, 0);
+    }
+
+    //Every chunk is its own job, since each one records into its own command buffer.
+    JobSystem::parallelFor(chunkCount, 1, [&](const size_t firstChunk, const size_t lastChunk) {
+        for (size_t chunk = firstChunk; chunk < lastChunk; ++chunk) {
+            ZoneScopedN("XTPVulkan::recordSecondaryCommandBuffers#chunk");
+            const size_t first = std::min(drawList.size(), chunk * chunkSize);
+            const size_t last = std::min(drawList.size(), first + chunkSize);
+
+            if (vkBeginCommandBuffer(secondaries[chunk], &beginInfo) != VK_SUCCESS) {
+                logger->logCritical("Failed To Begin Recording Secondary Command Buffer!");
+            }
+            if (chunk == 0) {
+                IndirectBatcher::record(secondaries[chunk], frameIndex);
+            }
+            recordDraws(secondaries[chunk], first, last, imageIndex);
+            if (vkEndCommandBuffer(secondaries[chunk]) != VK_SUCCESS) {
+                logger->logCritical("Failed To Record Secondary Command Buffer!");
+            }
+        }
+    });
+
+    uint32_t secondaryCount = chunkCount;
 #ifdef XTP_USE_IMGUI_UI
+    //ImGui is not thread safe, so its draw data is built on the render thread. It still needs its own secondary command
+    //buffer, since commands cannot be recorded inline in a subpass that executes secondary command buffers.
+    const VkCommandBuffer imguiCommandBuffer = secondaries[chunkCount];
+    if (vkBeginCommandBuffer(imguiCommandBuffer, &beginInfo) != VK_SUCCESS) {
+        logger->logCritical("Failed To Begin Recording Secondary Command Buffer!");
+    }
     ImGui_ImplVulkan_NewFrame();
     XTPWindowing::windowBackend->endFrame();
     ImGui::NewFrame();
 
     Events::callFunctionOnAllEventsOfType<RenderDebugUIEvent>([](auto event) {event->renderDebugUI();});
 
-    // make imgui calculate internal draw structures
     ImGui::Render();
-    ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), commandBuffer);
+    ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), imguiCommandBuffer);
+    if (vkEndCommandBuffer(imguiCommandBuffer) != VK_SUCCESS) {
+        logger->logCritical("Failed To Record Secondary Command Buffer!");
+    }
+    secondaryCount++;
 #endif
 
-    vkCmdEndRenderPass(commandBuffer);
+    vkCmdExecuteCommands(commandBuffer, secondaryCount, secondaries.data());
+}
 
-#ifdef XTP_USE_ADVANCED_TIMING
-    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, timeQueryPool, frameIndex * 2 + 1);
-    timeQueryInitialized[frameIndex] = true;
+void XTPVulkan::createSecondaryCommandBuffers() {
+    ZoneScopedN("XTPVulkan::createSecondaryCommandBuffers");
+    const uint32_t threadCount = VulkanRenderInfo::INSTANCE->getRecordingThreadCount();
+    if (threadCount <= 1) {
+        return;
+    }
+
+    recordingChunkCount = threadCount;
+
+    uint32_t slotCount = threadCount;
+#ifdef XTP_USE_IMGUI_UI
+    slotCount++;
 #endif
-    if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
-        throw std::runtime_error("failed to record command buffer!");
+
+    const uint32_t maxFramesInFlight = VulkanRenderInfo::INSTANCE->getMaxFramesInFlight();
+    secondaryCommandPools = std::vector<std::vector<VkCommandPool>>(maxFramesInFlight);
+    secondaryCommandBuffers = std::vector<std::vector<VkCommandBuffer>>(maxFramesInFlight);
+
+    for (uint32_t frame = 0; frame < maxFramesInFlight; ++frame) {
+        secondaryCommandPools[frame] = std::vector<VkCommandPool>(slotCount);
+        secondaryCommandBuffers[frame] = std::vector<VkCommandBuffer>(slotCount);
+
+        for (uint32_t slot = 0; slot < slotCount; ++slot) {
+            VkCommandPoolCreateInfo poolInfo {};
+            poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+            poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+            poolInfo.queueFamilyIndex = queueIndices.graphicsFamily.value();
+
+            if (vkCreateCommandPool(device, &poolInfo, nullptr, &secondaryCommandPools[frame][slot]) != VK_SUCCESS) {
+                logger->logCritical("Failed To Create Secondary Command Pool!");
+            }
+
+            VkCommandBufferAllocateInfo allocInfo {};
+            allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocInfo.commandPool = secondaryCommandPools[frame][slot];
+            allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+            allocInfo.commandBufferCount = 1;
+
+            if (vkAllocateCommandBuffers(device, &allocInfo, &secondaryCommandBuffers[frame][slot]) != VK_SUCCESS) {
+                logger->logCritical("Failed To Allocate Secondary Command Buffers!");
+            }
+        }
     }
+
+    logger->logInformation("Recording Draws On {} Threads", threadCount);
 }
 
 void XTPVulkan::drawFrame() {
@@ -316,11 +702,26 @@ void XTPVulkan::drawFrame() {
     }
 
     TracyCZoneN(__waitForFences, "XTPVulkan::drawFrame#waitForFences", true)
+    const long fenceWaitStart = TimeManager::getCurrentTimeNano();
     vkWaitForFences(device, 1, &inFlightFences[currentFrameIndex], VK_TRUE, UINT64_MAX);
+    lastFrameTimings.fenceWaitNanos = TimeManager::getCurrentTimeNano() - fenceWaitStart;
     TracyCZoneEnd(__waitForFences)
+    MeshPool::onFrame(currentFrameIndex);
+    TransientAllocator::beginFrame(currentFrameIndex);
+    PipelineCache::rethrowCompileErrors();
+    AssetStreamer::onFrame();
+    //The fence guarantees the previous frame drawn in this slot has finished, so its timestamps can be read right away.
+    lastFrameTimings.gpuNanos = fetchFrameRenderTimeNanos(currentFrameIndex);
+    GpuProfiler::collect(currentFrameIndex);
+    GpuStatistics::collect(currentFrameIndex);
     uint32_t imageIndex;
-    vkAcquireNextImageKHR(device, swapchain, UINT64_MAX, imageAvailableSemaphores[currentFrameIndex], VK_NULL_HANDLE,
-                          &imageIndex);
+    if (headless) {
+        //There is one offscreen image per frame in flight, so the frame's fence already guarantees it is free.
+        imageIndex = currentFrameIndex;
+    } else {
+        vkAcquireNextImageKHR(device, swapchain, UINT64_MAX, imageAvailableSemaphores[currentFrameIndex], VK_NULL_HANDLE,
+                              &imageIndex);
+    }
 
     if (doesSceneBufferNeedToBeUpdated[currentFrameIndex]) {
         SceneRenderData data = {};
@@ -337,7 +738,9 @@ void XTPVulkan::drawFrame() {
 
     TracyCZoneN(__draw, "XTPVulkan::drawFrame#draw", true)
     Events::callFunctionOnAllEventsOfType<FrameEvent>([](FrameEvent *event) { event->onFrameDrawBegin(); });
+    const long recordStart = TimeManager::getCurrentTimeNano();
     recordCommandBuffers(commandBuffers[currentFrameIndex], imageIndex, currentFrameIndex);
+    lastFrameTimings.recordNanos = TimeManager::getCurrentTimeNano() - recordStart;
     Events::callFunctionOnAllEventsOfType<FrameEvent>([](FrameEvent *event) { event->onFrameDrawEnd(); });
     TracyCZoneEnd(__draw)
 
@@ -346,22 +749,36 @@ void XTPVulkan::drawFrame() {
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
     const VkSemaphore waitSemaphores[] = {imageAvailableSemaphores[currentFrameIndex]};
     constexpr VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-    submitInfo.waitSemaphoreCount = 1;
+    submitInfo.waitSemaphoreCount = headless ? 0 : 1;
     submitInfo.pWaitSemaphores = waitSemaphores;
     submitInfo.pWaitDstStageMask = waitStages;
     submitInfo.commandBufferCount = 1;
     submitInfo.pCommandBuffers = &commandBuffers[currentFrameIndex];
     const VkSemaphore signalSemaphores[] = {renderFinishedSemaphores[currentFrameIndex]};
-    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.signalSemaphoreCount = headless ? 0 : 1;
     submitInfo.pSignalSemaphores = signalSemaphores;
     TracyCZoneEnd(subInfCreate)
 
     TracyCZoneN(submit, "XTPVulkan::drawFrame#submit", true)
-    if (vkQueueSubmit(graphicsQueue, 1, &submitInfo, inFlightFences[currentFrameIndex]) != VK_SUCCESS) {
-        logger->logCritical("Failed To Submit Draw Command Buffer!");
+    const long submitStart = TimeManager::getCurrentTimeNano();
+    //Submitted first, so this frame's draws are ordered after everything uploaded while it was being recorded.
+    UploadManager::flush();
+    {
+        std::lock_guard lock(queueMutex);
+        if (vkQueueSubmit(graphicsQueue, 1, &submitInfo, inFlightFences[currentFrameIndex]) != VK_SUCCESS) {
+            logger->logCritical("Failed To Submit Draw Command Buffer!");
+        }
     }
+    lastFrameTimings.submitNanos = TimeManager::getCurrentTimeNano() - submitStart;
+    GpuProfiler::markSubmitted(currentFrameIndex);
     TracyCZoneEnd(submit)
 
+    if (headless) {
+        i[currentFrameIndex] = true;
+        Events::callFunctionOnAllEventsOfType<FrameEvent>([](FrameEvent *event) { event->onFrameEnd(); });
+        return;
+    }
+
     TracyCZoneN(presInfCreate, "XTPVulkan::drawFrame#createPresentInfo", true)
     VkPresentInfoKHR presentInfo{};
     presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
@@ -374,7 +791,10 @@ void XTPVulkan::drawFrame() {
     TracyCZoneEnd(presInfCreate)
 
     TracyCZoneN(present, "XTPVulkan::drawFrame#present", true);
-    vkQueuePresentKHR(presentQueue, &presentInfo);
+    {
+        std::lock_guard lock(queueMutex);
+        vkQueuePresentKHR(presentQueue, &presentInfo);
+    }
     TracyCZoneEnd(present)
 
     i[currentFrameIndex] = true;
@@ -386,14 +806,27 @@ void XTPVulkan::cleanupSwapchain() {
     for (const auto &swapchainFramebuffer: swapchainFramebuffers) {
         vkDestroyFramebuffer(device, swapchainFramebuffer, nullptr);
     }
+    swapchainFramebuffers.clear();
 
-    for (const auto &swapchainImageView: swapchainImageViews) {
-        vkDestroyImageView(device, swapchainImageView, nullptr);
+    if (headless) {
+        //Destroying the offscreen images also destroys their views.
+        for (AllocatedImage &offscreenImage: offscreenImages) {
+            destroyAllocatedImage(&offscreenImage);
+        }
+        offscreenImages.clear();
+    } else {
+        for (const auto &swapchainImageView: swapchainImageViews) {
+            vkDestroyImageView(device, swapchainImageView, nullptr);
+        }
     }
 
-    destroyAllocatedImage(&depthImage);
+    if (!dynamicRendering) {
+        destroyAllocatedImage(&depthImage);
+    }
 
-    vkDestroySwapchainKHR(device, swapchain, nullptr);
+    if (!headless) {
+        vkDestroySwapchainKHR(device, swapchain, nullptr);
+    }
 }
 
 void XTPVulkan::recreateSwapchain() {
@@ -413,9 +846,15 @@ void XTPVulkan::recreateSwapchain() {
 
     cleanupSwapchain();
 
-    swapchain = createSwapchain();
-    swapchainImageViews = createImageViews();
-    depthImage = createDepthImage();
+    if (headless) {
+        createOffscreenTargets();
+    } else {
+        swapchain = createSwapchain();
+        swapchainImageViews = createImageViews();
+    }
+    if (!dynamicRendering) {
+        depthImage = createDepthImage();
+    }
     createFramebuffers();
 }
 
@@ -483,7 +922,11 @@ VmaAllocator XTPVulkan::createAllocator() {
     allocatorInfo.physicalDevice = gpu;
     allocatorInfo.device = device;
     allocatorInfo.instance = instance;
+    allocatorInfo.vulkanApiVersion = VK_API_VERSION_1_2;
     allocatorInfo.flags |= VMA_ALLOCATOR_CREATE_BUFFER_DEVICE_ADDRESS_BIT;
+    if (GpuStatistics::memoryBudgetSupported) {
+        allocatorInfo.flags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT;
+    }
     vmaCreateAllocator(&allocatorInfo, &allocator);
 
     return allocator;
@@ -529,15 +972,16 @@ VkDescriptorPool XTPVulkan::initImgui() {
 	init_info.Device = device;
 	init_info.Queue = graphicsQueue;
 	init_info.DescriptorPool = imguiPool;
-	init_info.MinImageCount = 3;
+	init_info.MinImageCount = headless ? swapchainImages.size() : 3;
 	init_info.ImageCount = swapchainImages.size();
-	init_info.UseDynamicRendering = false;
+	init_info.UseDynamicRendering = dynamicRendering;
     init_info.RenderPass = renderPass;
 
 	//dynamic rendering parameters for imgui to use
 	init_info.PipelineRenderingCreateInfo = {.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO};
 	init_info.PipelineRenderingCreateInfo.colorAttachmentCount = 1;
 	init_info.PipelineRenderingCreateInfo.pColorAttachmentFormats = &swapchainImageFormat;
+	init_info.PipelineRenderingCreateInfo.depthAttachmentFormat = DEPTH_FORMAT;
 
 	init_info.MSAASamples = VK_SAMPLE_COUNT_1_BIT;
 
@@ -651,21 +1095,37 @@ uint64_t XTPVulkan::fetchRenderTimeNanos() {
                 throw std::runtime_error("Failed to receive query results!");
             }
         }
-        if (times.empty()) {
-            return -1;
-        }
-        uint64_t sum = 0;
-        for (const long double time: times) {
-            sum += static_cast<uint64_t>(time);
-        }
-        return sum / times.size();
     }
-    return -1;
+    if (times.empty()) {
+        return -1;
+    }
+    uint64_t sum = 0;
+    for (const long double time: times) {
+        sum += static_cast<uint64_t>(time);
+    }
+    return sum / times.size();
 #else
         return -1;
 #endif
 }
 
+uint64_t XTPVulkan::fetchFrameRenderTimeNanos(const uint32_t frameIndex) {
+#ifdef XTP_USE_ADVANCED_TIMING
+    if (!timeQueryInitialized[frameIndex]) {
+        return -1;
+    }
+    uint64_t buffer[2];
+    const VkResult result = vkGetQueryPoolResults(device, timeQueryPool, frameIndex * 2, 2, sizeof(uint64_t) * 2, buffer,
+                                                  sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+    if (result != VK_SUCCESS) {
+        return -1;
+    }
+    return static_cast<uint64_t>(static_cast<long double>(buffer[1] - buffer[0]) * gpuProperties.limits.timestampPeriod);
+#else
+    return -1;
+#endif
+}
+
 void XTPVulkan::immediateSubmit(std::function<void(VkCommandBuffer cmd)> &&function) {
     VkCommandBufferAllocateInfo allocInfo{};
     allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
@@ -691,8 +1151,11 @@ void XTPVulkan::immediateSubmit(std::function<void(VkCommandBuffer cmd)> &&funct
     submitInfo.commandBufferCount = 1;
     submitInfo.pCommandBuffers = &commandBuffer;
 
-    vkQueueSubmit(graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
-    vkQueueWaitIdle(graphicsQueue);
+    {
+        std::lock_guard lock(queueMutex);
+        vkQueueSubmit(graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
+        vkQueueWaitIdle(graphicsQueue);
+    }
 
     vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
 }
@@ -749,11 +1212,7 @@ void XTPVulkan::destroyAllocatedBuffer(AllocatedBuffer *buffer) {
 
 
 void XTPVulkan::copyBuffer(AllocatedBuffer srcBuffer, AllocatedBuffer dstBuffer, VkDeviceSize size) {
-    immediateSubmit([size, srcBuffer, dstBuffer](const VkCommandBuffer& cmd) {
-        VkBufferCopy copyRegion {};
-        copyRegion.size = size;
-        vkCmdCopyBuffer(cmd, srcBuffer.internalBuffer, dstBuffer.internalBuffer, 1, &copyRegion);
-    });
+    UploadManager::copyBuffer(srcBuffer, dstBuffer, size);
 }
 
 AllocatedImage XTPVulkan::createErrorTex() {
@@ -779,7 +1238,7 @@ void XTPVulkan::createImageView(AllocatedImage &image, const VkFormat format, Vk
     viewInfo.format = format;
     viewInfo.subresourceRange.aspectMask = aspectFlags;
     viewInfo.subresourceRange.baseMipLevel = 0;
-    viewInfo.subresourceRange.levelCount = 1;
+    viewInfo.subresourceRange.levelCount = std::max(image.mipLevels, 1u);
     viewInfo.subresourceRange.baseArrayLayer = 0;
     viewInfo.subresourceRange.layerCount = 1;
 
@@ -789,8 +1248,21 @@ void XTPVulkan::createImageView(AllocatedImage &image, const VkFormat format, Vk
 }
 
 AllocatedImage XTPVulkan::createImage(const char *path, VkFormat imageFormat) {
+    if (CompressedTextureLoader::isCompressedTexturePath(path)) {
+        CompressedTexture texture;
+        if (!CompressedTextureLoader::load(path, CompressedTextureLoader::isSrgbFormat(imageFormat), texture)) {
+            logger->logError("Failed To Load Texture", !initializedErrorTex);
+            return errorTexure;
+        }
+        return createCompressedImage(texture);
+    }
+
+    //Decoded straight from the mapped file or archive, instead of through stdio's buffer.
+    const AssetFile file(path);
     int texWidth, texHeight, texChannels;
-    stbi_uc *pixels = stbi_load(path, &texWidth, &texHeight, &texChannels, STBI_rgb_alpha);
+    stbi_uc *pixels = file.isOpen() && file.size() <= std::numeric_limits<int>::max() ?
+        stbi_load_from_memory(file.data(), static_cast<int>(file.size()), &texWidth, &texHeight, &texChannels, STBI_rgb_alpha) :
+        nullptr;
     const VkDeviceSize imageSize = texWidth * texHeight * 4 /*This Value is 4, Since Our Format Is STBI_rgb_alpha*/;
 
     if (!pixels) {
@@ -805,13 +1277,14 @@ AllocatedImage XTPVulkan::createImage(const char *path, VkFormat imageFormat) {
 }
 
 AllocatedImage XTPVulkan::createDepthImage() {
-    constexpr VkFormat depthFormat = VK_FORMAT_D32_SFLOAT;
-    return createImage(swapchainExtent.width, swapchainExtent.height, depthFormat,
+    return createImage(swapchainExtent.width, swapchainExtent.height, DEPTH_FORMAT,
                 VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, VK_IMAGE_ASPECT_DEPTH_BIT);
 }
 
-AllocatedImage XTPVulkan::createImage(const uint32_t width, const uint32_t height, const VkFormat imageFormat, VkImageUsageFlags usage, VkImageAspectFlags aspectFlags) {
+AllocatedImage XTPVulkan::createImage(const uint32_t width, const uint32_t height, const VkFormat imageFormat, VkImageUsageFlags usage, VkImageAspectFlags aspectFlags,
+                                      const uint32_t mipLevels) {
     AllocatedImage image {};
+    image.mipLevels = mipLevels;
 
     VkImageCreateInfo imageInfo {};
 
@@ -820,7 +1293,7 @@ AllocatedImage XTPVulkan::createImage(const uint32_t width, const uint32_t heigh
     imageInfo.extent.width = width;
     imageInfo.extent.height = height;
     imageInfo.extent.depth = 1;
-    imageInfo.mipLevels = 1;
+    imageInfo.mipLevels = mipLevels;
     imageInfo.arrayLayers = 1;
     imageInfo.format = imageFormat;
     imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
@@ -845,33 +1318,61 @@ AllocatedImage XTPVulkan::createImage(const uint32_t width, const uint32_t heigh
 
 AllocatedImage XTPVulkan::createImage(void *pixels, VkDeviceSize imageSize, VkFormat imageFormat, uint32_t width,
                                       uint32_t height) {
-    AllocatedBuffer stagingBuffer = createSimpleBuffer(imageSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                                                       VMA_MEMORY_USAGE_CPU_ONLY, false);
-    memcpy(stagingBuffer.info.pMappedData, pixels, imageSize);
+    //The mip chain is generated by linearly filtered blits from each level into the next, so the format has to support
+    //both, otherwise the image only gets one level.
+    constexpr VkFormatFeatureFlags mipFeatures = VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT |
+                                                 VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT;
+    VkFormatProperties formatProperties;
+    vkGetPhysicalDeviceFormatProperties(gpu, imageFormat, &formatProperties);
+    uint32_t mipLevels = 1;
+    if ((formatProperties.optimalTilingFeatures & mipFeatures) == mipFeatures) {
+        mipLevels = static_cast<uint32_t>(std::floor(std::log2(std::max(width, height)))) + 1;
+    }
 
-    AllocatedImage image = createImage(width, height, imageFormat, VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_IMAGE_ASPECT_COLOR_BIT);
+    AllocatedImage image = createImage(width, height, imageFormat, VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                                       VK_IMAGE_ASPECT_COLOR_BIT, mipLevels);
+    if (image.image == errorTexure.image) {
+        return image;
+    }
 
+    image.bindlessIndex = BindlessTable::addImage(image);
     allLoadedImages.emplace_back(image);
 
-    immediateSubmit([stagingBuffer, image, width, height, imageFormat](auto cmd) {
-
-        transitionImageLayout(cmd, image, imageFormat, VK_IMAGE_LAYOUT_UNDEFINED,
-                              VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    UploadManager::uploadImage(pixels, imageSize, image, width, height);
 
-        copyBufferToImage(cmd, stagingBuffer.internalBuffer, image.image, static_cast<uint32_t>(width),
-                          static_cast<uint32_t>(height));
+    return image;
+}
 
-        transitionImageLayout(cmd, image, imageFormat, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                              VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+AllocatedImage XTPVulkan::createCompressedImage(const CompressedTexture &texture) {
+    VkFormatProperties formatProperties;
+    vkGetPhysicalDeviceFormatProperties(gpu, texture.format, &formatProperties);
+    if (!(formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT)) {
+        logger->logError("Compressed Texture Format {} Isn't Supported!", !initializedErrorTex,
+                         VkFormatParser::toStringVkFormat(texture.format));
+        return errorTexure;
+    }
 
-    });
+    AllocatedImage image = createImage(texture.width, texture.height, texture.format, VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                                       VK_IMAGE_ASPECT_COLOR_BIT, static_cast<uint32_t>(texture.levelOffsets.size()));
+    if (image.image == errorTexure.image) {
+        return image;
+    }
 
+    image.bindlessIndex = BindlessTable::addImage(image);
+    allLoadedImages.emplace_back(image);
 
-    destroyAllocatedBuffer(&stagingBuffer);
+    UploadManager::uploadImageLevels(texture.data.data(), texture.data.size(), image, texture.width, texture.height,
+                                     texture.levelOffsets);
 
     return image;
 }
 
+#ifdef XTP_USE_GLTF_LOADING
+bool XTPVulkan::loadGltfModel(const bool isBinaryGltf, const char *path, GltfModel &model, const char *sceneToLoad) {
+    return GltfLoader::load(path, isBinaryGltf, model, sceneToLoad);
+}
+#endif
+
 void XTPVulkan::createSampler(AllocatedImage& image, VkFilter magFilter, VkFilter minFilter, VkSamplerAddressMode addressModeU, VkSamplerAddressMode addressModeV, VkSamplerAddressMode addressModeW, bool useAnisotropy, float maxAnisotropy, VkBorderColor borderColor) {
     VkSamplerCreateInfo samplerInfo {};
     samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
@@ -891,7 +1392,7 @@ void XTPVulkan::createSampler(AllocatedImage& image, VkFilter magFilter, VkFilte
         samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
         samplerInfo.mipLodBias = 0.0f;
         samplerInfo.minLod = 0.0f;
-        samplerInfo.maxLod = 0.0f;
+        samplerInfo.maxLod = static_cast<float>(image.mipLevels);
     } else {
         samplerInfo.magFilter = VK_FILTER_NEAREST;
         samplerInfo.minFilter = VK_FILTER_NEAREST;
@@ -914,27 +1415,34 @@ void XTPVulkan::createSampler(AllocatedImage& image, VkFilter magFilter, VkFilte
         throw std::runtime_error("failed to create texture sampler!");
     }
     samplers.emplace_back(image.sampler);
+    image.bindlessSamplerIndex = BindlessTable::addSampler(image.sampler);
 }
 
 void XTPVulkan::cleanUp() {
     ZoneScopedN("XTPVulkan::cleanUp");
     vkDeviceWaitIdle(device);
     logger->logDebug("Cleaning Up Vulkan");
+    AssetStreamer::cleanUp();
 
-
-    for (auto &[shader, materialMap]: toRender) {
+    for (std::shared_ptr<Renderable> &renderable: addedRenderables) {
+        renderables.push_back({std::move(renderable)});
+    }
+    addedRenderables.clear();
+    std::atomic_store(&tickRenderables, {});
+    for (const RenderableEntry &entry: renderables) {
+        if (!entry.renderable->getMesh()->destroyed()) {
+            entry.renderable->getMesh()->destroy();
+        }
+        entry.renderable->remove();
+    }
+    for (const std::shared_ptr<Material> &material: materials) {
+        material->cleanUp();
+    }
+    PipelineCache::waitIdle();
+    for (const std::shared_ptr<ShaderObject> &shader: shaders) {
         if (!shader->hasDeleted()) {
             shader->cleanUp();
         }
-        for (const auto &[material, renderables]: materialMap) {
-            material->cleanUp();
-            for (const std::shared_ptr<Renderable> &renderable: renderables) {
-                if (!renderable->getMesh()->destroyed()) {
-                    renderable->getMesh()->destroy();
-                }
-                renderable->remove();
-            }
-        }
     }
     for (auto buffer: buffers) {
         destroyAllocatedBuffer(&buffer);
@@ -945,7 +1453,22 @@ void XTPVulkan::cleanUp() {
     for (auto sampler : samplers) {
         vkDestroySampler(device, sampler, nullptr);
     }
-    toRender.clear();
+    renderables.clear();
+    materials.clear();
+    shaders.clear();
+    shaderIds.clear();
+    materialIds.clear();
+    meshIds.clear();
+    freeMeshIds.clear();
+    frameGraph.cleanUp();
+    IndirectBatcher::cleanUp();
+    BindlessTable::cleanUp();
+    MeshPool::cleanUp();
+    TransientAllocator::cleanUp();
+    GpuProfiler::cleanUp();
+    GpuStatistics::cleanUp();
+    PipelineCache::cleanUp();
+    UploadManager::cleanUp();
     allocatorPool->Flip();
     allocatorPool.reset();
 
@@ -965,11 +1488,19 @@ void XTPVulkan::cleanUp() {
     }
 
     vkDestroyCommandPool(device, commandPool, nullptr);
+    for (const auto &framePools: secondaryCommandPools) {
+        for (const VkCommandPool pool: framePools) {
+            vkDestroyCommandPool(device, pool, nullptr);
+        }
+    }
+    recordingChunkCount = 0;
 
     cleanupSwapchain();
 
-    logger->logDebug("Destroying Vulkan Surface");
-    vkDestroySurfaceKHR(instance, surface, nullptr);
+    if (!headless) {
+        logger->logDebug("Destroying Vulkan Surface");
+        vkDestroySurfaceKHR(instance, surface, nullptr);
+    }
 
     vmaDestroyAllocator(allocator);
     logger->logDebug("Destroying Vulkan Device");
@@ -1001,23 +1532,59 @@ std::string XTPVulkan::makeListOf(const std::vector<const char *> &elements) {
 void XTPVulkan::addShader(const std::shared_ptr<ShaderObject> &shader) {
     ZoneScopedN("XTPVulkan::addShader");
     shader->init();
-    toRender.insert({shader, {}});
+    registerShader(shader);
 }
 
 void XTPVulkan::addMaterial(const std::shared_ptr<Material> &material, std::shared_ptr<ShaderObject> &shader) {
     ZoneScopedN("XTPVulkan::addMaterial");
-    toRender.at(shader).insert({material, {}});
+    registerShader(shader);
+    registerMaterial(material);
 }
 
 void XTPVulkan::addRenderable(const std::shared_ptr<Renderable> &renderable) {
     ZoneScopedN("XTPVulkan::addRenderable");
-    if (toRender.count(renderable->getShader()) == 0) {
-        toRender.insert({renderable->getShader(), {}});
+    std::lock_guard lock(addedRenderablesMutex);
+    addedRenderables.push_back(renderable);
+}
+
+uint32_t XTPVulkan::registerShader(const std::shared_ptr<ShaderObject> &shader) {
+    const auto [iterator, inserted] = shaderIds.try_emplace(shader.get(), static_cast<uint32_t>(shaders.size()));
+    if (inserted) {
+        shaders.emplace_back(shader);
+    }
+    return iterator->second;
+}
+
+uint32_t XTPVulkan::registerMaterial(const std::shared_ptr<Material> &material) {
+    const auto [iterator, inserted] = materialIds.try_emplace(material.get(), static_cast<uint32_t>(materials.size()));
+    if (inserted) {
+        materials.emplace_back(material);
     }
-    if (toRender.at(renderable->getShader()).count(renderable->getMaterial()) == 0) {
-        toRender.at(renderable->getShader()).insert({renderable->getMaterial(), {}});
+    return iterator->second;
+}
+
+uint32_t XTPVulkan::acquireMeshId(Mesh* mesh) {
+    const auto [iterator, inserted] = meshIds.try_emplace(mesh, MeshIdEntry{0, 0});
+    if (inserted) {
+        //Without freed ids, the other meshes hold every id below their count.
+        if (freeMeshIds.empty()) {
+            iterator->second.id = static_cast<uint32_t>(meshIds.size() - 1);
+        } else {
+            iterator->second.id = freeMeshIds.back();
+            freeMeshIds.pop_back();
+        }
+    }
+    ++iterator->second.users;
+    return iterator->second.id;
+}
+
+void XTPVulkan::releaseMeshId(Mesh* mesh) {
+    const auto iterator = meshIds.find(mesh);
+    if (iterator == meshIds.end() || --iterator->second.users > 0) {
+        return;
     }
-    toRender.at(renderable->getShader()).at(renderable->getMaterial()).emplace_back(renderable);
+    freeMeshIds.push_back(iterator->second.id);
+    meshIds.erase(iterator);
 }
 
 std::vector<VkImageView> XTPVulkan::createImageViews() {
@@ -1051,9 +1618,9 @@ std::vector<VkImageView> XTPVulkan::createImageViews() {
 
 void XTPVulkan::printAvailableDeviceExtensions() {
     ZoneScopedN("XTPVulkan::printAvailableDeviceExtensions");
-    logger->logDebug("Found " + std::to_string(availableDeviceExtensions.size()) + " Vulkan Device Extensions!");
+    logger->logDebug("Found {} Vulkan Device Extensions!", availableDeviceExtensions.size());
     for (VkExtensionProperties properties: availableDeviceExtensions) {
-        logger->logDebug("Found Vulkan Device Extension '" + std::string(properties.extensionName) + "'!");
+        logger->logDebug("Found Vulkan Device Extension '{}'!", properties.extensionName);
     }
 }
 
@@ -1155,7 +1722,10 @@ VkDevice XTPVulkan::createLogicalDevice() {
     ZoneScopedN("XTPVulkan::createLogicalDevice");
     logger->logDebug("Creating Vulkan Device Queue Create Info");
     float queuePriority = 1;
-    const std::set uniqueQueueFamilies = {queueIndices.graphicsFamily.value(), queueIndices.presentFamily.value()};
+    std::set uniqueQueueFamilies = {queueIndices.graphicsFamily.value(), queueIndices.presentFamily.value()};
+    if (queueIndices.transferFamily.has_value()) {
+        uniqueQueueFamilies.insert(queueIndices.transferFamily.value());
+    }
     std::vector<VkDeviceQueueCreateInfo> infos(uniqueQueueFamilies.size());
 
     uint32_t i = 0;
@@ -1183,12 +1753,25 @@ VkDevice XTPVulkan::createLogicalDevice() {
         }
     }
 
-    enabledDeviceExtensions.emplace_back("VK_KHR_swapchain");
+    if (!headless) {
+        enabledDeviceExtensions.emplace_back("VK_KHR_swapchain");
+    }
 
     for (const std::string &extension: VulkanRenderInfo::INSTANCE->getRequiredDeviceExtensions()) {
         enabledDeviceExtensions.emplace_back(extension.c_str());
     }
 
+    //Gives GpuStatistics the driver's view of each heap's usage and budget, instead of VMA's estimate.
+    for (const auto [extensionName, specVersion]: availableDeviceExtensions) {
+        if (strcmp(extensionName, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME) == 0) {
+            GpuStatistics::memoryBudgetSupported = true;
+            if (std::find(enabledDeviceExtensions.begin(), enabledDeviceExtensions.end(),
+                          VK_EXT_MEMORY_BUDGET_EXTENSION_NAME) == enabledDeviceExtensions.end()) {
+                enabledDeviceExtensions.emplace_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+            }
+        }
+    }
+
     for (const std::string &enabledDeviceExtension: enabledDeviceExtensions) {
         bool isPresent = false;
         for (const auto [extensionName, specVersion]: getVkDeviceExtensionInfo()) {
@@ -1199,13 +1782,26 @@ VkDevice XTPVulkan::createLogicalDevice() {
         }
 
         if (!isPresent) {
-            logger->logCritical("Unable To Find The Required Device Extension '" + enabledDeviceExtension + "'!",
-                                false);
+            logger->logCritical("Unable To Find The Required Device Extension '{}'!", false, enabledDeviceExtension);
         }
     }
 
 
-    const VkPhysicalDeviceFeatures features = VulkanRenderInfo::INSTANCE->getPhysicalDeviceFeatures();
+    VkPhysicalDeviceFeatures features = VulkanRenderInfo::INSTANCE->getPhysicalDeviceFeatures();
+
+    //Enabled whenever available, since the IndirectBatcher can only issue one draw per batch with both of them.
+    VkPhysicalDeviceFeatures supportedFeatures;
+    vkGetPhysicalDeviceFeatures(gpu, &supportedFeatures);
+    features.multiDrawIndirect |= supportedFeatures.multiDrawIndirect;
+    features.drawIndirectFirstInstance |= supportedFeatures.drawIndirectFirstInstance;
+    //Also enabled whenever available, compressed textures are only loaded if their format is supported.
+    features.textureCompressionBC |= supportedFeatures.textureCompressionBC;
+    //And for GpuStatistics, which can only query passes with secondary command buffers if queries can be inherited.
+    features.pipelineStatisticsQuery |= supportedFeatures.pipelineStatisticsQuery;
+    features.inheritedQueries |= supportedFeatures.inheritedQueries;
+    GpuStatistics::pipelineStatisticsSupported = features.pipelineStatisticsQuery;
+    GpuStatistics::inheritedQueriesSupported = features.inheritedQueries;
+    IndirectBatcher::useMultiDrawIndirect = features.multiDrawIndirect && features.drawIndirectFirstInstance;
 
     std::vector<const char *> cstrVec;
     cstrVec.reserve(enabledDeviceExtensions.size()); // Reserve space to avoid multiple reallocations
@@ -1219,6 +1815,44 @@ VkDevice XTPVulkan::createLogicalDevice() {
     VkPhysicalDeviceVulkan12Features fs{};
     fs.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
     fs.bufferDeviceAddress = true;
+    fs.timelineSemaphore = true;
+
+    //The BindlessTable needs update after bind for sampled images, and partially bound, non uniformly indexed arrays.
+    VkPhysicalDeviceVulkan12Features supportedFeatures12 {};
+    supportedFeatures12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    VkPhysicalDeviceFeatures2 supportedFeatures2 {};
+    supportedFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    supportedFeatures2.pNext = &supportedFeatures12;
+    vkGetPhysicalDeviceFeatures2(gpu, &supportedFeatures2);
+    BindlessTable::enabled = VulkanRenderInfo::INSTANCE->useBindlessTable() && supportedFeatures12.descriptorIndexing &&
+                             supportedFeatures12.runtimeDescriptorArray &&
+                             supportedFeatures12.descriptorBindingPartiallyBound &&
+                             supportedFeatures12.descriptorBindingSampledImageUpdateAfterBind &&
+                             supportedFeatures12.descriptorBindingUpdateUnusedWhilePending &&
+                             supportedFeatures12.shaderSampledImageArrayNonUniformIndexing;
+    if (BindlessTable::enabled) {
+        fs.descriptorIndexing = VK_TRUE;
+        fs.runtimeDescriptorArray = VK_TRUE;
+        fs.descriptorBindingPartiallyBound = VK_TRUE;
+        fs.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+        fs.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+        fs.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+    } else if (VulkanRenderInfo::INSTANCE->useBindlessTable()) {
+        logger->logWarning("Descriptor Indexing Isn't Supported, The Bindless Table Is Disabled!");
+    }
+
+    VkPhysicalDeviceSynchronization2FeaturesKHR synchronization2Features {};
+    synchronization2Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES_KHR;
+    synchronization2Features.synchronization2 = VK_TRUE;
+    fs.pNext = &synchronization2Features;
+
+    VkPhysicalDeviceDynamicRenderingFeaturesKHR dynamicRenderingFeatures {};
+    dynamicRenderingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR;
+    dynamicRenderingFeatures.dynamicRendering = VK_TRUE;
+    if (dynamicRendering) {
+        dynamicRenderingFeatures.pNext = fs.pNext;
+        fs.pNext = &dynamicRenderingFeatures;
+    }
 
     VkPhysicalDeviceHostQueryResetFeatures resetFeatures;
     resetFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_HOST_QUERY_RESET_FEATURES;
@@ -1257,6 +1891,10 @@ VkDevice XTPVulkan::createLogicalDevice() {
     vkGetDeviceQueue(device, queueIndices.presentFamily.value_or(0), 0, &presentQueue);
     XTPVulkan::presentQueue = presentQueue;
 
+    if (queueIndices.transferFamily.has_value()) {
+        vkGetDeviceQueue(device, queueIndices.transferFamily.value(), 0, &transferQueue);
+    }
+
     return device;
 }
 
@@ -1272,10 +1910,11 @@ VkRenderPass XTPVulkan::createRenderPass() {
     colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
     colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_STORE;
     colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    colorAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    //Offscreen images are never presented, so leave them ready to be copied out instead.
+    colorAttachment.finalLayout = headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
 
     VkAttachmentDescription depthAttachment{};
-    depthAttachment.format = VK_FORMAT_D32_SFLOAT;
+    depthAttachment.format = DEPTH_FORMAT;
     depthAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
     depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
     depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
@@ -1327,58 +1966,6 @@ VkRenderPass XTPVulkan::createRenderPass() {
     return renderPass;
 }
 
-void XTPVulkan::mergeMeshes(const std::vector<std::shared_ptr<Renderable> > &renderables,
-                            AllocatedBuffer &mergedVertexBuffer, AllocatedBuffer &mergedIndexBuffer) {
-    ZoneScopedN("XTPVulkan::mergeMeshes");
-    uint32_t total_vertices = 0;
-
-    uint32_t total_indices = 0;
-
-    const std::vector<Mesh> meshes;
-
-    for (auto &m: renderables) {
-        Mesh mesh{};
-        mesh.firstIndex = total_indices;
-        mesh.firstVertex = total_vertices;
-
-        total_vertices += m->getMesh()->getVertexCount();
-        total_indices += m->getMesh()->getIndexCount();
-    }
-
-    constexpr uint32_t vertexSize = sizeof(renderables[0]->getMesh()->getFirstVertex());
-
-    mergedVertexBuffer = createSimpleBuffer(total_vertices * vertexSize,
-                                            VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-                                            VMA_MEMORY_USAGE_GPU_ONLY);
-
-    mergedIndexBuffer = createSimpleBuffer(total_indices * sizeof(uint32_t),
-                                           VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
-                                           VMA_MEMORY_USAGE_GPU_ONLY);
-
-    immediateSubmit([&](VkCommandBuffer cmd) {
-        for (int i = 0; i < meshes.size(); ++i) {
-            const Mesh mesh = meshes[i];
-            Renderable *renderable = renderables[i].get();
-
-            VkBufferCopy vertexCopy;
-            vertexCopy.dstOffset = mesh.firstVertex * vertexSize;
-            vertexCopy.size = renderable->getMesh()->getVertexCount() * vertexSize;
-            vertexCopy.srcOffset = 0;
-
-            vkCmdCopyBuffer(cmd, renderable->getMesh()->getVertexBuffer().internalBuffer,
-                            mergedVertexBuffer.internalBuffer, 1, &vertexCopy);
-
-            VkBufferCopy indexCopy;
-            indexCopy.dstOffset = mesh.firstIndex * sizeof(uint32_t);
-            indexCopy.size = renderable->getMesh()->getIndexCount() * sizeof(uint32_t);
-            indexCopy.srcOffset = 0;
-
-            vkCmdCopyBuffer(cmd, renderable->getMesh()->getIndexBuffer().internalBuffer,
-                            mergedIndexBuffer.internalBuffer, 1, &indexCopy);
-        }
-    });
-}
-
 VkSwapchainKHR XTPVulkan::createSwapchain() {
     ZoneScopedN("XTPVulkan::createSwapchain");
     SwapChainSupportDetails swapChainSupport = querySwapChainSupport(gpu);
@@ -1439,8 +2026,34 @@ VkSwapchainKHR XTPVulkan::createSwapchain() {
     return swapchain;
 }
 
+void XTPVulkan::createOffscreenTargets() {
+    ZoneScopedN("XTPVulkan::createOffscreenTargets");
+    int width = 0, height = 0;
+    XTPWindowing::windowBackend->getFramebufferSize(&width, &height);
+
+    swapchainImageFormat = VK_FORMAT_B8G8R8A8_UNORM;
+    swapchainExtent = {static_cast<uint32_t>(width), static_cast<uint32_t>(height)};
+
+    const uint32_t imageCount = VulkanRenderInfo::INSTANCE->getMaxFramesInFlight();
+    offscreenImages.resize(imageCount);
+    swapchainImages.resize(imageCount);
+    swapchainImageViews.resize(imageCount);
+
+    for (uint32_t i = 0; i < imageCount; ++i) {
+        offscreenImages[i] = createImage(swapchainExtent.width, swapchainExtent.height, swapchainImageFormat,
+                                         VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+                                         VK_IMAGE_ASPECT_COLOR_BIT);
+        swapchainImages[i] = offscreenImages[i].image;
+        swapchainImageViews[i] = offscreenImages[i].imageView;
+    }
+}
+
 void XTPVulkan::createFramebuffers() {
     ZoneScopedN("XTPVulkan::createFramebuffers");
+    //Dynamic rendering draws straight into the image views, so there is nothing to recreate on resize.
+    if (dynamicRendering) {
+        return;
+    }
     swapchainFramebuffers.resize(swapchainImageViews.size());
 
     for (size_t i = 0; i < swapchainImageViews.size(); i++) {
@@ -1564,7 +2177,7 @@ VkSurfaceFormatKHR XTPVulkan::chooseSwapSurfaceFormat(const std::vector<VkSurfac
     ZoneScopedN("XTPVulkan::chooseSwapSurfaceFormat");
     logger->logDebug("Choosing Swap Surface Format!");
     for (const VkSurfaceFormatKHR availableFormat: availableFormats) {
-        logger->logDebug("Found Surface Format " + VkFormatParser::toStringVkFormat(availableFormat.format));
+        logger->logDebug("Found Surface Format {}", VkFormatParser::toStringVkFormat(availableFormat.format));
         if (availableFormat.format == VK_FORMAT_B8G8R8A8_UNORM && availableFormat.colorSpace ==
             VK_COLOR_SPACE_SRGB_NONLINEAR_KHR) {
             return availableFormat;
@@ -1639,8 +2252,7 @@ VkPhysicalDevice XTPVulkan::pickPhysicalDevice(QueueFamilyIndices &queueFamilyIn
         deviceScore = score;
         queueFamilyIndices = indices;
         foundSuitablePhysicalDevice = true;
-        logger->logDebug(
-            "Found New Best Physical Device '" + std::string(deviceProperties.deviceName) + "', Using This Device!");
+        logger->logDebug("Found New Best Physical Device '{}', Using This Device!", deviceProperties.deviceName);
     }
 
     if (foundSuitablePhysicalDevice && deviceScore != 0 && device.has_value()) return device.value();
@@ -1686,9 +2298,7 @@ uint32_t XTPVulkan::getDeviceScore(VkPhysicalDevice physicalDevice, QueueFamilyI
 
     uint32_t score = VulkanRenderInfo::INSTANCE->getDeviceScore(physicalDevice, deviceProperties, deviceFeatures,
                                                                 supportedExtensions);
-    logger->logDebug(
-        "Found Physical Device '" + std::string(deviceProperties.deviceName) + "' With Score Rating " +
-        std::to_string(score) + "!");
+    logger->logDebug("Found Physical Device '{}' With Score Rating {}!", deviceProperties.deviceName, score);
 
     score += indices.graphicsScore;
     score += indices.gresentScore;
@@ -1702,11 +2312,14 @@ bool XTPVulkan::isDeviceSuitable([[maybe_unused]] VkPhysicalDevice device,
                                  [[maybe_unused]] const std::vector<std::string> &extensions,
                                  const QueueFamilyIndices &indices) {
     ZoneScopedN("XTPVulkan::isDeviceSuitable");
+    if (headless) {
+        return indices.isComplete();
+    }
     const auto [capabilities, formats, presentModes] = querySwapChainSupport(device);
     const bool adequateSwapchain = !formats.empty() && !presentModes.empty();
 
     if (!adequateSwapchain) {
-        logger->logDebug("Swapchain for device '" + std::string(properties.deviceName) + "' inadequate!");
+        logger->logDebug("Swapchain for device '{}' inadequate!", properties.deviceName);
     }
 
     return indices.isComplete() && adequateSwapchain;
@@ -1737,7 +2350,7 @@ XTPVulkan::findQueueFamilies(VkPhysicalDevice device, const std::string &deviceN
 
     vkGetPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount, queueFamilies.data());
 
-    if (printDebug) logger->logDebug(std::to_string(queueFamilyCount) + " Queue Families Found!");
+    if (printDebug) logger->logDebug("{} Queue Families Found!", queueFamilyCount);
     uint32_t i = 0;
     for (VkQueueFamilyProperties queueFamily: queueFamilies) {
         if (VulkanRenderInfo::INSTANCE->isQueueFamilySuitable(queueFamily)) {
@@ -1745,16 +2358,13 @@ XTPVulkan::findQueueFamilies(VkPhysicalDevice device, const std::string &deviceN
                 const uint32_t graphicsScore = VulkanRenderInfo::INSTANCE->getQueueFamilyGraphicsScore(queueFamily);
                 if (printDebug)
                     logger->logDebug(
-                        "Found Queue Family #" + std::to_string(i) + " With Graphics Score " +
-                        std::to_string(graphicsScore) + " For Device '" + deviceName +
-                        "'. This Queue Supports: " + getQueueCaps(queueFamily));
+                        "Found Queue Family #{} With Graphics Score {} For Device '{}'. This Queue Supports: {}", i,
+                        graphicsScore, deviceName, getQueueCaps(queueFamily));
 
                 if (graphicsScore > indices.graphicsScore) {
                     if (printDebug)
-                        logger->logDebug(
-                            "Found New Best Graphics Queue Family (#" + std::to_string(graphicsScore) + ") For Device '"
-                            +
-                            deviceName + "'");
+                        logger->logDebug("Found New Best Graphics Queue Family (#{}) For Device '{}'", graphicsScore,
+                                         deviceName);
                     indices.graphicsFamily = i;
 
                     indices.graphicsScore = graphicsScore;
@@ -1762,20 +2372,21 @@ XTPVulkan::findQueueFamilies(VkPhysicalDevice device, const std::string &deviceN
             }
 
             VkBool32 presentSupport = false;
-            vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport);
+            if (headless) {
+                //Nothing is ever presented, so the graphics queue doubles as the "present" queue.
+                presentSupport = (queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) != 0;
+            } else {
+                vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport);
+            }
             if (presentSupport) {
                 const uint32_t presentScore = VulkanRenderInfo::INSTANCE->getQueueFamilyPresentScore(queueFamily);
                 if (printDebug)
                     logger->logDebug(
-                        "Found Queue Family #" + std::to_string(i) + " With Present Score " +
-                        std::to_string(presentScore) + " For Device '" + deviceName +
-                        "'. This Queue Supports: " + getQueueCaps(queueFamily));
+                        "Found Queue Family #{} With Present Score {} For Device '{}'. This Queue Supports: {}", i,
+                        presentScore, deviceName, getQueueCaps(queueFamily));
                 if (presentScore > indices.gresentScore) {
                     if (printDebug)
-                        logger->logDebug(
-                            "Found New Best Present Queue Family (#" + std::to_string(i) + ") For Device '" + deviceName
-                            +
-                            "'");
+                        logger->logDebug("Found New Best Present Queue Family (#{}) For Device '{}'", i, deviceName);
 
                     indices.presentFamily = i;
                     indices.gresentScore = presentScore;
@@ -1783,6 +2394,15 @@ XTPVulkan::findQueueFamilies(VkPhysicalDevice device, const std::string &deviceN
             }
         }
 
+        //Dedicated transfer families usually map to the DMA engines, which can copy while the graphics queue is busy.
+        if ((queueFamily.queueFlags & VK_QUEUE_TRANSFER_BIT) &&
+            !(queueFamily.queueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)) &&
+            !indices.transferFamily.has_value()) {
+            if (printDebug)
+                logger->logDebug("Found Dedicated Transfer Queue Family #{} For Device '{}'", i, deviceName);
+            indices.transferFamily = i;
+        }
+
         i++;
     }
 
@@ -1945,9 +2565,9 @@ VkInstance XTPVulkan::createVulkanInstance() {
         throw std::runtime_error("Unable To Initialize Vulkan");
     }
 
-    logger->logDebug("Created Vulkan Instance With The Following Extensions: " + makeListOf(cstrVec));
+    logger->logDebug("Created Vulkan Instance With The Following Extensions: {}", makeListOf(cstrVec));
 #ifdef ISDEBUG
-    logger->logDebug("Created Vulkan Instance With The Following Validation Layers: " + makeListOf(enabledLayers));
+    logger->logDebug("Created Vulkan Instance With The Following Validation Layers: {}", makeListOf(enabledLayers));
 #endif
 
     return instance;
@@ -1956,11 +2576,11 @@ VkInstance XTPVulkan::createVulkanInstance() {
 void XTPVulkan::printAvailableVulkanProperties() {
     ZoneScopedN("XTPVulkan::printAvailableVulkanProperties");
     for (auto [extensionName, specVersion]: availableInstanceExtensions) {
-        logger->logDebug("Found Vulkan Instance Extension '" + std::string(extensionName) + "'!");
+        logger->logDebug("Found Vulkan Instance Extension '{}'!", extensionName);
     }
 
     for (auto [layerName, specVersion, implementationVersion, description]: availableValidationLayers) {
-        logger->logDebug("Found Vulkan Validation Layer '" + std::string(layerName) + "'!");
+        logger->logDebug("Found Vulkan Validation Layer '{}'!", layerName);
     }
 }
 
@@ -1990,7 +2610,7 @@ bool XTPVulkan::ensureAllValidationLayersPresent(const std::vector<VkLayerProper
         if (foundLayer) continue;
 
         hasEncounteredMissingLayer = true;
-        logger->logError("Could Not Find Requested Vulkan Validation Layer '" + validationLayer + "'!", false);
+        logger->logError("Could Not Find Requested Vulkan Validation Layer '{}'!", false, validationLayer);
     }
 
     return !hasEncounteredMissingLayer;
@@ -2025,7 +2645,7 @@ std::vector<std::string> XTPVulkan::findAllVulkanInstanceExtensions(VkInstanceCr
             }
         }
         if (!isPresent) {
-            logger->logCritical("Unable To Find The Required Instance Extension '" + enabledInstanceExtension + "'!");
+            logger->logCritical("Unable To Find The Required Instance Extension '{}'!", true, enabledInstanceExtension);
             throw std::runtime_error("Failed To Find A Required Instance Extension");
         }
     }
@@ -2063,7 +2683,7 @@ std::vector<VkExtensionProperties> XTPVulkan::getVkInstanceExtensionInfo() {
     ZoneScopedN("XTPVulkan::getVkInstanceExtensionInfo");
     uint32_t extensionCount = getVkInstanceExtensionCount();
 
-    logger->logDebug("Found " + std::to_string(extensionCount) + " Vulkan Instance Extensions!");
+    logger->logDebug("Found {} Vulkan Instance Extensions!", extensionCount);
 
     std::vector<VkExtensionProperties> extensionProperties(extensionCount);
     vkEnumerateInstanceExtensionProperties(nullptr, &extensionCount, extensionProperties.data());
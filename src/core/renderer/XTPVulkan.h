@@ -4,7 +4,9 @@
 #define ImDrawIdx unsigned int
 #include <vk_mem_alloc.h>
 
+#include <mutex>
 #include <set>
+#include <unordered_map>
 #include <cstdint> // Necessary for uint32_t
 #include "AllocatedImage.h"
 #include "descriptor_allocator.h"
@@ -14,12 +16,20 @@
 #include "VulkanRenderInfo.h"
 #include "glm/glm.hpp"
 #include "renderable/Renderable.h"
+#include "JobSystem.h"
+#include "UploadManager.h"
+#include "GpuStatistics.h"
+#include "graph/RenderGraph.h"
 
 struct AllocatedImage;
+struct CompressedTexture;
+struct GltfModel;
 
 struct QueueFamilyIndices {
     std::optional<uint32_t> graphicsFamily;
     std::optional<uint32_t> presentFamily;
+    //Only set if the device has a queue family that supports transfers but neither graphics nor compute.
+    std::optional<uint32_t> transferFamily;
     uint32_t graphicsScore {0};
     uint32_t gresentScore {0};
 
@@ -32,6 +42,41 @@ struct SwapChainSupportDetails {
     std::vector<VkPresentModeKHR> presentModes;
 };
 
+//Timings of the most recently drawn frame. gpuNanos is the GPU time of the previous frame drawn into the same frame slot,
+//or -1 if it is unavailable (e.g. XTP_USE_ADVANCED_TIMING is disabled).
+struct FrameTimings {
+    uint64_t fenceWaitNanos;
+    uint64_t recordNanos;
+    uint64_t submitNanos;
+    uint64_t gpuNanos;
+};
+
+//A single renderable in the order it is drawn this frame, along with the shader and material it is drawn with.
+struct DrawItem {
+    ShaderObject* shader;
+    Material* material;
+    Renderable* renderable;
+    uint64_t sortKey;
+};
+
+//A renderable, along with the state it is drawn with. Everything but the renderable is filled in once it is initialized.
+struct RenderableEntry {
+    std::shared_ptr<Renderable> renderable;
+    ShaderObject* shader;
+    Material* material;
+    Mesh* mesh;
+    uint32_t shaderId;
+    uint32_t materialId;
+    uint32_t meshId;
+    bool initialized;
+};
+
+//A mesh's sort key id, and how many renderable entries draw the mesh.
+struct MeshIdEntry {
+    uint32_t id;
+    uint32_t users;
+};
+
 struct SceneRenderData {
     glm::mat4 projectionMatrix;
     glm::mat4 viewMatrix;
@@ -52,6 +97,9 @@ public:
     static VkExtent2D swapchainExtent;
     static std::vector<VkImageView> swapchainImageViews;
     static std::vector<VkFramebuffer> swapchainFramebuffers;
+    //Only used when the window backend is headless, in which case these replace the swapchain images.
+    static std::vector<AllocatedImage> offscreenImages;
+    static bool headless;
     static std::vector<VkExtensionProperties> availableInstanceExtensions;
     static std::vector<VkExtensionProperties> availableDeviceExtensions;
     static std::vector<VkLayerProperties> availableValidationLayers;
@@ -85,23 +133,70 @@ public:
     static uint32_t mostRecentFrameRendered;
     static VkQueue graphicsQueue;
     static VkQueue presentQueue;
+    static VkQueue transferQueue;
+    //Held around every vkQueueSubmit and vkQueuePresentKHR, since the UploadManager can submit from any thread that
+    //uploads and queues must be externally synchronized.
+    static std::mutex queueMutex;
+    //VK_NULL_HANDLE if dynamicRendering is true, along with the swapchain framebuffers.
     static VkRenderPass renderPass;
+    //If true, frames are drawn with VK_KHR_dynamic_rendering instead of renderPass.
+    static bool dynamicRendering;
+    static PFN_vkCmdBeginRenderingKHR cmdBeginRendering;
+    static PFN_vkCmdEndRenderingKHR cmdEndRendering;
+    static PFN_vkCmdPipelineBarrier2KHR cmdPipelineBarrier2;
+    //Records every pass of the frame when dynamicRendering is true. frameColor and frameDepth are the scene's attachments
+    //in the frame currently being recorded.
+    static RenderGraph frameGraph;
+    static RenderGraphResource frameColor;
+    static RenderGraphResource frameDepth;
+    static constexpr VkFormat DEPTH_FORMAT = VK_FORMAT_D32_SFLOAT;
     static VkSurfaceKHR surface;
     static VkSwapchainKHR swapchain;
     static VkCommandPool commandPool;
     static std::vector<VkCommandBuffer> commandBuffers;
+    //Indexed by frame, then by recording slot. Each slot is recorded by one thread at a time, so every slot has its own pool.
+    static std::vector<std::vector<VkCommandPool>> secondaryCommandPools;
+    static std::vector<std::vector<VkCommandBuffer>> secondaryCommandBuffers;
+    //How many chunks the draw list is recorded in on the JobSystem, or 0 if it is recorded on the render thread alone.
+    static uint32_t recordingChunkCount;
+    static std::vector<DrawItem> drawList;
     static std::vector<VkSemaphore> imageAvailableSemaphores;
     static std::vector<VkSemaphore> renderFinishedSemaphores;
     static std::vector<VkFence> inFlightFences;
     static uint32_t currentFrameIndex;
+    //How far the frame is between the last two ticks, and whether a tick finished since the last frame. Set by XTP
+    //before every frame, they stay at 1 and true if VulkanRenderInfo::interpolateTickState() is off.
+    static float tickInterpolationAlpha;
+    static bool tickedSinceLastFrame;
     static bool initialized;
     static std::vector<AllocatedBuffer> buffers;
-    static std::unordered_map<std::shared_ptr<ShaderObject>, std::unordered_map<std::shared_ptr<Material>, std::vector<std::shared_ptr<Renderable>>>> toRender;
+    static std::vector<std::shared_ptr<ShaderObject>> shaders;
+    static std::vector<std::shared_ptr<Material>> materials;
+    //Removed renderables are swapped with the last one, so the order of this list changes over time. Only used on the
+    //render thread.
+    static std::vector<RenderableEntry> renderables;
+    //What the tick thread ticks. The render thread replaces it whenever renderables changes, so it has to be read with
+    //std::atomic_load.
+    static std::shared_ptr<const std::vector<std::shared_ptr<Renderable>>> tickRenderables;
+    //Renderables added since the last frame started. They are moved into renderables when the next one does.
+    static std::vector<std::shared_ptr<Renderable>> addedRenderables;
+    static std::mutex addedRenderablesMutex;
+    static std::unordered_map<ShaderObject*, uint32_t> shaderIds;
+    static std::unordered_map<Material*, uint32_t> materialIds;
+    //Released once no renderable draws the mesh anymore, so a new mesh at the same address gets a fresh entry and the
+    //ids stay below the number of meshes in use. Freed ids are reused from freeMeshIds.
+    static std::unordered_map<Mesh*, MeshIdEntry> meshIds;
+    static std::vector<uint32_t> freeMeshIds;
     static VmaAllocator allocator;
     static VkPhysicalDeviceProperties gpuProperties;
     static std::vector<AllocatedImage> allLoadedImages;
     static std::vector<VkSampler> samplers;
+    //Only used with renderPass. With dynamic rendering the depth image is a transient image of frameGraph.
     static AllocatedImage depthImage;
+    static FrameTimings lastFrameTimings;
+    //Updated once the frame's fence has been waited on, see GpuStatistics. Only read it from the render thread, e.g. in a
+    //FrameEvent.
+    static GpuFrameStatistics lastGpuStatistics;
 
     static void drawFrame();
 
@@ -144,13 +239,19 @@ public:
                               addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT, bool useAnisotropy = true, float maxAnisotropy = -1,
                               VkBorderColor borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK);
 
+    //KTX2 and DDS files are loaded as block compressed images with the mip levels they contain, imageFormat then only
+    //deciding whether DDS files that don't say so themselves are sRGB. Anything else is decoded to imageFormat, with a
+    //full mip chain generated for it.
     static AllocatedImage createImage(const char *path, VkFormat imageFormat = VK_FORMAT_R8G8B8A8_SRGB);
 
 
     static AllocatedImage createDepthImage();
 
     static AllocatedImage createImage(uint32_t width, uint32_t height, VkFormat imageFormat, VkImageUsageFlags usage, VkImageAspectFlags
-                                      aspectFlags);
+                                      aspectFlags, uint32_t mipLevels = 1);
+
+    //Uploads every mip level stored in the texture as is.
+    static AllocatedImage createCompressedImage(const CompressedTexture &texture);
 
     static void init();
 
@@ -158,9 +259,25 @@ public:
 
     static void recordCommandBuffers(VkCommandBuffer commandBuffer, uint32_t imageIndex, uint32_t frameIndex);
 
+    static void prepareDrawList();
+
+    //Begins drawing into the swapchain image, with either a render pass or dynamic rendering.
+    static void beginRendering(VkCommandBuffer commandBuffer, uint32_t imageIndex, bool secondaryContents);
+
+    static void endRendering(VkCommandBuffer commandBuffer, uint32_t imageIndex);
+
+    //Declares the frame's passes and compiles frameGraph. recordScene draws the scene into frameColor and frameDepth.
+    static void buildFrameGraph(uint32_t imageIndex, RenderGraph::RecordFunction &&recordScene);
+
+    static void recordDraws(VkCommandBuffer commandBuffer, size_t first, size_t last, uint32_t imageIndex);
+
+    static void recordSecondaryCommandBuffers(VkCommandBuffer commandBuffer, uint32_t imageIndex, uint32_t frameIndex);
+
+    static void createSecondaryCommandBuffers();
+
 #ifdef XTP_USE_GLTF_LOADING
-    //TODO: FINISH GLTF LOADING
-    static void loadGltfModel(bool isBinaryGltf, const char* path, const char* sceneToLoad = nullptr);
+    //Loads a glTF or GLB file into the mesh pool, see GltfLoader. Returns false and logs why if it can't be loaded.
+    static bool loadGltfModel(bool isBinaryGltf, const char* path, GltfModel &model, const char* sceneToLoad = nullptr);
 #endif
 
     static std::vector<VkCommandBuffer> createCommandBuffers();
@@ -169,6 +286,8 @@ public:
 
     static VkSwapchainKHR createSwapchain();
 
+    static void createOffscreenTargets();
+
     static void createFramebuffers();
 
     static void updateGlobalMatrices();
@@ -181,6 +300,8 @@ public:
 
     static uint64_t fetchRenderTimeNanos();
 
+    static uint64_t fetchFrameRenderTimeNanos(uint32_t frameIndex);
+
     static std::string makeListOf(const std::vector<const char*>& elements);
 
     static void addShader(const std::shared_ptr<ShaderObject> &shader);
@@ -189,6 +310,16 @@ public:
 
     static void addRenderable(const std::shared_ptr<Renderable> &renderable);
 
+    //Registers the shader or material if it hasn't been yet, and returns its index in shaders or materials.
+    static uint32_t registerShader(const std::shared_ptr<ShaderObject> &shader);
+
+    static uint32_t registerMaterial(const std::shared_ptr<Material> &material);
+
+    //Returns the mesh's sort key id, which stays the same until every acquireMeshId has been matched by a releaseMeshId.
+    static uint32_t acquireMeshId(Mesh* mesh);
+
+    static void releaseMeshId(Mesh* mesh);
+
     static std::vector<VkImageView> createImageViews();
 
     static void printAvailableDeviceExtensions();
@@ -199,12 +330,6 @@ public:
 
     template <class T> static AllocatedBuffer createSimpleBuffer(std::vector<T> data, VkBufferUsageFlags usage, VmaMemoryUsage memoryUsage, bool record = true);
 
-    struct Mesh {
-        uint32_t firstIndex;
-        uint32_t firstVertex;
-    };
-
-
     [[nodiscard]] static AllocatedBuffer createSimpleBuffer(VkDeviceSize bufferSize, VkBufferUsageFlags usage, VmaMemoryUsage memoryUsage, bool record = true);
 
     static void destroyAllocatedBuffer(AllocatedBuffer* buffer);
@@ -222,27 +347,19 @@ public:
 
         buf = createSimpleBuffer(bufferSize, usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_GPU_ONLY);
 
-        AllocatedBuffer staging = createSimpleBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_ONLY, false);
-        void* map = staging.info.pMappedData;
-        memcpy(map, data.data(), staging.info.size);
-
-        copyBuffer(staging, buf, bufferSize);
-
-        destroyAllocatedBuffer(&staging);
+        UploadManager::uploadBuffer(data.data(), bufferSize, buf);
 
         return buf;
     }
 
 
+    //Records the copy into the UploadManager's current batch, so it has only happened once that batch completes.
     static void copyBuffer(AllocatedBuffer srcBuffer, AllocatedBuffer dstBuffer, VkDeviceSize size);
 
     static VkDevice createLogicalDevice();
 
     static VkRenderPass createRenderPass();
 
-    static void mergeMeshes(const std::vector<std::shared_ptr<Renderable>> &renderables, AllocatedBuffer &mergedVertexBuffer, AllocatedBuffer
-                            &mergedIndexBuffer);
-
     static VkPresentModeKHR chooseSwapPresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes);
 
     static VkExtent2D chooseSwapExtent(const VkSurfaceCapabilitiesKHR& capabilities);
@@ -2,6 +2,7 @@
 #define BUFFERMANAGER_H
 #include <vector>
 
+#include "TransientAllocator.h"
 #include "VulkanRenderInfo.h"
 #include "XTPVulkan.h"
 
@@ -17,6 +18,13 @@ public:
     }
 
     void onFrame(const uint32_t frameIndex) {
+        //Transient memory doesn't outlive the frame it was allocated in, so the value is copied every frame.
+        if (transient) {
+            const TransientAllocation allocation = TransientAllocator::allocate(frameIndex, size);
+            memcpy(allocation.data, &bufferValue, size);
+            transientAddresses[frameIndex] = allocation.gpuAddress;
+            return;
+        }
         if (shouldUpdateBuffers[frameIndex]) {
             //Recreate buffer if the size grew.
             if (size > buffers[frameIndex].info.size) {
@@ -33,10 +41,16 @@ public:
         }
     }
 
+    //Not available for transient buffer managers, use getAddress instead.
     [[nodiscard]] AllocatedBuffer* getBuffer(const uint32_t frameIndex) {
         return &buffers[frameIndex];
     }
 
+    //Only valid after onFrame has been called for the frame.
+    [[nodiscard]] VkDeviceAddress getAddress(const uint32_t frameIndex) const {
+        return transient ? transientAddresses[frameIndex] : buffers[frameIndex].gpuAddress;
+    }
+
     BufferManager(): size(0), bufferUsage(0), memoryUsage() {}
 
     explicit BufferManager(const uint32_t size, VkBufferUsageFlags bufferUsage, VmaMemoryUsage memoryUsage, uint32_t binding, uint32_t set): bufferUsage(bufferUsage), memoryUsage(memoryUsage), size(size) {
@@ -52,12 +66,20 @@ public:
         }
     }
 
+    //Backs the value onto the TransientAllocator instead of creating a buffer per frame in flight.
+    explicit BufferManager(const uint32_t size): size(size), bufferUsage(TransientAllocator::BUFFER_USAGE),
+        memoryUsage(VMA_MEMORY_USAGE_CPU_TO_GPU), transient(true) {
+        transientAddresses = std::vector<VkDeviceAddress>(VulkanRenderInfo::INSTANCE->getMaxFramesInFlight());
+    }
+
 private:
     std::vector<AllocatedBuffer> buffers {};
     uint32_t size;
     VkBufferUsageFlags bufferUsage;
     VmaMemoryUsage memoryUsage;
     std::vector<bool> shouldUpdateBuffers {};
+    bool transient = false;
+    std::vector<VkDeviceAddress> transientAddresses {};
 };
 
 
@@ -0,0 +1,199 @@
+#include "MeshPool.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "XTPVulkan.h"
+
+AllocatedBuffer MeshPool::vertexBuffer;
+AllocatedBuffer MeshPool::indexBuffer;
+VkDeviceSize MeshPool::vertexCapacity;
+VkDeviceSize MeshPool::indexCapacity;
+PoolRangeAllocator MeshPool::vertexRanges;
+PoolRangeAllocator MeshPool::indexRanges;
+std::vector<std::vector<MeshAllocation>> MeshPool::pendingFrees;
+std::vector<MeshAllocation> MeshPool::releasedAllocations;
+std::mutex MeshPool::releasedMutex;
+thread_local VkCommandBuffer MeshPool::boundCommandBuffer;
+
+bool PoolRangeAllocator::allocate(const VkDeviceSize size, const VkDeviceSize alignment, VkDeviceSize &offset) {
+    for (size_t i = 0; i < freeRanges.size(); ++i) {
+        const Range range = freeRanges[i];
+        const VkDeviceSize alignedOffset = (range.offset + alignment - 1) / alignment * alignment;
+        if (alignedOffset + size > range.offset + range.size) {
+            continue;
+        }
+
+        offset = alignedOffset;
+        freeRanges.erase(freeRanges.begin() + i);
+        //Whatever is left on either side of the allocation stays free.
+        if (alignedOffset + size < range.offset + range.size) {
+            freeRanges.insert(freeRanges.begin() + i, {alignedOffset + size, range.offset + range.size - alignedOffset - size});
+        }
+        if (alignedOffset > range.offset) {
+            freeRanges.insert(freeRanges.begin() + i, {range.offset, alignedOffset - range.offset});
+        }
+        return true;
+    }
+    return false;
+}
+
+void PoolRangeAllocator::free(const VkDeviceSize offset, const VkDeviceSize size) {
+    if (size == 0) {
+        return;
+    }
+    auto next = std::lower_bound(freeRanges.begin(), freeRanges.end(), offset,
+                                 [](const Range &range, const VkDeviceSize value) { return range.offset < value; });
+    next = freeRanges.insert(next, {offset, size});
+
+    if (next + 1 != freeRanges.end() && next->offset + next->size == (next + 1)->offset) {
+        next->size += (next + 1)->size;
+        freeRanges.erase(next + 1);
+    }
+    if (next != freeRanges.begin() && (next - 1)->offset + (next - 1)->size == next->offset) {
+        (next - 1)->size += next->size;
+        freeRanges.erase(next);
+    }
+}
+
+void PoolRangeAllocator::grow(const VkDeviceSize oldCapacity, const VkDeviceSize newCapacity) {
+    free(oldCapacity, newCapacity - oldCapacity);
+}
+
+void PoolRangeAllocator::clear() {
+    freeRanges.clear();
+}
+
+MeshAllocation MeshPool::allocate(const void *vertexData, const VkDeviceSize vertexByteSize, const uint32_t vertexStride,
+                                  const std::vector<uint32_t> &indices) {
+    ZoneScopedN("MeshPool::allocate");
+    if (pendingFrees.empty()) {
+        pendingFrees = std::vector<std::vector<MeshAllocation>>(VulkanRenderInfo::INSTANCE->getMaxFramesInFlight());
+    }
+
+    MeshAllocation allocation {};
+    allocation.vertexByteSize = vertexByteSize;
+    allocation.indexByteSize = indices.size() * sizeof(uint32_t);
+
+    //Vertex offsets are counted in vertices, so the mesh has to start on a multiple of its own stride.
+    if (!vertexRanges.allocate(vertexByteSize, vertexStride, allocation.vertexByteOffset)) {
+        growBuffer(vertexBuffer, vertexCapacity, vertexRanges, vertexByteSize + vertexStride,
+                   VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+        vertexRanges.allocate(vertexByteSize, vertexStride, allocation.vertexByteOffset);
+    }
+    if (!indexRanges.allocate(allocation.indexByteSize, sizeof(uint32_t), allocation.indexByteOffset)) {
+        growBuffer(indexBuffer, indexCapacity, indexRanges, allocation.indexByteSize, VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
+        indexRanges.allocate(allocation.indexByteSize, sizeof(uint32_t), allocation.indexByteOffset);
+    }
+
+    allocation.vertexOffset = static_cast<int32_t>(allocation.vertexByteOffset / vertexStride);
+    allocation.firstIndex = static_cast<uint32_t>(allocation.indexByteOffset / sizeof(uint32_t));
+
+    UploadManager::uploadBuffer(vertexData, vertexByteSize, vertexBuffer, allocation.vertexByteOffset);
+    UploadManager::uploadBuffer(indices.data(), allocation.indexByteSize, indexBuffer, allocation.indexByteOffset);
+
+    return allocation;
+}
+
+void MeshPool::reserve(const VkDeviceSize vertexByteSize, const VkDeviceSize indexByteSize) {
+    ZoneScopedN("MeshPool::reserve");
+    VkDeviceSize offset;
+    if (vertexByteSize > 0) {
+        if (vertexRanges.allocate(vertexByteSize, 1, offset)) {
+            vertexRanges.free(offset, vertexByteSize);
+        } else {
+            growBuffer(vertexBuffer, vertexCapacity, vertexRanges, vertexByteSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+        }
+    }
+    if (indexByteSize > 0) {
+        if (indexRanges.allocate(indexByteSize, 1, offset)) {
+            indexRanges.free(offset, indexByteSize);
+        } else {
+            growBuffer(indexBuffer, indexCapacity, indexRanges, indexByteSize, VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
+        }
+    }
+}
+
+void MeshPool::free(const MeshAllocation &allocation) {
+    std::lock_guard lock(releasedMutex);
+    releasedAllocations.emplace_back(allocation);
+}
+
+void MeshPool::onFrame(const uint32_t frameIndex) {
+    if (pendingFrees.empty()) {
+        return;
+    }
+    for (const MeshAllocation &allocation: pendingFrees[frameIndex]) {
+        vertexRanges.free(allocation.vertexByteOffset, allocation.vertexByteSize);
+        indexRanges.free(allocation.indexByteOffset, allocation.indexByteSize);
+    }
+    pendingFrees[frameIndex].clear();
+
+    //Frames still in flight may draw them, and all of those finish before this frame's fence is waited on again.
+    std::lock_guard lock(releasedMutex);
+    pendingFrees[frameIndex].swap(releasedAllocations);
+}
+
+void MeshPool::bind(VkCommandBuffer commandBuffer) {
+    if (vertexBuffer.internalBuffer == VK_NULL_HANDLE) {
+        return;
+    }
+    constexpr VkDeviceSize offset = 0;
+    vkCmdBindVertexBuffers(commandBuffer, 0, 1, &vertexBuffer.internalBuffer, &offset);
+    vkCmdBindIndexBuffer(commandBuffer, indexBuffer.internalBuffer, 0, VK_INDEX_TYPE_UINT32);
+    boundCommandBuffer = commandBuffer;
+}
+
+void MeshPool::bindIfNeeded(VkCommandBuffer commandBuffer) {
+    if (boundCommandBuffer != commandBuffer) {
+        bind(commandBuffer);
+    }
+}
+
+void MeshPool::invalidateBinding() {
+    boundCommandBuffer = VK_NULL_HANDLE;
+}
+
+void MeshPool::cleanUp() {
+    if (vertexBuffer.internalBuffer != VK_NULL_HANDLE) {
+        XTPVulkan::destroyAllocatedBuffer(&vertexBuffer);
+    }
+    if (indexBuffer.internalBuffer != VK_NULL_HANDLE) {
+        XTPVulkan::destroyAllocatedBuffer(&indexBuffer);
+    }
+    vertexBuffer = {};
+    indexBuffer = {};
+    vertexCapacity = 0;
+    indexCapacity = 0;
+    vertexRanges.clear();
+    indexRanges.clear();
+    pendingFrees.clear();
+    std::lock_guard lock(releasedMutex);
+    releasedAllocations.clear();
+}
+
+void MeshPool::growBuffer(AllocatedBuffer &buffer, VkDeviceSize &capacity, PoolRangeAllocator &ranges,
+                          const VkDeviceSize requiredSize, const VkBufferUsageFlags usage) {
+    ZoneScopedN("MeshPool::growBuffer");
+    const VkDeviceSize newCapacity = std::max({capacity * 2, capacity + requiredSize,
+                                               VulkanRenderInfo::INSTANCE->getInitialMeshPoolSize()});
+
+    AllocatedBuffer newBuffer = XTPVulkan::createSimpleBuffer(newCapacity, usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+                                                              VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_GPU_ONLY, false);
+
+    if (buffer.internalBuffer != VK_NULL_HANDLE) {
+        XTPVulkan::logger->logDebug("Growing Mesh Pool Buffer To {} Bytes", newCapacity);
+        //Uploads into the old buffer that haven't been submitted yet have to land before it is copied.
+        UploadManager::waitIdle();
+        //immediateSubmit waits for the queue to go idle, so no frame can still be using the old buffer afterwards.
+        XTPVulkan::immediateSubmit([&](VkCommandBuffer cmd) {
+            const VkBufferCopy copy {0, 0, capacity};
+            vkCmdCopyBuffer(cmd, buffer.internalBuffer, newBuffer.internalBuffer, 1, &copy);
+        });
+        XTPVulkan::destroyAllocatedBuffer(&buffer);
+    }
+
+    ranges.grow(capacity, newCapacity);
+    buffer = newBuffer;
+    capacity = newCapacity;
+}
@@ -0,0 +1,93 @@
+#ifndef MESHPOOL_H
+#define MESHPOOL_H
+
+#include <mutex>
+#include <vector>
+
+#include "AllocatedBuffer.h"
+
+//Where a mesh lives inside the mesh pool. vertexOffset is in vertices of the mesh's own stride, so it can be passed
+//straight to vkCmdDrawIndexed.
+struct MeshAllocation {
+    VkDeviceSize vertexByteOffset;
+    VkDeviceSize vertexByteSize;
+    VkDeviceSize indexByteOffset;
+    VkDeviceSize indexByteSize;
+    int32_t vertexOffset;
+    uint32_t firstIndex;
+};
+
+//A first fit allocator over a range of bytes. Freed ranges are merged with their neighbours.
+class PoolRangeAllocator {
+public:
+    struct Range {
+        VkDeviceSize offset;
+        VkDeviceSize size;
+    };
+
+    //Returns false if there is no free range big enough.
+    bool allocate(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize &offset);
+
+    void free(VkDeviceSize offset, VkDeviceSize size);
+
+    //Adds the bytes in [oldCapacity, newCapacity) as free space.
+    void grow(VkDeviceSize oldCapacity, VkDeviceSize newCapacity);
+
+    void clear();
+
+private:
+    std::vector<Range> freeRanges;
+};
+
+//Every SimpleMesh is sub-allocated from one large device local vertex buffer and one large index buffer, so all of them
+//can be drawn after binding the pool once per command buffer. Both buffers grow when they run out of space.
+class MeshPool {
+public:
+    static AllocatedBuffer vertexBuffer;
+    static AllocatedBuffer indexBuffer;
+
+    //Copies the vertices and indices into the pool. vertexStride is the size of a single vertex.
+    static MeshAllocation allocate(const void* vertexData, VkDeviceSize vertexByteSize, uint32_t vertexStride,
+                                   const std::vector<uint32_t> &indices);
+
+    //Makes sure a single contiguous range of each size is free, growing the buffers at most once. Loading many meshes
+    //at once after reserving their total size avoids growing, and copying, the pool again and again.
+    static void reserve(VkDeviceSize vertexByteSize, VkDeviceSize indexByteSize);
+
+    //The space is only reused once every frame that might still be drawing the mesh has finished. Can be called from any
+    //thread, since meshes may be destroyed wherever their last reference is dropped.
+    static void free(const MeshAllocation &allocation);
+
+    //Called on the render thread once the fence of the given frame has been waited on.
+    static void onFrame(uint32_t frameIndex);
+
+    //Binds the pool, even if it was already bound to this command buffer.
+    static void bind(VkCommandBuffer commandBuffer);
+
+    //Binds the pool unless it is still bound to this command buffer.
+    static void bindIfNeeded(VkCommandBuffer commandBuffer);
+
+    //Must be called whenever other vertex or index buffers are bound, since the pool is no longer bound afterwards.
+    static void invalidateBinding();
+
+    static void cleanUp();
+
+private:
+    static VkDeviceSize vertexCapacity;
+    static VkDeviceSize indexCapacity;
+    static PoolRangeAllocator vertexRanges;
+    static PoolRangeAllocator indexRanges;
+    //Indexed by the frame that was about to be recorded when the allocation reached it.
+    static std::vector<std::vector<MeshAllocation>> pendingFrees;
+    //Freed since the last onFrame(). Only onFrame() knows which frame is being recorded next, so they wait here.
+    static std::vector<MeshAllocation> releasedAllocations;
+    static std::mutex releasedMutex;
+    static thread_local VkCommandBuffer boundCommandBuffer;
+
+    static void growBuffer(AllocatedBuffer &buffer, VkDeviceSize &capacity, PoolRangeAllocator &ranges,
+                           VkDeviceSize requiredSize, VkBufferUsageFlags usage);
+};
+
+
+
+#endif //MESHPOOL_H
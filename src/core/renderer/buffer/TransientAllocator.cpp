@@ -0,0 +1,92 @@
+#include "TransientAllocator.h"
+
+#include <algorithm>
+
+#include "VulkanRenderInfo.h"
+#include "XTPVulkan.h"
+
+std::vector<TransientAllocator::TransientFrame> TransientAllocator::frames;
+std::mutex TransientAllocator::overflowMutex;
+
+void TransientAllocator::init() {
+    ZoneScopedN("TransientAllocator::init");
+    const VkDeviceSize size = VulkanRenderInfo::INSTANCE->getTransientBufferSize();
+
+    //The frames hold atomics, so the vector is only ever created with its final size.
+    frames = std::vector<TransientFrame>(VulkanRenderInfo::INSTANCE->getMaxFramesInFlight());
+    for (TransientFrame &frame: frames) {
+        frame.buffer = XTPVulkan::createSimpleBuffer(size, BUFFER_USAGE, VMA_MEMORY_USAGE_CPU_TO_GPU, false);
+        frame.capacity = size;
+        frame.head = 0;
+        frame.overflowHead = 0;
+        frame.overflowCapacity = 0;
+    }
+}
+
+void TransientAllocator::cleanUp() {
+    for (TransientFrame &frame: frames) {
+        XTPVulkan::destroyAllocatedBuffer(&frame.buffer);
+        for (AllocatedBuffer &buffer: frame.overflowBuffers) {
+            XTPVulkan::destroyAllocatedBuffer(&buffer);
+        }
+    }
+    frames.clear();
+}
+
+void TransientAllocator::beginFrame(const uint32_t frameIndex) {
+    ZoneScopedN("TransientAllocator::beginFrame");
+    TransientFrame &frame = frames[frameIndex];
+
+    const VkDeviceSize used = frame.head.load(std::memory_order_relaxed);
+    if (used > frame.capacity) {
+        //The fence of this frame has been waited on, so nothing can still be reading the old buffer.
+        const VkDeviceSize newCapacity = std::max(used, frame.capacity * 2);
+        XTPVulkan::logger->logDebug("Growing Transient Buffer #{} To {} Bytes", frameIndex, newCapacity);
+
+        XTPVulkan::destroyAllocatedBuffer(&frame.buffer);
+        frame.buffer = XTPVulkan::createSimpleBuffer(newCapacity, BUFFER_USAGE, VMA_MEMORY_USAGE_CPU_TO_GPU, false);
+        frame.capacity = newCapacity;
+    }
+
+    for (AllocatedBuffer &buffer: frame.overflowBuffers) {
+        XTPVulkan::destroyAllocatedBuffer(&buffer);
+    }
+    frame.overflowBuffers.clear();
+    frame.overflowHead = 0;
+    frame.overflowCapacity = 0;
+    frame.head.store(0, std::memory_order_relaxed);
+}
+
+TransientAllocation TransientAllocator::allocate(const uint32_t frameIndex, const VkDeviceSize size,
+                                                 const VkDeviceSize alignment) {
+    TransientFrame &frame = frames[frameIndex];
+
+    //Rounding the size up keeps every offset aligned without having to compare and swap the head.
+    const VkDeviceSize alignedSize = (size + alignment - 1) & ~(alignment - 1);
+    const VkDeviceSize offset = frame.head.fetch_add(alignedSize, std::memory_order_relaxed);
+    if (offset + alignedSize <= frame.capacity) {
+        return sliceOf(frame.buffer, offset);
+    }
+
+    std::lock_guard lock(overflowMutex);
+    if (frame.overflowHead + alignedSize > frame.overflowCapacity) {
+        const VkDeviceSize overflowSize = std::max(alignedSize, frame.capacity);
+        frame.overflowBuffers.emplace_back(
+            XTPVulkan::createSimpleBuffer(overflowSize, BUFFER_USAGE, VMA_MEMORY_USAGE_CPU_TO_GPU, false));
+        frame.overflowHead = 0;
+        frame.overflowCapacity = overflowSize;
+    }
+
+    const TransientAllocation allocation = sliceOf(frame.overflowBuffers.back(), frame.overflowHead);
+    frame.overflowHead += alignedSize;
+    return allocation;
+}
+
+TransientAllocation TransientAllocator::sliceOf(const AllocatedBuffer &buffer, const VkDeviceSize offset) {
+    return TransientAllocation {
+        static_cast<char*>(buffer.info.pMappedData) + offset,
+        buffer.gpuAddress + offset,
+        buffer.internalBuffer,
+        offset
+    };
+}
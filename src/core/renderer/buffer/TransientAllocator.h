@@ -0,0 +1,56 @@
+#ifndef TRANSIENTALLOCATOR_H
+#define TRANSIENTALLOCATOR_H
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "AllocatedBuffer.h"
+
+//A slice of a transient buffer. It is only valid until the frame it was allocated for starts being drawn again.
+struct TransientAllocation {
+    void* data;
+    VkDeviceAddress gpuAddress;
+    VkBuffer buffer;
+    VkDeviceSize offset;
+};
+
+//Hands out short-lived uniform/storage memory by bumping an offset into one large, persistently mapped buffer per frame
+//in flight, so per-object data costs an atomic add and a memcpy instead of an allocation of its own. Allocation is
+//thread safe. A frame that runs out of space falls back to overflow buffers, and its buffer is grown to fit everything
+//the next time it is drawn.
+class TransientAllocator {
+public:
+    static void init();
+
+    static void cleanUp();
+
+    //Called once the fence of the given frame has been waited on. Everything allocated for that frame is freed.
+    static void beginFrame(uint32_t frameIndex);
+
+    //alignment must be a power of two. The default is enough for anything read through a buffer device address.
+    static TransientAllocation allocate(uint32_t frameIndex, VkDeviceSize size, VkDeviceSize alignment = 16);
+
+    static constexpr VkBufferUsageFlags BUFFER_USAGE = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT |
+                                                       VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                                                       VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+
+private:
+    struct TransientFrame {
+        AllocatedBuffer buffer;
+        VkDeviceSize capacity;
+        std::atomic<VkDeviceSize> head;
+        std::vector<AllocatedBuffer> overflowBuffers;
+        VkDeviceSize overflowHead;
+        VkDeviceSize overflowCapacity;
+    };
+
+    static std::vector<TransientFrame> frames;
+    static std::mutex overflowMutex;
+
+    static TransientAllocation sliceOf(const AllocatedBuffer &buffer, VkDeviceSize offset);
+};
+
+
+
+#endif //TRANSIENTALLOCATOR_H
@@ -0,0 +1,574 @@
+#include "RenderGraph.h"
+
+#include <algorithm>
+
+#include "AllocatedImage.h"
+#include "GpuProfiler.h"
+#include "GpuStatistics.h"
+#include "Profiler.h"
+#include "VulkanRenderInfo.h"
+#include "XTPVulkan.h"
+
+//Accesses that make memory unavailable to later uses until a barrier makes it available again.
+static constexpr VkAccessFlags2 WRITE_ACCESS = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT |
+                                               VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+                                               VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT;
+
+static constexpr VkPipelineStageFlags2 SHADER_STAGES = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT |
+                                                       VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT |
+                                                       VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+
+static constexpr VkPipelineStageFlags2 DEPTH_STAGES = VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT |
+                                                      VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT;
+
+void RenderGraph::reset() {
+    resources.clear();
+    passes.clear();
+    finalImageBarriers.clear();
+}
+
+RenderGraphResource RenderGraph::importImage(const std::string &name, VkImage image, VkImageView view,
+                                             const VkImageAspectFlags aspect, const VkImageLayout currentLayout,
+                                             const VkPipelineStageFlags2 currentStages, const VkImageLayout finalLayout,
+                                             const VkPipelineStageFlags2 finalStages, const VkAccessFlags2 finalAccess) {
+    Resource resource {};
+    resource.name = name;
+    resource.isImage = true;
+    resource.image = image;
+    resource.view = view;
+    resource.aspect = aspect;
+    resource.finalLayout = finalLayout;
+    resource.finalStages = finalStages;
+    resource.finalAccess = finalAccess;
+    resource.state.layout = currentLayout;
+    resource.state.writeStages = currentStages;
+
+    resources.push_back(resource);
+    return static_cast<RenderGraphResource>(resources.size() - 1);
+}
+
+RenderGraphResource RenderGraph::importBuffer(const std::string &name, VkBuffer buffer,
+                                              const VkPipelineStageFlags2 currentStages) {
+    Resource resource {};
+    resource.name = name;
+    resource.buffer = buffer;
+    resource.state.writeStages = currentStages;
+
+    resources.push_back(resource);
+    return static_cast<RenderGraphResource>(resources.size() - 1);
+}
+
+RenderGraphResource RenderGraph::createImage(const std::string &name, const RenderGraphImageDescription &description) {
+    Resource resource {};
+    resource.name = name;
+    resource.isImage = true;
+    resource.transient = true;
+    resource.aspect = description.aspect;
+    resource.description = description;
+
+    resources.push_back(resource);
+    return static_cast<RenderGraphResource>(resources.size() - 1);
+}
+
+void RenderGraph::addPass(const std::string &name, const std::vector<RenderGraphUse> &uses, RecordFunction &&record) {
+    Pass pass {};
+    pass.name = name;
+    pass.uses = uses;
+    pass.record = std::move(record);
+    passes.push_back(std::move(pass));
+}
+
+void RenderGraph::compile() {
+    ZoneScopedN("RenderGraph::compile");
+    for (auto retired = retiredAllocations.begin(); retired != retiredAllocations.end();) {
+        if (--retired->compilesLeft == 0) {
+            destroyTransientImages(retired->images, retired->allocation);
+            retired = retiredAllocations.erase(retired);
+        } else {
+            ++retired;
+        }
+    }
+
+    for (Resource &resource: resources) {
+        resource.firstPass = UINT32_MAX;
+        resource.lastPass = 0;
+        resource.usedStages = VK_PIPELINE_STAGE_2_NONE;
+        resource.usedWriteAccess = VK_ACCESS_2_NONE;
+    }
+
+    for (uint32_t passIndex = 0; passIndex < passes.size(); ++passIndex) {
+        for (const auto [resourceIndex, access]: passes[passIndex].uses) {
+            if (resourceIndex >= resources.size()) {
+                XTPVulkan::logger->logCritical("Render Graph Pass '{}' Uses An Unknown Resource!", true,
+                                               passes[passIndex].name);
+            }
+            Resource &resource = resources[resourceIndex];
+
+            VkPipelineStageFlags2 stages;
+            VkAccessFlags2 accessFlags;
+            VkImageLayout layout;
+            bool write;
+            describeAccess(access, stages, accessFlags, layout, write);
+            if (resource.isImage != (layout != VK_IMAGE_LAYOUT_UNDEFINED)) {
+                XTPVulkan::logger->logCritical(
+                    "Render Graph Pass '{}' Uses '{}' With An Access Of The Wrong Resource Type!", true,
+                    passes[passIndex].name, resource.name);
+            }
+
+            resource.firstPass = std::min(resource.firstPass, passIndex);
+            resource.lastPass = std::max(resource.lastPass, passIndex);
+            resource.usedStages |= stages;
+            if (write) {
+                resource.usedWriteAccess |= accessFlags & WRITE_ACCESS;
+            }
+            if (resource.transient) {
+                resource.description.usage |= getImageUsage(access);
+            }
+        }
+    }
+
+    std::vector<TransientImage> requested;
+    for (Resource &resource: resources) {
+        if (!resource.transient || resource.firstPass == UINT32_MAX) {
+            continue;
+        }
+        resource.transientIndex = static_cast<uint32_t>(requested.size());
+
+        TransientImage transientImage {};
+        transientImage.description = resource.description;
+        transientImage.firstPass = resource.firstPass;
+        transientImage.lastPass = resource.lastPass;
+        requested.push_back(transientImage);
+    }
+
+    //Images and their placement only depend on the descriptions and lifetimes, so a graph that looks the same as last
+    //frame's keeps its images.
+    bool reuse = requested.size() == transientImages.size();
+    for (size_t i = 0; reuse && i < requested.size(); ++i) {
+        reuse = requested[i].description == transientImages[i].description &&
+                requested[i].firstPass == transientImages[i].firstPass &&
+                requested[i].lastPass == transientImages[i].lastPass;
+    }
+
+    if (!reuse) {
+        if (!transientImages.empty()) {
+            //Frames that are still in flight may be using the old images.
+            retiredAllocations.push_back({std::move(transientImages), transientAllocation,
+                                          VulkanRenderInfo::INSTANCE->getMaxFramesInFlight()});
+        }
+        transientImages.clear();
+        transientAllocation = VK_NULL_HANDLE;
+
+        if (!requested.empty()) {
+            allocateTransientImages(requested);
+        }
+        transientImages = std::move(requested);
+    }
+
+    std::vector<const Resource*> transientResources(transientImages.size());
+    for (const Resource &resource: resources) {
+        if (resource.transient && resource.firstPass != UINT32_MAX) {
+            transientResources[resource.transientIndex] = &resource;
+        }
+    }
+
+    //The first use of an image has to wait for everything that touched the same memory before it, in this frame or in
+    //the previous one.
+    for (TransientImage &transientImage: transientImages) {
+        transientImage.aliasStages = VK_PIPELINE_STAGE_2_NONE;
+        transientImage.aliasWriteAccess = VK_ACCESS_2_NONE;
+        for (size_t i = 0; i < transientImages.size(); ++i) {
+            const TransientImage &other = transientImages[i];
+            if (transientImage.offset < other.offset + other.size && other.offset < transientImage.offset + transientImage.size) {
+                transientImage.aliasStages |= transientResources[i]->usedStages;
+                transientImage.aliasWriteAccess |= transientResources[i]->usedWriteAccess;
+            }
+        }
+    }
+
+    for (Resource &resource: resources) {
+        if (!resource.transient || resource.firstPass == UINT32_MAX) {
+            continue;
+        }
+        const TransientImage &transientImage = transientImages[resource.transientIndex];
+        resource.image = transientImage.image;
+        resource.view = transientImage.view;
+        resource.state = {};
+        resource.state.writeStages = transientImage.aliasStages;
+        resource.state.writeAccess = transientImage.aliasWriteAccess;
+    }
+
+    computeBarriers();
+}
+
+void RenderGraph::computeBarriers() {
+    struct PassUse {
+        RenderGraphResource resource;
+        VkPipelineStageFlags2 stages;
+        VkAccessFlags2 access;
+        VkImageLayout layout;
+        bool write;
+    };
+
+    std::vector<PassUse> passUses;
+    for (Pass &pass: passes) {
+        pass.imageBarriers.clear();
+        pass.bufferBarriers.clear();
+
+        //A pass may use a resource more than once, as long as every use agrees on the layout.
+        passUses.clear();
+        for (const auto [resource, access]: pass.uses) {
+            PassUse use {resource};
+            describeAccess(access, use.stages, use.access, use.layout, use.write);
+
+            auto existing = std::find_if(passUses.begin(), passUses.end(),
+                                         [resource](const PassUse &other) { return other.resource == resource; });
+            if (existing == passUses.end()) {
+                passUses.push_back(use);
+                continue;
+            }
+            if (existing->layout != use.layout) {
+                XTPVulkan::logger->logCritical("Render Graph Pass '{}' Uses '{}' In Two Different Layouts!", true,
+                                               pass.name, resources[resource].name);
+            }
+            existing->stages |= use.stages;
+            existing->access |= use.access;
+            existing->write |= use.write;
+        }
+
+        for (const PassUse &use: passUses) {
+            Resource &resource = resources[use.resource];
+            ResourceState &state = resource.state;
+            const bool layoutChange = resource.isImage && state.layout != use.layout;
+
+            if (layoutChange || use.write) {
+                //Writes and layout transitions have to wait for every earlier use, but only earlier writes need their
+                //memory made available.
+                const VkPipelineStageFlags2 srcStages = state.writeStages | state.readStages;
+                if (layoutChange || srcStages != VK_PIPELINE_STAGE_2_NONE) {
+                    addBarrier(resource, srcStages, state.writeAccess, state.layout, use.stages, use.access, use.layout,
+                               pass.imageBarriers, pass.bufferBarriers);
+                }
+
+                state.layout = use.layout;
+                state.writeStages = use.stages;
+                state.writeAccess = use.write ? use.access & WRITE_ACCESS : VK_ACCESS_2_NONE;
+                state.readStages = use.write ? VK_PIPELINE_STAGE_2_NONE : use.stages;
+                state.readAccess = use.write ? VK_ACCESS_2_NONE : use.access;
+                continue;
+            }
+
+            //A read only needs a barrier if no earlier read in the same stages with the same accesses has waited already.
+            if (state.writeStages != VK_PIPELINE_STAGE_2_NONE &&
+                ((use.stages & ~state.readStages) != 0 || (use.access & ~state.readAccess) != 0)) {
+                addBarrier(resource, state.writeStages, state.writeAccess, state.layout, use.stages, use.access,
+                           state.layout, pass.imageBarriers, pass.bufferBarriers);
+            }
+            state.readStages |= use.stages;
+            state.readAccess |= use.access;
+        }
+    }
+
+    std::vector<VkBufferMemoryBarrier2> unusedBufferBarriers;
+    for (const Resource &resource: resources) {
+        if (!resource.isImage || resource.transient) {
+            continue;
+        }
+        const ResourceState &state = resource.state;
+        const VkImageLayout finalLayout = resource.finalLayout == VK_IMAGE_LAYOUT_UNDEFINED ? state.layout
+                                                                                            : resource.finalLayout;
+        if (finalLayout != state.layout || resource.finalStages != VK_PIPELINE_STAGE_2_NONE) {
+            addBarrier(resource, state.writeStages | state.readStages, state.writeAccess, state.layout,
+                       resource.finalStages, resource.finalAccess, finalLayout, finalImageBarriers,
+                       unusedBufferBarriers);
+        }
+    }
+}
+
+void RenderGraph::execute(VkCommandBuffer commandBuffer) {
+    ZoneScopedN("RenderGraph::execute");
+    const bool profiled = GpuProfiler::isRecording();
+    for (const Pass &pass: passes) {
+        if (profiled) {
+            GpuProfiler::beginZone(commandBuffer, Profiler::internName(pass.name));
+        }
+        GpuStatistics::beginPass(commandBuffer, pass.name);
+        if (!pass.imageBarriers.empty() || !pass.bufferBarriers.empty()) {
+            VkDependencyInfoKHR dependencyInfo {};
+            dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO_KHR;
+            dependencyInfo.imageMemoryBarrierCount = static_cast<uint32_t>(pass.imageBarriers.size());
+            dependencyInfo.pImageMemoryBarriers = pass.imageBarriers.data();
+            dependencyInfo.bufferMemoryBarrierCount = static_cast<uint32_t>(pass.bufferBarriers.size());
+            dependencyInfo.pBufferMemoryBarriers = pass.bufferBarriers.data();
+            XTPVulkan::cmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+        }
+        pass.record(commandBuffer);
+        GpuStatistics::endPass(commandBuffer);
+        if (profiled) {
+            GpuProfiler::endZone(commandBuffer);
+        }
+    }
+
+    if (!finalImageBarriers.empty()) {
+        VkDependencyInfoKHR dependencyInfo {};
+        dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO_KHR;
+        dependencyInfo.imageMemoryBarrierCount = static_cast<uint32_t>(finalImageBarriers.size());
+        dependencyInfo.pImageMemoryBarriers = finalImageBarriers.data();
+        XTPVulkan::cmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+    }
+}
+
+VkImage RenderGraph::getImage(const RenderGraphResource resource) const {
+    return resources[resource].image;
+}
+
+VkImageView RenderGraph::getImageView(const RenderGraphResource resource) const {
+    return resources[resource].view;
+}
+
+void RenderGraph::cleanUp() {
+    for (RetiredAllocation &retired: retiredAllocations) {
+        destroyTransientImages(retired.images, retired.allocation);
+    }
+    retiredAllocations.clear();
+
+    destroyTransientImages(transientImages, transientAllocation);
+    transientImages.clear();
+    transientAllocation = VK_NULL_HANDLE;
+}
+
+void RenderGraph::allocateTransientImages(std::vector<TransientImage> &requested) {
+    ZoneScopedN("RenderGraph::allocateTransientImages");
+    VkMemoryRequirements allocationRequirements {};
+    allocationRequirements.alignment = 1;
+    allocationRequirements.memoryTypeBits = UINT32_MAX;
+    std::vector<VkDeviceSize> alignments(requested.size());
+    VkDeviceSize unaliasedSize = 0;
+
+    for (size_t i = 0; i < requested.size(); ++i) {
+        TransientImage &transientImage = requested[i];
+
+        VkImageCreateInfo imageInfo {};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.extent = {transientImage.description.width, transientImage.description.height, 1};
+        imageInfo.mipLevels = 1;
+        imageInfo.arrayLayers = 1;
+        imageInfo.format = transientImage.description.format;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageInfo.usage = transientImage.description.usage;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+
+        if (vkCreateImage(XTPVulkan::device, &imageInfo, nullptr, &transientImage.image) != VK_SUCCESS) {
+            XTPVulkan::logger->logCritical("Failed To Create Transient Render Graph Image!");
+        }
+
+        VkMemoryRequirements requirements;
+        vkGetImageMemoryRequirements(XTPVulkan::device, transientImage.image, &requirements);
+        transientImage.size = requirements.size;
+        alignments[i] = requirements.alignment;
+        allocationRequirements.alignment = std::max(allocationRequirements.alignment, requirements.alignment);
+        allocationRequirements.memoryTypeBits &= requirements.memoryTypeBits;
+        unaliasedSize += requirements.size;
+    }
+
+    if (allocationRequirements.memoryTypeBits == 0) {
+        XTPVulkan::logger->logCritical("Transient Render Graph Images Have No Memory Type In Common!");
+    }
+
+    //Placing the biggest images first leaves the smaller ones to fill the gaps between them.
+    std::vector<size_t> order(requested.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&requested](const size_t a, const size_t b) {
+        return requested[a].size > requested[b].size;
+    });
+
+    std::vector<size_t> placed;
+    std::vector<std::pair<VkDeviceSize, VkDeviceSize>> occupied;
+    for (const size_t index: order) {
+        TransientImage &transientImage = requested[index];
+
+        //Only images that are alive during any of the same passes can't share memory with this one.
+        occupied.clear();
+        for (const size_t other: placed) {
+            const TransientImage &otherImage = requested[other];
+            if (transientImage.firstPass <= otherImage.lastPass && otherImage.firstPass <= transientImage.lastPass) {
+                occupied.emplace_back(otherImage.offset, otherImage.offset + otherImage.size);
+            }
+        }
+        std::sort(occupied.begin(), occupied.end());
+
+        VkDeviceSize offset = 0;
+        for (const auto [begin, end]: occupied) {
+            if (offset + transientImage.size <= begin) {
+                break;
+            }
+            offset = std::max(offset, (end + alignments[index] - 1) / alignments[index] * alignments[index]);
+        }
+
+        transientImage.offset = offset;
+        allocationRequirements.size = std::max(allocationRequirements.size, offset + transientImage.size);
+        placed.push_back(index);
+    }
+
+    VmaAllocationCreateInfo allocationInfo {};
+    allocationInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+
+    if (vmaAllocateMemory(XTPVulkan::allocator, &allocationRequirements, &allocationInfo, &transientAllocation,
+                          nullptr) != VK_SUCCESS) {
+        XTPVulkan::logger->logCritical("Failed To Allocate Memory For Transient Render Graph Images!");
+    }
+
+    for (size_t i = 0; i < requested.size(); ++i) {
+        TransientImage &transientImage = requested[i];
+        if (vmaBindImageMemory2(XTPVulkan::allocator, transientAllocation, transientImage.offset, transientImage.image,
+                                nullptr) != VK_SUCCESS) {
+            XTPVulkan::logger->logCritical("Failed To Bind Transient Render Graph Image Memory!");
+        }
+
+        AllocatedImage image {};
+        image.image = transientImage.image;
+        XTPVulkan::createImageView(image, transientImage.description.format, transientImage.description.aspect);
+        transientImage.view = image.imageView;
+    }
+
+    XTPVulkan::logger->logDebug("Allocated {} Bytes For {} Transient Render Graph Images, Instead Of {}",
+                                allocationRequirements.size, requested.size(), unaliasedSize);
+}
+
+void RenderGraph::destroyTransientImages(std::vector<TransientImage> &images, VmaAllocation allocation) {
+    for (const TransientImage &transientImage: images) {
+        vkDestroyImageView(XTPVulkan::device, transientImage.view, nullptr);
+        vkDestroyImage(XTPVulkan::device, transientImage.image, nullptr);
+    }
+    if (allocation != VK_NULL_HANDLE) {
+        vmaFreeMemory(XTPVulkan::allocator, allocation);
+    }
+}
+
+void RenderGraph::addBarrier(const Resource &resource, const VkPipelineStageFlags2 srcStages,
+                             const VkAccessFlags2 srcAccess, const VkImageLayout oldLayout,
+                             const VkPipelineStageFlags2 dstStages, const VkAccessFlags2 dstAccess,
+                             const VkImageLayout newLayout, std::vector<VkImageMemoryBarrier2> &imageBarriers,
+                             std::vector<VkBufferMemoryBarrier2> &bufferBarriers) {
+    if (resource.isImage) {
+        VkImageMemoryBarrier2 barrier {};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2_KHR;
+        barrier.srcStageMask = srcStages;
+        barrier.srcAccessMask = srcAccess;
+        barrier.dstStageMask = dstStages;
+        barrier.dstAccessMask = dstAccess;
+        barrier.oldLayout = oldLayout;
+        barrier.newLayout = newLayout;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = resource.image;
+        barrier.subresourceRange = {resource.aspect, 0, VK_REMAINING_MIP_LEVELS, 0, VK_REMAINING_ARRAY_LAYERS};
+        imageBarriers.push_back(barrier);
+        return;
+    }
+
+    VkBufferMemoryBarrier2 barrier {};
+    barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2_KHR;
+    barrier.srcStageMask = srcStages;
+    barrier.srcAccessMask = srcAccess;
+    barrier.dstStageMask = dstStages;
+    barrier.dstAccessMask = dstAccess;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.buffer = resource.buffer;
+    barrier.offset = 0;
+    barrier.size = VK_WHOLE_SIZE;
+    bufferBarriers.push_back(barrier);
+}
+
+void RenderGraph::describeAccess(const RenderGraphAccess access, VkPipelineStageFlags2 &stages,
+                                 VkAccessFlags2 &accessFlags, VkImageLayout &layout, bool &write) {
+    //Buffer accesses keep the layout undefined.
+    layout = VK_IMAGE_LAYOUT_UNDEFINED;
+    write = false;
+
+    switch (access) {
+        case RenderGraphAccess::COLOR_ATTACHMENT_WRITE:
+            stages = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+            accessFlags = VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT;
+            layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+            write = true;
+            break;
+        case RenderGraphAccess::DEPTH_ATTACHMENT_WRITE:
+            stages = DEPTH_STAGES;
+            accessFlags = VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+            layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+            write = true;
+            break;
+        case RenderGraphAccess::DEPTH_ATTACHMENT_READ:
+            stages = DEPTH_STAGES;
+            accessFlags = VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
+            layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+            break;
+        case RenderGraphAccess::SHADER_SAMPLED_READ:
+            stages = SHADER_STAGES;
+            accessFlags = VK_ACCESS_2_SHADER_READ_BIT;
+            layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            break;
+        case RenderGraphAccess::STORAGE_READ:
+            stages = SHADER_STAGES;
+            accessFlags = VK_ACCESS_2_SHADER_READ_BIT;
+            layout = VK_IMAGE_LAYOUT_GENERAL;
+            break;
+        case RenderGraphAccess::STORAGE_WRITE:
+            stages = SHADER_STAGES;
+            accessFlags = VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT;
+            layout = VK_IMAGE_LAYOUT_GENERAL;
+            write = true;
+            break;
+        case RenderGraphAccess::TRANSFER_READ:
+            stages = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+            accessFlags = VK_ACCESS_2_TRANSFER_READ_BIT;
+            layout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+            break;
+        case RenderGraphAccess::TRANSFER_WRITE:
+            stages = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+            accessFlags = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+            layout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            write = true;
+            break;
+        case RenderGraphAccess::INDIRECT_READ:
+            stages = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT;
+            accessFlags = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT;
+            break;
+        case RenderGraphAccess::VERTEX_INPUT_READ:
+            stages = VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT;
+            accessFlags = VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_2_INDEX_READ_BIT;
+            break;
+        case RenderGraphAccess::UNIFORM_READ:
+            stages = SHADER_STAGES;
+            accessFlags = VK_ACCESS_2_UNIFORM_READ_BIT;
+            break;
+    }
+}
+
+VkImageUsageFlags RenderGraph::getImageUsage(const RenderGraphAccess access) {
+    switch (access) {
+        case RenderGraphAccess::COLOR_ATTACHMENT_WRITE:
+            return VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+        case RenderGraphAccess::DEPTH_ATTACHMENT_WRITE:
+        case RenderGraphAccess::DEPTH_ATTACHMENT_READ:
+            return VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+        case RenderGraphAccess::SHADER_SAMPLED_READ:
+            return VK_IMAGE_USAGE_SAMPLED_BIT;
+        case RenderGraphAccess::STORAGE_READ:
+        case RenderGraphAccess::STORAGE_WRITE:
+            return VK_IMAGE_USAGE_STORAGE_BIT;
+        case RenderGraphAccess::TRANSFER_READ:
+            return VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        case RenderGraphAccess::TRANSFER_WRITE:
+            return VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        default:
+            return 0;
+    }
+}
@@ -0,0 +1,171 @@
+#ifndef RENDERGRAPH_H
+#define RENDERGRAPH_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <vk_mem_alloc.h>
+
+//A handle to an image or buffer declared in a RenderGraph. Only valid until the graph is reset.
+using RenderGraphResource = uint32_t;
+
+//How a pass uses a resource. Each access maps to the stages, access flags and (for images) layout it needs.
+enum class RenderGraphAccess {
+    COLOR_ATTACHMENT_WRITE,
+    DEPTH_ATTACHMENT_WRITE,
+    DEPTH_ATTACHMENT_READ,
+    SHADER_SAMPLED_READ,
+    STORAGE_READ,
+    STORAGE_WRITE,
+    TRANSFER_READ,
+    TRANSFER_WRITE,
+    INDIRECT_READ,
+    VERTEX_INPUT_READ,
+    UNIFORM_READ
+};
+
+struct RenderGraphUse {
+    RenderGraphResource resource;
+    RenderGraphAccess access;
+};
+
+struct RenderGraphImageDescription {
+    uint32_t width;
+    uint32_t height;
+    VkFormat format;
+    VkImageUsageFlags usage;
+    VkImageAspectFlags aspect;
+
+    bool operator==(const RenderGraphImageDescription &other) const {
+        return width == other.width && height == other.height && format == other.format && usage == other.usage &&
+               aspect == other.aspect;
+    }
+};
+
+//Records a frame as a list of passes that declare which resources they read and write. compile() works out the
+//smallest set of synchronization2 barriers between them, batched into one vkCmdPipelineBarrier2 per pass, and places
+//transient images whose lifetimes don't overlap in the same memory. Transient images are kept while the graph declares
+//the same ones every frame, so a graph that doesn't change only recomputes its barriers.
+class RenderGraph {
+public:
+    using RecordFunction = std::function<void(VkCommandBuffer commandBuffer)>;
+
+    //Forgets every pass and resource. Transient images are kept until the next compile, in case they can be reused.
+    void reset();
+
+    //currentStages are the stages that have to finish before the image can be used, e.g. the stage the swapchain's
+    //acquire semaphore is waited on in. Once the graph has executed the image is left in finalLayout, and visible to
+    //finalAccess in finalStages.
+    RenderGraphResource importImage(const std::string &name, VkImage image, VkImageView view, VkImageAspectFlags aspect,
+                                    VkImageLayout currentLayout, VkPipelineStageFlags2 currentStages,
+                                    VkImageLayout finalLayout, VkPipelineStageFlags2 finalStages = VK_PIPELINE_STAGE_2_NONE,
+                                    VkAccessFlags2 finalAccess = VK_ACCESS_2_NONE);
+
+    RenderGraphResource importBuffer(const std::string &name, VkBuffer buffer,
+                                     VkPipelineStageFlags2 currentStages = VK_PIPELINE_STAGE_2_NONE);
+
+    //Owned by the graph. Its contents are undefined at the start of the first pass using it.
+    RenderGraphResource createImage(const std::string &name, const RenderGraphImageDescription &description);
+
+    void addPass(const std::string &name, const std::vector<RenderGraphUse> &uses, RecordFunction &&record);
+
+    void compile();
+
+    void execute(VkCommandBuffer commandBuffer);
+
+    [[nodiscard]] VkImage getImage(RenderGraphResource resource) const;
+
+    [[nodiscard]] VkImageView getImageView(RenderGraphResource resource) const;
+
+    //Destroys every transient image. Must only be called once the GPU is done with them.
+    void cleanUp();
+
+private:
+    struct ResourceState {
+        VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+        //The stages and accesses of the last write (or layout transition), which later uses have to wait for.
+        VkPipelineStageFlags2 writeStages = VK_PIPELINE_STAGE_2_NONE;
+        VkAccessFlags2 writeAccess = VK_ACCESS_2_NONE;
+        //Reads since the last write that have already waited for it. Reads don't need to wait for each other, but the
+        //next write has to wait for all of them.
+        VkPipelineStageFlags2 readStages = VK_PIPELINE_STAGE_2_NONE;
+        VkAccessFlags2 readAccess = VK_ACCESS_2_NONE;
+    };
+
+    struct Resource {
+        std::string name;
+        bool isImage;
+        bool transient;
+        VkImage image;
+        VkImageView view;
+        VkBuffer buffer;
+        VkImageAspectFlags aspect;
+        VkImageLayout finalLayout;
+        VkPipelineStageFlags2 finalStages;
+        VkAccessFlags2 finalAccess;
+        ResourceState state;
+        RenderGraphImageDescription description;
+        uint32_t transientIndex;
+        uint32_t firstPass;
+        uint32_t lastPass;
+        VkPipelineStageFlags2 usedStages;
+        VkAccessFlags2 usedWriteAccess;
+    };
+
+    struct Pass {
+        std::string name;
+        std::vector<RenderGraphUse> uses;
+        RecordFunction record;
+        std::vector<VkImageMemoryBarrier2> imageBarriers;
+        std::vector<VkBufferMemoryBarrier2> bufferBarriers;
+    };
+
+    //A transient image, along with where it lives inside the shared allocation.
+    struct TransientImage {
+        RenderGraphImageDescription description;
+        uint32_t firstPass;
+        uint32_t lastPass;
+        VkImage image;
+        VkImageView view;
+        VkDeviceSize offset;
+        VkDeviceSize size;
+        //Every stage and write access of every image sharing memory with this one, which its first use has to wait for.
+        VkPipelineStageFlags2 aliasStages;
+        VkAccessFlags2 aliasWriteAccess;
+    };
+
+    //Transient images from an older compile, destroyed once no frame in flight can be using them.
+    struct RetiredAllocation {
+        std::vector<TransientImage> images;
+        VmaAllocation allocation;
+        uint32_t compilesLeft;
+    };
+
+    std::vector<Resource> resources;
+    std::vector<Pass> passes;
+    std::vector<VkImageMemoryBarrier2> finalImageBarriers;
+    std::vector<TransientImage> transientImages;
+    VmaAllocation transientAllocation = VK_NULL_HANDLE;
+    std::vector<RetiredAllocation> retiredAllocations;
+
+    void allocateTransientImages(std::vector<TransientImage> &requested);
+
+    static void destroyTransientImages(std::vector<TransientImage> &images, VmaAllocation allocation);
+
+    static void addBarrier(const Resource &resource, VkPipelineStageFlags2 srcStages, VkAccessFlags2 srcAccess,
+                           VkImageLayout oldLayout, VkPipelineStageFlags2 dstStages, VkAccessFlags2 dstAccess,
+                           VkImageLayout newLayout, std::vector<VkImageMemoryBarrier2> &imageBarriers,
+                           std::vector<VkBufferMemoryBarrier2> &bufferBarriers);
+
+    void computeBarriers();
+
+    static void describeAccess(RenderGraphAccess access, VkPipelineStageFlags2 &stages, VkAccessFlags2 &accessFlags,
+                               VkImageLayout &layout, bool &write);
+
+    static VkImageUsageFlags getImageUsage(RenderGraphAccess access);
+};
+
+
+
+#endif //RENDERGRAPH_H
@@ -8,7 +8,9 @@
 #include "SimpleIndexBufferedRenderable.h"
 #include "XTPVulkan.h"
 
-class MergedMeshRenderable : SimpleRenderable {
+//Draws several meshes as a single renderable. Since pooled meshes all share the MeshPool's buffers, nothing is bound
+//between them, so this is about as cheap as drawing one mesh containing all of them.
+class MergedMeshRenderable : public SimpleRenderable {
 public:
     void remove() override {
     }
@@ -18,7 +20,7 @@ public:
     }
 
     std::shared_ptr<Mesh> getMesh() override {
-        return nullptr;
+        return meshes.empty() ? nullptr : meshes[0];
     }
 
     std::shared_ptr<Material> getMaterial() override {
@@ -29,32 +31,41 @@ public:
         return shader;
     }
 
-    std::vector<std::shared_ptr<Renderable>> renderables;
+    std::vector<std::shared_ptr<Mesh>> meshes;
     std::shared_ptr<ShaderObject> shader;
     std::shared_ptr<Material> material;
-    AllocatedBuffer vertexBuffer;
-    AllocatedBuffer indexBuffer;
 
-    MergedMeshRenderable(const std::shared_ptr<Material>& material, const std::shared_ptr<ShaderObject>& shader, const std::vector<std::shared_ptr<Renderable>>& renderables) {
+    MergedMeshRenderable(const std::shared_ptr<Material>& material, const std::shared_ptr<ShaderObject>& shader, const std::vector<std::shared_ptr<Mesh>>& meshes) {
         this->material = material;
         this->shader = shader;
-        this->renderables = renderables;
-        this->vertexBuffer = {};
-        this->indexBuffer = {};
+        this->meshes = meshes;
     }
 
+    //The renderer only initializes the first mesh, so the rest are initialized here.
     void createBuffers() override {
-        XTPVulkan::mergeMeshes(renderables, vertexBuffer, indexBuffer);
+        for (const auto& mesh : meshes) {
+            if (!mesh->initialized()) {
+                mesh->init();
+            }
+        }
     }
 
-    void addRenderable(const std::shared_ptr<Renderable>& renderable) {
-        XTPVulkan::destroyAllocatedBuffer(&vertexBuffer);
-        XTPVulkan::destroyAllocatedBuffer(&indexBuffer);
-        createBuffers();
+    //Only the new mesh is copied into the pool, the existing ones stay where they are.
+    void addMesh(const std::shared_ptr<Mesh>& mesh) {
+        if (initialized && !mesh->initialized()) {
+            mesh->init();
+        }
+        meshes.emplace_back(mesh);
     }
 
+    //Called before the meshes are drawn, e.g. to push constants.
+    virtual void prepareDraw(VkCommandBuffer commandBuffer, uint32_t imageIndex) {}
+
     void draw(VkCommandBuffer commandBuffer, uint32_t imageIndex) override {
-        //TODO
+        prepareDraw(commandBuffer, imageIndex);
+        for (const auto& mesh : meshes) {
+            mesh->draw(commandBuffer);
+        }
     }
 };
 
@@ -5,9 +5,20 @@
 #ifndef MESH_H
 #define MESH_H
 #include "buffer/AllocatedBuffer.h"
+#include "buffer/MeshPool.h"
+#include "glm/glm.hpp"
 
 struct Vertex {};
 
+//Bounds of a mesh in its own space. Meshes without valid bounds are never culled.
+struct MeshBounds {
+    glm::vec3 min {0};
+    glm::vec3 max {0};
+    glm::vec3 center {0};
+    float radius = 0;
+    bool valid = false;
+};
+
 class Mesh {
 public:
     virtual ~Mesh() = default;
@@ -30,6 +41,35 @@ public:
 
     virtual uint32_t getIndexCount() = 0;
 
+    virtual MeshBounds getBounds() {
+        return {};
+    }
+
+    //How many bytes init() uploads, counted against the AssetStreamer's per frame budget.
+    virtual VkDeviceSize getUploadSize() {
+        return 0;
+    }
+
+    //The index of the first index and the offset of the first vertex inside the buffers bound by bind().
+    virtual uint32_t getFirstIndex() {
+        return 0;
+    }
+
+    virtual int32_t getVertexOffset() {
+        return 0;
+    }
+
+    virtual void bind(VkCommandBuffer commandBuffer) {
+        getVertexBuffer().bind(commandBuffer);
+        getIndexBuffer().bind(commandBuffer);
+        MeshPool::invalidateBinding();
+    }
+
+    void draw(VkCommandBuffer commandBuffer, const uint32_t instanceCount = 1, const uint32_t firstInstance = 0) {
+        bind(commandBuffer);
+        vkCmdDrawIndexed(commandBuffer, getIndexCount(), instanceCount, getFirstIndex(), getVertexOffset(), firstInstance);
+    }
+
     virtual void tick() {}
 };
 
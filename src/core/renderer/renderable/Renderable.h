@@ -5,6 +5,7 @@
 #include <vulkan/vulkan_core.h>
 
 #include "Mesh.h"
+#include "glm/glm.hpp"
 
 class Material;
 class ShaderObject;
@@ -33,11 +34,30 @@ public:
 
     virtual void draw(VkCommandBuffer commandBuffer, uint32_t imageIndex) = 0;
 
-    virtual void tick() {} //Called on the tick thread
+    //Called on the tick thread, in parallel with other renderables on the JobSystem and with the render thread drawing
+    //the previous state. Anything draw() reads should be handed over in publishTickState, e.g. through a TickState. May
+    //still be called for a tick or two after the renderable has been removed.
+    virtual void tick() {}
+
+    //Called on the tick thread after every tick().
+    virtual void publishTickState() {}
+
+    //Called on the render thread at the start of every frame, before anything else reads the renderable's state.
+    virtual void acquireTickState() {}
 
     virtual std::shared_ptr<Mesh> getMesh() = 0;
 
     virtual std::shared_ptr<Material> getMaterial() = 0;
+
+    //Used if the renderable's shader draws indirectly, in which case draw() is never called, and for frustum culling.
+    virtual glm::mat4 getTransform() {
+        return glm::mat4(1);
+    }
+
+    //Whether getTransform() is up-to-date before draw() is called, so the renderable can be culled by its mesh's bounds.
+    virtual bool frustumCullable() {
+        return false;
+    }
 };
 
 
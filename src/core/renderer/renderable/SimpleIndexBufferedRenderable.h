@@ -3,6 +3,7 @@
 #define SIMPLEINDEXBUFFEREDRENDERABLE_H
 
 #include "SimpleRenderable.h"
+#include "TickState.h"
 #include "buffer/BufferManager.h"
 #include "glm/glm.hpp"
 #include "shader/SimpleShaderObject.h"
@@ -11,9 +12,13 @@
 template <class T> class SimpleIndexBufferedRenderable : public SimpleRenderable {
 public:
     BufferManager<glm::mat4> transformBuffer {};
+    //Written on the tick thread, and copied into transformBuffer at the start of the next frame, interpolated from the
+    //tick before if VulkanRenderInfo::interpolateTickState() is on.
+    TickState<glm::mat4> tickTransform;
 
     SimpleIndexBufferedRenderable(const std::shared_ptr<SimpleShaderObject>& shader, std::shared_ptr<Mesh> mesh, const glm::mat4 &initialTransform = {}):
-        mesh(std::move(mesh)), shader(shader) {
+        mesh(std::move(mesh)), shader(shader), tickTransform(initialTransform), previousTransform(initialTransform),
+        currentTransform(initialTransform), hasTransform(initialTransform != glm::mat4 {}) {
 
         transformBuffer.bufferValue = initialTransform;
         transformBuffer.markBuffersDirty();
@@ -37,18 +42,57 @@ public:
     virtual T getPushConstants(uint32_t frameIndex) = 0;
 
     void draw(VkCommandBuffer commandBuffer, uint32_t imageIndex) override {
-        SimpleShaderObject::bindPushConstant(commandBuffer, getPushConstants(XTPVulkan::currentFrameIndex), shader.get());
+        //onFrame comes first, since transient buffers only get their address for the frame once it has been called.
         transformBuffer.onFrame(XTPVulkan::currentFrameIndex);
-        getMesh()->getVertexBuffer().bind(commandBuffer);
-        getMesh()->getIndexBuffer().bind(commandBuffer);
-
-        vkCmdDrawIndexed(commandBuffer, mesh->getIndexCount(), 1, 0, 0, 0);
+        SimpleShaderObject::bindPushConstant(commandBuffer, getPushConstants(XTPVulkan::currentFrameIndex), shader.get());
+        mesh->draw(commandBuffer);
     }
 
 
     std::shared_ptr<Mesh> getMesh() override {
         return mesh;
     }
+
+    void publishTickState() override {
+        //Interpolating needs the transform of every tick, so a renderable that stops moving is drawn where it stopped.
+        if (VulkanRenderInfo::INSTANCE->interpolateTickState()) {
+            tickTransform.write();
+        }
+        tickTransform.publish();
+    }
+
+    void acquireTickState() override {
+        const bool acquired = tickTransform.acquire();
+        if (acquired) {
+            previousTransform = hasTransform ? currentTransform : tickTransform.read();
+            currentTransform = tickTransform.read();
+            hasTransform = true;
+        }
+        //The frame hasn't seen the tick of a transform acquired early finish yet, so it is drawn from where it starts.
+        const float alpha = acquired && !XTPVulkan::tickedSinceLastFrame ? 0.0f : XTPVulkan::tickInterpolationAlpha;
+        //Exact for translation, and close enough for the rotation between two ticks.
+        const glm::mat4 transform = previousTransform + (currentTransform - previousTransform) * alpha;
+        if (transform != transformBuffer.bufferValue) {
+            transformBuffer.bufferValue = transform;
+            transformBuffer.markBuffersDirty();
+        }
+    }
+
+    glm::mat4 getTransform() override {
+        return transformBuffer.bufferValue;
+    }
+
+    //Until a transform has been given to the constructor or published through tickTransform, the transform is a zero
+    //matrix and the bounds would be culled wherever the renderable really is.
+    bool frustumCullable() override {
+        return hasTransform;
+    }
+
+private:
+    //The transforms of the last two acquired ticks.
+    glm::mat4 previousTransform;
+    glm::mat4 currentTransform;
+    bool hasTransform;
 };
 
 #endif //SIMPLEINDEXBUFFEREDRENDERABLE_H
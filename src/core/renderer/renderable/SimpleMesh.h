@@ -4,27 +4,36 @@
 
 #ifndef SIMPLEMESH_H
 #define SIMPLEMESH_H
+#include <type_traits>
+#include <utility>
+
 #include "Mesh.h"
 #include "vector"
 #include "XTPVulkan.h"
 
+//Vertex types with a glm::vec3 pos member get bounding volumes, everything else is never culled.
+template <class VERTEX_TYPE, class = void> struct HasVertexPosition : std::false_type {};
+template <class VERTEX_TYPE> struct HasVertexPosition<VERTEX_TYPE, std::void_t<decltype(std::declval<VERTEX_TYPE>().pos)>> : std::true_type {};
+
 
+//A mesh stored in the MeshPool. Binding it only binds the pool, and only if it isn't already bound.
 template <class VERTEX_TYPE> class SimpleMesh final : public Mesh {
 public:
-    AllocatedBuffer vertexBuffer;
-    AllocatedBuffer indexBuffer;
+    MeshAllocation allocation {};
     std::vector<VERTEX_TYPE> vertices;
     std::vector<uint32_t> indices;
     bool hasInitialized = false;
+    bool hasDestroyed = false;
 
-    SimpleMesh(std::vector<VERTEX_TYPE> vertices, const std::vector<uint32_t> &indices): vertexBuffer(), indexBuffer(),
-                                                                                         vertices(vertices),
+    SimpleMesh(std::vector<VERTEX_TYPE> vertices, const std::vector<uint32_t> &indices): vertices(vertices),
                                                                                          indices(indices) {
+        if constexpr (HasVertexPosition<VERTEX_TYPE>::value) {
+            calculateBounds();
+        }
     }
 
     void init() override {
-        vertexBuffer = XTPVulkan::createBufferWithDataStaging(vertices, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
-        indexBuffer = XTPVulkan::createBufferWithDataStaging(indices, VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
+        allocation = MeshPool::allocate(vertices.data(), vertices.size() * sizeof(VERTEX_TYPE), sizeof(VERTEX_TYPE), indices);
 
         hasInitialized = true;
     }
@@ -34,10 +43,14 @@ public:
     }
 
     bool destroyed() override {
-        return hasInitialized;
+        return hasDestroyed;
     }
 
     void destroy() override {
+        if (hasInitialized && !hasDestroyed) {
+            MeshPool::free(allocation);
+        }
+        hasDestroyed = true;
     }
 
     Vertex getFirstVertex() override {
@@ -45,11 +58,11 @@ public:
     }
 
     AllocatedBuffer getVertexBuffer() override {
-        return vertexBuffer;
+        return MeshPool::vertexBuffer;
     }
 
     AllocatedBuffer getIndexBuffer() override {
-        return indexBuffer;
+        return MeshPool::indexBuffer;
     }
 
     uint32_t getVertexCount() override {
@@ -59,6 +72,44 @@ public:
     uint32_t getIndexCount() override {
         return indices.size();
     }
+
+    uint32_t getFirstIndex() override {
+        return allocation.firstIndex;
+    }
+
+    int32_t getVertexOffset() override {
+        return allocation.vertexOffset;
+    }
+
+    void bind(VkCommandBuffer commandBuffer) override {
+        MeshPool::bindIfNeeded(commandBuffer);
+    }
+
+    MeshBounds getBounds() override {
+        return bounds;
+    }
+
+    VkDeviceSize getUploadSize() override {
+        return vertices.size() * sizeof(VERTEX_TYPE) + indices.size() * sizeof(uint32_t);
+    }
+
+private:
+    MeshBounds bounds {};
+
+    void calculateBounds() {
+        if (vertices.empty()) {
+            return;
+        }
+        bounds.min = bounds.max = glm::vec3(vertices[0].pos);
+        for (const VERTEX_TYPE &vertex: vertices) {
+            bounds.min = glm::min(bounds.min, glm::vec3(vertex.pos));
+            bounds.max = glm::max(bounds.max, glm::vec3(vertex.pos));
+        }
+        //The sphere around the box is slightly looser than the tightest sphere, but only needs one pass.
+        bounds.center = (bounds.min + bounds.max) * 0.5f;
+        bounds.radius = glm::length(bounds.max - bounds.center);
+        bounds.valid = true;
+    }
 };
 
 
@@ -0,0 +1,115 @@
+#ifndef STREAMEDMESH_H
+#define STREAMEDMESH_H
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include "Mesh.h"
+
+//A mesh loaded by the AssetStreamer. Until the loaded mesh has been initialized it draws the placeholder, or nothing if
+//there is none. Its range and buffers change when it switches, which the IndirectBatcher checks for every frame.
+class StreamedMesh final : public Mesh {
+public:
+    explicit StreamedMesh(std::shared_ptr<Mesh> placeholder): placeholder(std::move(placeholder)) {}
+
+    void init() override {
+        if (placeholder != nullptr && !placeholder->initialized()) {
+            placeholder->init();
+        }
+        hasInitialized = true;
+    }
+
+    bool initialized() override {
+        return hasInitialized;
+    }
+
+    bool destroyed() override {
+        return hasDestroyed;
+    }
+
+    //The placeholder may be shared with other meshes, so it is left alone.
+    void destroy() override {
+        if (isReady() && !mesh->destroyed()) {
+            mesh->destroy();
+        }
+        hasDestroyed = true;
+    }
+
+    [[nodiscard]] bool isReady() const {
+        return ready.load(std::memory_order_acquire);
+    }
+
+    Vertex getFirstVertex() override {
+        Mesh* target = current();
+        return target != nullptr ? target->getFirstVertex() : Vertex {};
+    }
+
+    AllocatedBuffer getVertexBuffer() override {
+        Mesh* target = current();
+        return target != nullptr ? target->getVertexBuffer() : MeshPool::vertexBuffer;
+    }
+
+    AllocatedBuffer getIndexBuffer() override {
+        Mesh* target = current();
+        return target != nullptr ? target->getIndexBuffer() : MeshPool::indexBuffer;
+    }
+
+    uint32_t getVertexCount() override {
+        Mesh* target = current();
+        return target != nullptr ? target->getVertexCount() : 0;
+    }
+
+    uint32_t getIndexCount() override {
+        Mesh* target = current();
+        return target != nullptr ? target->getIndexCount() : 0;
+    }
+
+    MeshBounds getBounds() override {
+        Mesh* target = current();
+        return target != nullptr ? target->getBounds() : MeshBounds {};
+    }
+
+    uint32_t getFirstIndex() override {
+        Mesh* target = current();
+        return target != nullptr ? target->getFirstIndex() : 0;
+    }
+
+    int32_t getVertexOffset() override {
+        Mesh* target = current();
+        return target != nullptr ? target->getVertexOffset() : 0;
+    }
+
+    //With nothing to draw the pool is still bound, so drawing zero indices has index and vertex buffers to use.
+    void bind(VkCommandBuffer commandBuffer) override {
+        Mesh* target = current();
+        if (target != nullptr) {
+            target->bind(commandBuffer);
+        } else {
+            MeshPool::bindIfNeeded(commandBuffer);
+        }
+    }
+
+    void tick() override {
+        if (Mesh* target = current()) {
+            target->tick();
+        }
+    }
+
+private:
+    friend class AssetStreamer;
+
+    std::shared_ptr<Mesh> placeholder;
+    //Only written before ready is set.
+    std::shared_ptr<Mesh> mesh;
+    std::atomic<bool> ready {false};
+    bool hasInitialized = false;
+    bool hasDestroyed = false;
+
+    Mesh* current() {
+        return isReady() ? mesh.get() : placeholder.get();
+    }
+};
+
+
+
+#endif //STREAMEDMESH_H
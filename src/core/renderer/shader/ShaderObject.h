@@ -27,6 +27,28 @@ public:
 
     virtual VkPipelineLayout getLayout() = 0;
 
+    //If true, renderables using this shader are drawn by the IndirectBatcher instead of Renderable::draw. The shader must
+    //declare an IndirectDrawPushConstants range at offset 0 for the vertex stage, and read each object's transform from
+    //objectDataAddress using gl_InstanceIndex. If it also uses the bindless table, the range is for the vertex and
+    //fragment stages, so the fragment shader can read materials from materialDataAddress.
+    virtual bool drawsIndirect() {
+        return false;
+    }
+
+    //If true, the BindlessTable is part of the shader's pipeline layout, as the set returned by getBindlessSet().
+    virtual bool usesBindlessTable() {
+        return false;
+    }
+
+    virtual uint32_t getBindlessSet() {
+        return 0;
+    }
+
+    //Renderables are not drawn until their shader is ready, e.g. while its pipeline is still being compiled.
+    virtual bool isReady() {
+        return true;
+    }
+
     // ReSharper disable once CppPossiblyUninitializedMember
     ShaderObject(const std::string &vertexShaderPath,
                  const std::string &fragmentShaderPath
@@ -8,9 +8,12 @@
 #define SHADER_INPUT_VECTOR4F VK_FORMAT_R32G32B32A32_SFLOAT
 
 #include <any>
+#include <atomic>
 
-#include "FileUtil.h"
+#include "AssetFile.h"
 
+#include "BindlessTable.h"
+#include "PipelineCache.h"
 #include "ShaderObject.h"
 #include "XTPVulkan.h"
 #include "vulkan/vulkan.h"
@@ -80,9 +83,13 @@ struct Descriptor {
 };
 
 struct ShaderProperties: ShaderData{
+    //If VK_NULL_HANDLE, the pipeline is created for dynamic rendering into attachments of the formats below.
     VkRenderPass renderPass = {
         XTPVulkan::renderPass
     };
+    //VK_FORMAT_UNDEFINED means the swapchain's format.
+    VkFormat colorAttachmentFormat = VK_FORMAT_UNDEFINED;
+    VkFormat depthAttachmentFormat = XTPVulkan::DEPTH_FORMAT;
     VkPrimitiveTopology topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
     VkBool32 depthClamp = VK_FALSE;
     VkPolygonMode polygonMode = VK_POLYGON_MODE_FILL;
@@ -126,6 +133,7 @@ public:
     std::unordered_map<uint32_t, uint32_t> bindings;
     std::unordered_map<int, std::unordered_map<int, Descriptor>> descriptors {};
     std::vector<PushConstantInfo> pushConstants;
+    std::atomic<bool> pipelineReady = false;
 
     // ReSharper disable once CppPossiblyUninitializedMember
     SimpleShaderObject(const std::string &vertexShaderPath,
@@ -142,6 +150,11 @@ public:
         return pipelineLayout;
     }
 
+    //The table comes right after the shader's own sets.
+    uint32_t getBindlessSet() override {
+        return static_cast<uint32_t>(descriptorSetLayouts.size());
+    }
+
     // ReSharper disable once CppNotAllPathsReturnValue
     virtual XTPVulkan::DescriptorSet createDescriptorSet(const uint32_t set) {
         uint32_t descriptorCount = 0;
@@ -168,11 +181,20 @@ public:
                 XTPVulkan::logger->logCritical("Descriptor Set Must Contain At Least One Binding!");
             }
         }
-        createGraphicsPipeline();
+        //The layout is needed right away by materials, only the pipeline itself is compiled in the background.
+        createPipelineLayout();
+        PipelineCache::compile([this] {
+            createGraphicsPipeline();
+            pipelineReady.store(true, std::memory_order_release);
+        });
         initShader();
         createBuffers();
     }
 
+    bool isReady() override {
+        return pipelineReady.load(std::memory_order_acquire);
+    }
+
     bool hasDeleted() override {
         return deleted;
     }
@@ -182,6 +204,7 @@ public:
     virtual std::vector<Descriptor> getDescriptors() = 0;
 
     void cleanUp() override {
+        PipelineCache::waitIdle();
         vkDestroyPipeline(XTPVulkan::device, pipeline, nullptr);
         vkDestroyPipelineLayout(XTPVulkan::device, pipelineLayout, nullptr);
         for (const VkDescriptorSetLayout& descriptorSetLayout : getDescriptorSetLayouts()) {
@@ -218,9 +241,44 @@ public:
         vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
     }
 
+    void createPipelineLayout() {
+        std::vector<VkPushConstantRange> pushConstantRanges(pushConstants.size());
+        for (int i = 0; i < pushConstants.size(); ++i) {
+            PushConstantInfo* pushConstant = &pushConstants[i];
+
+            VkPushConstantRange pushConstantRange;
+            pushConstantRange.offset = pushConstant->offset;
+            pushConstantRange.size = pushConstant->size;
+            pushConstantRange.stageFlags = pushConstant->pushConstantShaderStages;
+
+            pushConstantRanges[i] = pushConstantRange;
+        }
+
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+
+        std::vector<VkDescriptorSetLayout> layouts = getDescriptorSetLayouts();
+        if (usesBindlessTable()) {
+            if (!BindlessTable::enabled) {
+                XTPVulkan::logger->logCritical("Shader Uses The Bindless Table, But The Device Doesn't Support It!");
+            }
+            layouts.emplace_back(BindlessTable::getLayout());
+        }
+        pipelineLayoutInfo.setLayoutCount = layouts.size();
+        pipelineLayoutInfo.pSetLayouts = layouts.data();
+
+        pipelineLayoutInfo.pushConstantRangeCount = pushConstantRanges.size();
+        pipelineLayoutInfo.pPushConstantRanges = pushConstantRanges.data();
+
+        if (vkCreatePipelineLayout(XTPVulkan::device, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
+            XTPVulkan::logger->logCritical("Failed To Create Pipeline Layout!");
+        }
+    }
+
+    //Runs on a PipelineCache compile thread, so it must only touch state that isn't used until the pipeline is ready.
     void createGraphicsPipeline() {
-        VkShaderModule vertShaderModule = createShaderModule(FileUtil::readFile(this->vertexShaderPath));
-        VkShaderModule fragShaderModule = createShaderModule(FileUtil::readFile(this->fragmentShaderPath));
+        VkShaderModule vertShaderModule = createShaderModule(this->vertexShaderPath);
+        VkShaderModule fragShaderModule = createShaderModule(this->fragmentShaderPath);
 
         VkPipelineShaderStageCreateInfo vertShaderStageInfo {};
         vertShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
@@ -299,33 +357,6 @@ public:
         multisampling.alphaToOneEnable = VK_FALSE;
 
 
-        std::vector<VkPushConstantRange> pushConstantRanges(pushConstants.size());
-        for (int i = 0; i < pushConstants.size(); ++i) {
-            PushConstantInfo* pushConstant = &pushConstants[i];
-
-            VkPushConstantRange pushConstantRange;
-            pushConstantRange.offset = pushConstant->offset;
-            pushConstantRange.size = pushConstant->size;
-            pushConstantRange.stageFlags = pushConstant->pushConstantShaderStages;
-
-            pushConstantRanges[i] = pushConstantRange;
-        }
-
-        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
-        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-
-        std::vector<VkDescriptorSetLayout> layouts = getDescriptorSetLayouts();
-        pipelineLayoutInfo.setLayoutCount = layouts.size();
-        pipelineLayoutInfo.pSetLayouts = layouts.data();
-
-        pipelineLayoutInfo.pushConstantRangeCount = pushConstantRanges.size();
-        pipelineLayoutInfo.pPushConstantRanges = pushConstantRanges.data();
-
-        if (vkCreatePipelineLayout(XTPVulkan::device, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
-            XTPVulkan::logger->logCritical("Failed To Create Pipeline Layout!");
-        }
-
-
         VkGraphicsPipelineCreateInfo pipelineInfo{};
         pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
         pipelineInfo.stageCount = 2;
@@ -341,10 +372,21 @@ public:
         pipelineInfo.layout = pipelineLayout;
         pipelineInfo.renderPass = properties.renderPass;
         pipelineInfo.subpass = 0;
+
+        const VkFormat colorFormat = properties.colorAttachmentFormat == VK_FORMAT_UNDEFINED ? XTPVulkan::swapchainImageFormat
+                                                                                            : properties.colorAttachmentFormat;
+        VkPipelineRenderingCreateInfoKHR renderingInfo {};
+        renderingInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR;
+        renderingInfo.colorAttachmentCount = 1;
+        renderingInfo.pColorAttachmentFormats = &colorFormat;
+        renderingInfo.depthAttachmentFormat = properties.depthAttachmentFormat;
+        if (properties.renderPass == VK_NULL_HANDLE) {
+            pipelineInfo.pNext = &renderingInfo;
+        }
         pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
         pipelineInfo.basePipelineIndex = -1;
 
-        if (vkCreateGraphicsPipelines(XTPVulkan::device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS) {
+        if (vkCreateGraphicsPipelines(XTPVulkan::device, PipelineCache::cache, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS) {
             XTPVulkan::logger->logCritical("Failed To Create Graphics Pipeline!");
         }
 
@@ -390,7 +432,16 @@ public:
         return descriptorSetLayouts;
     }
 
-    static VkShaderModule createShaderModule(const std::vector<char> &shaderBytecode) {
+    //The SPIR-V is read in place from the mapped file or archive, which is aligned, so it can be passed on as uint32_t.
+    static VkShaderModule createShaderModule(const std::string &path) {
+        const AssetFile shaderBytecode(path);
+        if (!shaderBytecode.isOpen()) {
+            XTPVulkan::logger->logCritical("Failed To Open Shader '{}'!", true, path);
+        }
+        if (shaderBytecode.size() == 0 || shaderBytecode.size() % sizeof(uint32_t) != 0) {
+            XTPVulkan::logger->logCritical("Shader '{}' Isn't Valid SPIR-V!", true, path);
+        }
+
         VkShaderModuleCreateInfo createInfo {};
         createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
         createInfo.codeSize = shaderBytecode.size();
@@ -0,0 +1,275 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+
+std::atomic<bool> Profiler::enabled = false;
+size_t Profiler::maxFrames = 0;
+std::vector<std::unique_ptr<Profiler::ThreadZones>> Profiler::threads;
+std::mutex Profiler::threadsMutex;
+thread_local Profiler::ThreadZones* Profiler::currentThread = nullptr;
+std::deque<ProfileFrame> Profiler::frames;
+std::mutex Profiler::framesMutex;
+std::map<Profiler::ZoneKey, ProfileZoneTotal> Profiler::zoneTotals;
+int64_t Profiler::totalFrameNanos = 0;
+std::atomic<uint64_t> Profiler::frameNumber = 0;
+int64_t Profiler::frameStartNanos = 0;
+std::unordered_set<std::string> Profiler::names;
+std::mutex Profiler::namesMutex;
+
+void Profiler::init(const size_t frameCount) {
+    std::lock_guard lock(framesMutex);
+    maxFrames = frameCount;
+    while (frames.size() > maxFrames) {
+        dropOldestFrame();
+    }
+}
+
+void Profiler::setEnabled(const bool enabled) {
+    Profiler::enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool Profiler::isEnabled() {
+    return enabled.load(std::memory_order_relaxed);
+}
+
+void Profiler::beginFrame() {
+    frameNumber.fetch_add(1, std::memory_order_relaxed);
+    frameStartNanos = now();
+}
+
+void Profiler::endFrame() {
+    ProfileFrame frame {};
+    frame.number = getFrameNumber();
+    frame.startNanos = frameStartNanos;
+    frame.endNanos = now();
+    {
+        std::lock_guard lock(threadsMutex);
+        for (const std::unique_ptr<ThreadZones> &thread: threads) {
+            std::lock_guard threadLock(thread->mutex);
+            frame.cpuZones.insert(frame.cpuZones.end(), thread->finished.begin(), thread->finished.end());
+            thread->finished.clear();
+        }
+    }
+    //Zones that ended after the Profiler was disabled are still taken, so they don't end up in the next frame recorded.
+    if (!isEnabled()) {
+        return;
+    }
+
+    std::lock_guard lock(framesMutex);
+    updateZoneTotals(frame.cpuZones, true);
+    totalFrameNanos += frame.endNanos - frame.startNanos;
+    frames.push_back(std::move(frame));
+    while (frames.size() > maxFrames) {
+        dropOldestFrame();
+    }
+}
+
+uint64_t Profiler::getFrameNumber() {
+    return frameNumber.load(std::memory_order_relaxed);
+}
+
+void Profiler::beginZone(const char* name) {
+    ThreadZones &thread = getThreadZones();
+    thread.open.push_back({name, now(), 0, static_cast<uint32_t>(thread.open.size()), thread.index});
+}
+
+void Profiler::endZone() {
+    ThreadZones &thread = getThreadZones();
+    if (thread.open.empty()) {
+        return;
+    }
+    ProfileZoneRecord zone = thread.open.back();
+    thread.open.pop_back();
+    zone.endNanos = now();
+
+    std::lock_guard lock(thread.mutex);
+    thread.finished.push_back(zone);
+}
+
+void Profiler::setThreadName(const std::string &name) {
+    ThreadZones &thread = getThreadZones();
+    std::lock_guard lock(threadsMutex);
+    thread.name = name;
+}
+
+const char *Profiler::internName(const std::string &name) {
+    std::lock_guard lock(namesMutex);
+    return names.insert(name).first->c_str();
+}
+
+void Profiler::addGpuZones(const uint64_t frameNumber, std::vector<ProfileZoneRecord> &&zones) {
+    std::lock_guard lock(framesMutex);
+    //Frames are numbered in order, so the frame is found by counting back from the newest.
+    if (frames.empty() || frameNumber > frames.back().number || frames.back().number - frameNumber >= frames.size()) {
+        return;
+    }
+    ProfileFrame &frame = frames[frames.size() - 1 - (frames.back().number - frameNumber)];
+    if (frame.number == frameNumber) {
+        updateZoneTotals(frame.gpuZones, false);
+        frame.gpuZones = std::move(zones);
+        updateZoneTotals(frame.gpuZones, true);
+    }
+}
+
+std::vector<ProfileFrame> Profiler::getFrames() {
+    std::lock_guard lock(framesMutex);
+    return {frames.begin(), frames.end()};
+}
+
+bool Profiler::summarizeLatestFrame(ProfileFrameSummary &summary) {
+    std::lock_guard lock(framesMutex);
+    if (frames.empty()) {
+        return false;
+    }
+    //The newest frames are still waiting for their GPU zones.
+    const auto shown = std::find_if(frames.rbegin(), frames.rend(), [](const ProfileFrame &frame) {
+        return !frame.gpuZones.empty();
+    });
+    summary.frame = shown == frames.rend() ? frames.back() : *shown;
+    summary.zoneTotals.clear();
+    for (const std::vector<ProfileZoneRecord>* zones: {&summary.frame.cpuZones, &summary.frame.gpuZones}) {
+        for (const ProfileZoneRecord &zone: *zones) {
+            summary.zoneTotals.push_back(zoneTotals.at({zone.thread, zone.name, zone.depth}));
+        }
+    }
+    summary.totalFrameNanos = totalFrameNanos;
+    summary.frameCount = frames.size();
+    return true;
+}
+
+std::vector<std::string> Profiler::getThreadNames() {
+    std::lock_guard lock(threadsMutex);
+    std::vector<std::string> threadNames;
+    threadNames.reserve(threads.size());
+    for (const std::unique_ptr<ThreadZones> &thread: threads) {
+        threadNames.push_back(thread->name);
+    }
+    return threadNames;
+}
+
+static void writeQuoted(std::ofstream &file, const char* text, const bool json) {
+    file << '"';
+    for (const char* c = text; *c != '\0'; ++c) {
+        if (*c == '"') {
+            file << (json ? "\\\"" : "\"\"");
+        } else if (json && *c == '\\') {
+            file << "\\\\";
+        } else {
+            file << *c;
+        }
+    }
+    file << '"';
+}
+
+static void writeTime(std::ofstream &file, const int64_t nanos, const double nanosPerUnit) {
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.3f", static_cast<double>(nanos) / nanosPerUnit);
+    file << buffer;
+}
+
+bool Profiler::exportCsv(const std::string &path) {
+    const std::vector<ProfileFrame> exported = getFrames();
+    const std::vector<std::string> threadNames = getThreadNames();
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    file << "frame,thread,zone,depth,start_ms,duration_ms\n";
+    for (const ProfileFrame &frame: exported) {
+        for (const std::vector<ProfileZoneRecord>* zones: {&frame.cpuZones, &frame.gpuZones}) {
+            for (const ProfileZoneRecord &zone: *zones) {
+                file << frame.number << ',';
+                writeQuoted(file, zone.thread == GPU_THREAD ? "GPU" : threadNames[zone.thread].c_str(), false);
+                file << ',';
+                writeQuoted(file, zone.name, false);
+                file << ',' << zone.depth << ',';
+                writeTime(file, zone.startNanos - frame.startNanos, 1000000.0);
+                file << ',';
+                writeTime(file, zone.endNanos - zone.startNanos, 1000000.0);
+                file << '\n';
+            }
+        }
+    }
+    return !file.fail();
+}
+
+bool Profiler::exportChromeTrace(const std::string &path) {
+    const std::vector<ProfileFrame> exported = getFrames();
+    const std::vector<std::string> threadNames = getThreadNames();
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    //GPU zones go on a track after the last thread.
+    const size_t gpuTrack = threadNames.size();
+    const int64_t origin = exported.empty() ? 0 : exported.front().startNanos;
+    file << "{\"traceEvents\":[";
+    for (size_t i = 0; i <= threadNames.size(); ++i) {
+        file << (i == 0 ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << i <<
+            ",\"args\":{\"name\":";
+        writeQuoted(file, i == gpuTrack ? "GPU" : threadNames[i].c_str(), true);
+        file << "}}";
+    }
+    for (const ProfileFrame &frame: exported) {
+        for (const std::vector<ProfileZoneRecord>* zones: {&frame.cpuZones, &frame.gpuZones}) {
+            for (const ProfileZoneRecord &zone: *zones) {
+                file << ",\n{\"name\":";
+                writeQuoted(file, zone.name, true);
+                file << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << (zone.thread == GPU_THREAD ? gpuTrack : zone.thread) <<
+                    ",\"ts\":";
+                writeTime(file, zone.startNanos - origin, 1000.0);
+                file << ",\"dur\":";
+                writeTime(file, zone.endNanos - zone.startNanos, 1000.0);
+                file << '}';
+            }
+        }
+    }
+    file << "\n]}\n";
+    return !file.fail();
+}
+
+Profiler::ThreadZones &Profiler::getThreadZones() {
+    if (currentThread == nullptr) {
+        std::lock_guard lock(threadsMutex);
+        const std::unique_ptr<ThreadZones> &thread = threads.emplace_back(std::make_unique<ThreadZones>());
+        thread->index = static_cast<uint32_t>(threads.size() - 1);
+        thread->name = "Thread " + std::to_string(thread->index);
+        currentThread = thread.get();
+    }
+    return *currentThread;
+}
+
+void Profiler::updateZoneTotals(const std::vector<ProfileZoneRecord> &zones, const bool add) {
+    for (const ProfileZoneRecord &zone: zones) {
+        const auto iterator = zoneTotals.try_emplace({zone.thread, zone.name, zone.depth},
+                                                     ProfileZoneTotal {0, 0}).first;
+        ProfileZoneTotal &total = iterator->second;
+        if (add) {
+            total.nanos += zone.endNanos - zone.startNanos;
+            ++total.count;
+        } else {
+            total.nanos -= zone.endNanos - zone.startNanos;
+            if (--total.count == 0) {
+                zoneTotals.erase(iterator);
+            }
+        }
+    }
+}
+
+void Profiler::dropOldestFrame() {
+    const ProfileFrame &frame = frames.front();
+    updateZoneTotals(frame.cpuZones, false);
+    updateZoneTotals(frame.gpuZones, false);
+    totalFrameNanos -= frame.endNanos - frame.startNanos;
+    frames.pop_front();
+}
+
+int64_t Profiler::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).
+        count();
+}
@@ -0,0 +1,182 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_set>
+#include <vector>
+
+struct ProfileZoneRecord {
+    //Must outlive the Profiler, see Profiler::internName().
+    const char* name;
+    int64_t startNanos;
+    int64_t endNanos;
+    //Zones opened inside another zone on the same thread are one deeper than it.
+    uint32_t depth;
+    //An index into Profiler::getThreadNames(), or Profiler::GPU_THREAD.
+    uint32_t thread;
+};
+
+struct ProfileFrame {
+    uint64_t number;
+    int64_t startNanos;
+    int64_t endNanos;
+    //Every zone that ended on any thread while the frame was running.
+    std::vector<ProfileZoneRecord> cpuZones;
+    //Converted to the CPU zones' clock by lining the first one up with when the frame was submitted. These arrive once the
+    //GPU has finished the frame, so the newest frames don't have them yet.
+    std::vector<ProfileZoneRecord> gpuZones;
+};
+
+struct ProfileZoneTotal {
+    int64_t nanos;
+    uint32_t count;
+};
+
+//A kept frame, along with totals over every kept frame for its zones. zoneTotals lines up with frame.cpuZones followed
+//by frame.gpuZones, and zones are matched across frames by thread, name and depth.
+struct ProfileFrameSummary {
+    ProfileFrame frame;
+    std::vector<ProfileZoneTotal> zoneTotals;
+    int64_t totalFrameNanos;
+    size_t frameCount;
+};
+
+//A built in profiler that keeps nested CPU zones and the GpuProfiler's pass timings for the last few frames, so timing
+//can be captured and exported without building with Tracy. Recording zones is thread safe. Nothing is recorded while it
+//is disabled.
+class Profiler {
+public:
+    static constexpr uint32_t GPU_THREAD = UINT32_MAX;
+
+    //frameCount is how many frames are kept before the oldest is dropped.
+    static void init(size_t frameCount);
+
+    static void setEnabled(bool enabled);
+
+    [[nodiscard]] static bool isEnabled();
+
+    //Called by the render thread around each frame. Zones that end in between belong to the frame.
+    static void beginFrame();
+
+    static void endFrame();
+
+    //The number of the frame being run, or of the last one if between frames.
+    [[nodiscard]] static uint64_t getFrameNumber();
+
+    //Prefer ProfileZone, which can't be left open.
+    static void beginZone(const char* name);
+
+    static void endZone();
+
+    //Names the calling thread in the panel and exports. Threads that don't get a name are numbered instead.
+    static void setThreadName(const std::string &name);
+
+    //Returns a copy of name that stays valid until the program exits, for zone names that aren't string literals.
+    [[nodiscard]] static const char* internName(const std::string &name);
+
+    //Ignored if the frame has already been dropped.
+    static void addGpuZones(uint64_t frameNumber, std::vector<ProfileZoneRecord> &&zones);
+
+    //The kept frames, oldest first.
+    [[nodiscard]] static std::vector<ProfileFrame> getFrames();
+
+    //Summarizes the newest kept frame that has its GPU zones, or else the newest one, without copying the others. The
+    //totals are kept up to date as frames are added and dropped. Returns false if no frames are kept.
+    static bool summarizeLatestFrame(ProfileFrameSummary &summary);
+
+    [[nodiscard]] static std::vector<std::string> getThreadNames();
+
+    //One row per zone, with times in milliseconds from the start of its frame.
+    static bool exportCsv(const std::string &path);
+
+    //The trace event format read by chrome://tracing and Perfetto.
+    static bool exportChromeTrace(const std::string &path);
+
+private:
+    struct ThreadZones {
+        std::string name;
+        uint32_t index;
+        //Only touched by the thread itself.
+        std::vector<ProfileZoneRecord> open;
+        //Guards finished, which endFrame() takes from the render thread.
+        std::mutex mutex;
+        std::vector<ProfileZoneRecord> finished;
+    };
+
+    static std::atomic<bool> enabled;
+    static size_t maxFrames;
+
+    static std::vector<std::unique_ptr<ThreadZones>> threads;
+    static std::mutex threadsMutex;
+    static thread_local ThreadZones* currentThread;
+
+    using ZoneKey = std::tuple<uint32_t, std::string_view, uint32_t>;
+
+    static std::deque<ProfileFrame> frames;
+    //Guards frames, zoneTotals and totalFrameNanos.
+    static std::mutex framesMutex;
+    //Over every kept frame. Zones are removed once no kept frame has them.
+    static std::map<ZoneKey, ProfileZoneTotal> zoneTotals;
+    static int64_t totalFrameNanos;
+    static std::atomic<uint64_t> frameNumber;
+    static int64_t frameStartNanos;
+
+    static std::unordered_set<std::string> names;
+    static std::mutex namesMutex;
+
+    static ThreadZones &getThreadZones();
+
+    //Adds the zones to zoneTotals, or removes them if add is false. framesMutex must be held.
+    static void updateZoneTotals(const std::vector<ProfileZoneRecord> &zones, bool add);
+
+    //framesMutex must be held.
+    static void dropOldestFrame();
+
+    static int64_t now();
+};
+
+//Times the scope it is declared in, if the Profiler is enabled when it is.
+class ProfileZone {
+public:
+    explicit ProfileZone(const char* name): active(Profiler::isEnabled()) {
+        if (active) {
+            Profiler::beginZone(name);
+        }
+    }
+
+    ~ProfileZone() {
+        if (active) {
+            Profiler::endZone();
+        }
+    }
+
+    ProfileZone(const ProfileZone &) = delete;
+    ProfileZone &operator=(const ProfileZone &) = delete;
+
+private:
+    bool active;
+};
+
+//Without Tracy, ZoneScopedN records into the Profiler if XTP_USE_PROFILER is defined, so every zone the engine already
+//has shows up in it.
+#if !defined(TRACY_ENABLE) && !defined(ZoneScopedN)
+#ifdef XTP_USE_PROFILER
+#define XTP_PROFILE_CONCAT_INNER(a, b) a##b
+#define XTP_PROFILE_CONCAT(a, b) XTP_PROFILE_CONCAT_INNER(a, b)
+#define ZoneScopedN(name) ProfileZone XTP_PROFILE_CONCAT(profileZone, __LINE__)(name)
+#else
+#define ZoneScopedN(name)
+#endif
+#endif
+
+
+
+#endif //PROFILER_H
@@ -0,0 +1,68 @@
+#ifndef TICKSTATE_H
+#define TICKSTATE_H
+#include <atomic>
+#include <cstdint>
+
+
+//A value written on the tick thread and read on the render thread. The tick thread changes its own copy through write()
+//and publishes it once the tick is done; the render thread picks up the latest published copy with acquire() at the
+//start of a frame and reads that until the next frame. Publishing and acquiring swap between three buffers without
+//locking, so neither thread ever sees the other halfway through an update, and neither waits on the other.
+template<class T>
+class TickState {
+public:
+    TickState() = default;
+
+    explicit TickState(const T &initialValue): value(initialValue), buffers {initialValue, initialValue, initialValue} {}
+
+    //Tick thread. Marks the value as changed, so the next publish() hands it to the render thread.
+    T &write() {
+        changed = true;
+        return value;
+    }
+
+    //Tick thread.
+    [[nodiscard]] const T &get() const {
+        return value;
+    }
+
+    //Tick thread. Does nothing if write() hasn't been called since the last publish.
+    void publish() {
+        if (!changed) {
+            return;
+        }
+        buffers[writing] = value;
+        writing = ready.exchange(writing | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+        changed = false;
+    }
+
+    //Render thread. Returns true if a value was published since the last call, in which case read() now returns it.
+    bool acquire() {
+        if ((ready.load(std::memory_order_relaxed) & FRESH) == 0) {
+            return false;
+        }
+        reading = ready.exchange(reading, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+
+    //Render thread.
+    [[nodiscard]] const T &read() const {
+        return buffers[reading];
+    }
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x3;
+    static constexpr uint8_t FRESH = 0x4;
+
+    T value {};
+    bool changed = false;
+    T buffers[3] {};
+    uint8_t writing = 0;
+    //The buffer that was published last, along with whether the render thread has acquired it yet.
+    std::atomic<uint8_t> ready {1};
+    uint8_t reading = 2;
+};
+
+
+
+#endif //TICKSTATE_H
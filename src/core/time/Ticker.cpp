@@ -1,2 +1,153 @@
 
 #include "Ticker.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
+Ticker::Ticker(const std::chrono::nanoseconds period, const std::function<void()> &function,
+               const uint32_t maxCatchUpTicks): interval(period), func(function),
+                                                maxCatchUpTicks(std::max(maxCatchUpTicks, 1u)) {
+    //Deadlines would never advance, and the number of due ticks is divided by the interval.
+    if (period <= std::chrono::nanoseconds::zero()) {
+        throw std::runtime_error("Tick Interval Must Be Greater Than Zero!");
+    }
+    resetTime();
+}
+
+uint32_t Ticker::tryExecute() {
+    if (!func) {
+        return 0;
+    }
+
+    const Clock::time_point now = Clock::now();
+    Clock::time_point deadline = getNextDeadline();
+    if (now < deadline) {
+        return 0;
+    }
+
+    uint64_t dueTicks = (now - deadline) / interval + 1;
+    if (dueTicks > maxCatchUpTicks) {
+        const uint64_t skipped = dueTicks - maxCatchUpTicks;
+        deadline += interval * skipped;
+        dueTicks = maxCatchUpTicks;
+        std::lock_guard lock(statisticsMutex);
+        statistics.skippedTicks += skipped;
+    }
+
+    for (uint64_t i = 0; i < dueTicks; ++i) {
+        const Clock::time_point start = Clock::now();
+        func();
+        recordTick(Clock::now() - start, start - deadline);
+        deadline += interval;
+    }
+    nextDeadline.store(deadline.time_since_epoch().count(), std::memory_order_release);
+    return static_cast<uint32_t>(dueTicks);
+}
+
+void Ticker::resetTime() {
+    nextDeadline.store((Clock::now() + interval).time_since_epoch().count(), std::memory_order_release);
+}
+
+Ticker::Clock::time_point Ticker::getNextDeadline() const {
+    return Clock::time_point(Clock::duration(nextDeadline.load(std::memory_order_acquire)));
+}
+
+std::chrono::nanoseconds Ticker::getInterval() const {
+    return interval;
+}
+
+float Ticker::getInterpolationAlpha() const {
+    const auto untilNextTick = std::chrono::duration_cast<std::chrono::nanoseconds>(getNextDeadline() - Clock::now());
+    return std::clamp(1.0f - static_cast<float>(untilNextTick.count()) / static_cast<float>(interval.count()), 0.0f, 1.0f);
+}
+
+TickStatistics Ticker::getStatistics() const {
+    std::lock_guard lock(statisticsMutex);
+    return statistics;
+}
+
+void Ticker::recordTick(const std::chrono::nanoseconds duration, const std::chrono::nanoseconds lateness) {
+    std::lock_guard lock(statisticsMutex);
+    statistics.lastTickDuration = duration;
+    statistics.lastTickLateness = lateness;
+    statistics.maxTickDuration = std::max(statistics.maxTickDuration, duration);
+    statistics.averageTickDuration = statistics.tickCount == 0
+                                         ? duration
+                                         : statistics.averageTickDuration + (duration - statistics.averageTickDuration) / 16;
+    statistics.tickCount++;
+}
+
+void TickScheduler::addTicker(const std::shared_ptr<Ticker> &ticker) {
+    {
+        std::lock_guard lock(mutex);
+        tickers.emplace_back(ticker);
+        tickersChanged = true;
+    }
+    //The new ticker may be due before whatever the scheduler is sleeping until.
+    wakeUp.notify_all();
+}
+
+void TickScheduler::removeTicker(const Ticker *ticker) {
+    std::lock_guard lock(mutex);
+    tickers.erase(std::remove_if(tickers.begin(), tickers.end(), [ticker](const std::shared_ptr<Ticker> &registered) {
+        return registered.get() == ticker;
+    }), tickers.end());
+    tickersChanged = true;
+}
+
+void TickScheduler::run() {
+    std::vector<std::shared_ptr<Ticker>> runningTickers;
+    std::chrono::nanoseconds spinThreshold = SPIN_THRESHOLD;
+    while (true) {
+        {
+            std::lock_guard lock(mutex);
+            if (stopping) {
+                return;
+            }
+            if (tickersChanged) {
+                runningTickers = tickers;
+                tickersChanged = false;
+                spinThreshold = SPIN_THRESHOLD;
+                for (const std::shared_ptr<Ticker> &ticker: runningTickers) {
+                    spinThreshold = std::min(spinThreshold, ticker->getInterval() / SPIN_INTERVAL_FRACTION);
+                }
+            }
+        }
+
+        Ticker::Clock::time_point nextDeadline = Ticker::Clock::time_point::max();
+        for (const std::shared_ptr<Ticker> &ticker: runningTickers) {
+            ticker->tryExecute();
+            nextDeadline = std::min(nextDeadline, ticker->getNextDeadline());
+        }
+
+        sleepUntil(nextDeadline, spinThreshold);
+    }
+}
+
+void TickScheduler::stop() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+}
+
+void TickScheduler::sleepUntil(const Ticker::Clock::time_point deadline, const std::chrono::nanoseconds spinThreshold) {
+    {
+        std::unique_lock lock(mutex);
+        const auto shouldWake = [this] { return stopping || tickersChanged; };
+        //Without any tickers there is nothing to wait for but a new ticker or stop().
+        if (deadline == Ticker::Clock::time_point::max()) {
+            wakeUp.wait(lock, shouldWake);
+            return;
+        }
+        if (wakeUp.wait_until(lock, deadline - spinThreshold, shouldWake)) {
+            return;
+        }
+    }
+
+    while (Ticker::Clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+}
@@ -1,39 +1,97 @@
-
 #ifndef TICKER_H
 #define TICKER_H
 
-#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+struct TickStatistics {
+    uint64_t tickCount = 0;
+    //Ticks that were dropped because the ticker fell more than maxCatchUpTicks behind.
+    uint64_t skippedTicks = 0;
+    std::chrono::nanoseconds lastTickDuration {0};
+    //An exponential moving average, so it follows changes in load within a few dozen ticks.
+    std::chrono::nanoseconds averageTickDuration {0};
+    std::chrono::nanoseconds maxTickDuration {0};
+    //How long after its deadline the last tick started.
+    std::chrono::nanoseconds lastTickLateness {0};
+};
 
+//Calls a function at a fixed rate. Deadlines are a fixed interval apart, so a late tick doesn't push back the ones after
+//it, and a ticker that falls behind runs the ticks it missed back to back, up to maxCatchUpTicks at a time. Anything past
+//that is dropped instead of making the ticker fall further and further behind.
 class Ticker {
 public:
-    long interval;
-    std::function<void()> func;
-    long timeIntervalStarted;
+    using Clock = std::chrono::steady_clock;
 
-    Ticker(const std::chrono::nanoseconds period, const std::function<void()>& function) {
-        interval = period.count();
-        func = function;
-        timeIntervalStarted = getNanoTime().count();
-    }
+    //Throws if period isn't positive.
+    Ticker(std::chrono::nanoseconds period, const std::function<void()>& function, uint32_t maxCatchUpTicks = 5);
 
     static std::chrono::nanoseconds getNanoTime() {
-        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch());
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch());
     }
 
-    void tryExecute() {
-        if (!func) {
-            return;
-        }
+    //Runs every tick that is due. Returns how many ran.
+    uint32_t tryExecute();
 
-        if (getNanoTime().count() - timeIntervalStarted >= interval) {
-            func();
-            timeIntervalStarted = getNanoTime().count();
-        }
-    }
+    //Makes the next tick due one interval from now.
+    void resetTime();
 
-    void resetTime() {
-        timeIntervalStarted = getNanoTime().count();
-    }
+    [[nodiscard]] Clock::time_point getNextDeadline() const;
+
+    [[nodiscard]] std::chrono::nanoseconds getInterval() const;
+
+    //How far the current time is between the last tick and the next one, from 0 to 1. Used to interpolate between the
+    //last two ticks when rendering.
+    [[nodiscard]] float getInterpolationAlpha() const;
+
+    //Safe to call from any thread.
+    [[nodiscard]] TickStatistics getStatistics() const;
+
+private:
+    std::chrono::nanoseconds interval;
+    std::function<void()> func;
+    uint32_t maxCatchUpTicks;
+    std::atomic<Clock::rep> nextDeadline;
+    mutable std::mutex statisticsMutex;
+    TickStatistics statistics;
+
+    void recordTick(std::chrono::nanoseconds duration, std::chrono::nanoseconds lateness);
+};
+
+//Runs any number of tickers on one thread, sleeping until the next one is due instead of polling the clock. Sleeping
+//stops a little before the deadline and the rest is spun, since sleeps can overshoot the deadline.
+class TickScheduler {
+public:
+    //How long before a deadline the scheduler stops sleeping and spins instead, at most. It is also kept to
+    //SPIN_INTERVAL_FRACTION of the shortest interval, so fast tickers don't spend most of their time spinning.
+    static constexpr std::chrono::nanoseconds SPIN_THRESHOLD = std::chrono::microseconds(500);
+    static constexpr uint32_t SPIN_INTERVAL_FRACTION = 4;
+
+    void addTicker(const std::shared_ptr<Ticker>& ticker);
+
+    void removeTicker(const Ticker* ticker);
+
+    //Runs the tickers on the calling thread until stop() is called.
+    void run();
+
+    //Makes run() return as soon as the tick it is running, if any, has finished.
+    void stop();
+
+    //Sleeps until spinThreshold before the deadline and spins for the rest, returning early if stop() is called.
+    void sleepUntil(Ticker::Clock::time_point deadline, std::chrono::nanoseconds spinThreshold = SPIN_THRESHOLD);
+
+private:
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::vector<std::shared_ptr<Ticker>> tickers;
+    bool stopping = false;
+    //Whether the tickers changed since run() last copied them.
+    bool tickersChanged = false;
 };
 
 
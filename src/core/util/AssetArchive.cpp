@@ -0,0 +1,128 @@
+#include "AssetArchive.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+#include "Lz4.h"
+
+std::vector<std::shared_ptr<const AssetArchive>> AssetArchive::mounted;
+std::mutex AssetArchive::mountMutex;
+
+static constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+static constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+static uint64_t fnv1a(const unsigned char* data, const size_t size, uint64_t hash = FNV_OFFSET_BASIS) {
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ data[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+AssetArchive::AssetArchive(const std::string &path): file(path) {
+    if (!file.isOpen() || file.size() < sizeof(AssetArchiveHeader)) {
+        file = MappedFile();
+        return;
+    }
+
+    AssetArchiveHeader header;
+    memcpy(&header, file.data(), sizeof(header));
+    if (header.magic != AssetArchiveHeader::MAGIC || header.version != AssetArchiveHeader::VERSION ||
+        header.entryCount > (file.size() - sizeof(header)) / sizeof(AssetArchiveEntry)) {
+        file = MappedFile();
+        return;
+    }
+
+    entries.resize(header.entryCount);
+    memcpy(entries.data(), file.data() + sizeof(header), entries.size() * sizeof(AssetArchiveEntry));
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const AssetArchiveEntry &entry = entries[i];
+        const bool validCompression = entry.compression == AssetArchiveEntry::LZ4 ||
+                                      (entry.compression == AssetArchiveEntry::NONE && entry.storedSize == entry.size);
+        //storedSize is bounded by the file's size first, so the bound on size can't overflow. size is what readers
+        //allocate, so it can't be trusted any further than that.
+        if (!validCompression || entry.offset > file.size() || entry.storedSize > file.size() - entry.offset ||
+            (entry.compression == AssetArchiveEntry::LZ4 &&
+             entry.size > Lz4::getMaxDecompressedSize(entry.storedSize)) ||
+            (i > 0 && entries[i - 1].pathHash >= entry.pathHash)) {
+            entries.clear();
+            file = MappedFile();
+            return;
+        }
+    }
+}
+
+bool AssetArchive::isOpen() const {
+    return file.isOpen();
+}
+
+const AssetArchiveEntry *AssetArchive::find(const std::string_view assetPath) const {
+    const uint64_t hash = hashPath(assetPath);
+    const auto entry = std::lower_bound(entries.begin(), entries.end(), hash, [](const AssetArchiveEntry &entry,
+                                                                                 const uint64_t value) {
+        return entry.pathHash < value;
+    });
+    return entry != entries.end() && entry->pathHash == hash ? &*entry : nullptr;
+}
+
+MappedFile::View AssetArchive::getStoredContents(const AssetArchiveEntry &entry) const {
+    return file.view(entry.offset, entry.storedSize);
+}
+
+bool AssetArchive::read(const AssetArchiveEntry &entry, unsigned char* destination) const {
+    const MappedFile::View stored = getStoredContents(entry);
+    switch (entry.compression) {
+        case AssetArchiveEntry::NONE:
+            if (stored.size > 0) {
+                memcpy(destination, stored.data, stored.size);
+            }
+            return true;
+        case AssetArchiveEntry::LZ4:
+            return Lz4::decompress(stored.data, stored.size, destination, entry.size);
+    }
+    return false;
+}
+
+void AssetArchive::populate() const {
+    file.populate();
+}
+
+const std::vector<AssetArchiveEntry> &AssetArchive::getEntries() const {
+    return entries;
+}
+
+uint64_t AssetArchive::hashPath(const std::string_view path) {
+    const std::string normalized = std::filesystem::path(path).lexically_normal().generic_string();
+    return fnv1a(reinterpret_cast<const unsigned char*>(normalized.data()), normalized.size());
+}
+
+uint64_t AssetArchive::hashContents(const unsigned char* data, const size_t size) {
+    return fnv1a(data, size);
+}
+
+std::shared_ptr<const AssetArchive> AssetArchive::mount(const std::string &path) {
+    auto archive = std::make_shared<const AssetArchive>(path);
+    if (!archive->isOpen()) {
+        return nullptr;
+    }
+    std::lock_guard lock(mountMutex);
+    mounted.push_back(archive);
+    return archive;
+}
+
+void AssetArchive::unmountAll() {
+    std::lock_guard lock(mountMutex);
+    mounted.clear();
+}
+
+std::shared_ptr<const AssetArchive> AssetArchive::findMounted(const std::string_view assetPath,
+                                                              const AssetArchiveEntry* &entry) {
+    std::lock_guard lock(mountMutex);
+    for (auto archive = mounted.rbegin(); archive != mounted.rend(); ++archive) {
+        if (const AssetArchiveEntry* found = (*archive)->find(assetPath)) {
+            entry = found;
+            return *archive;
+        }
+    }
+    return nullptr;
+}
@@ -0,0 +1,96 @@
+#ifndef ASSETARCHIVE_H
+#define ASSETARCHIVE_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "MappedFile.h"
+
+//Every asset in an archive, found by the hash of its path. Written by XTPPack.
+//
+//The file starts with an AssetArchiveHeader, followed by the entries sorted by pathHash, followed by the contents. Each
+//content starts at a multiple of CONTENT_ALIGNMENT, or of PAGE_ALIGNMENT if it is at least PAGE_ALIGNED_SIZE bytes, so
+//anything stored uncompressed can be read straight out of the mapped archive, or copied into a staging buffer as is.
+//Assets with the same contents share them.
+struct AssetArchiveHeader {
+    static constexpr uint32_t MAGIC = 0x41505458; //"XTPA"
+    static constexpr uint32_t VERSION = 1;
+
+    uint32_t magic;
+    uint32_t version;
+    uint64_t entryCount;
+};
+
+struct AssetArchiveEntry {
+    enum Compression : uint32_t {
+        NONE = 0,
+        //A single LZ4 block.
+        LZ4 = 1
+    };
+
+    uint64_t pathHash;
+    uint64_t contentHash;
+    uint64_t offset;
+    uint64_t storedSize;
+    uint64_t size;
+    Compression compression;
+    uint32_t reserved;
+};
+
+//A read only, memory mapped asset archive. Mounted archives are what AssetFile reads assets from before it looks for
+//loose files.
+class AssetArchive {
+public:
+    static constexpr uint64_t CONTENT_ALIGNMENT = 16;
+    static constexpr uint64_t PAGE_ALIGNMENT = 4096;
+    static constexpr uint64_t PAGE_ALIGNED_SIZE = 64 * 1024;
+
+    //Check isOpen() afterwards, the file may not exist or not be an archive.
+    explicit AssetArchive(const std::string &path);
+
+    //False if the file couldn't be mapped or its header or entries are invalid.
+    [[nodiscard]] bool isOpen() const;
+
+    //nullptr if the archive doesn't have the asset.
+    [[nodiscard]] const AssetArchiveEntry* find(std::string_view assetPath) const;
+
+    //The contents as they are stored, which is only the asset itself if entry.compression is NONE.
+    [[nodiscard]] MappedFile::View getStoredContents(const AssetArchiveEntry &entry) const;
+
+    //Writes the entry.size bytes of the asset to destination, decompressing them if needed. Returns false if the
+    //contents are corrupt.
+    bool read(const AssetArchiveEntry &entry, unsigned char* destination) const;
+
+    //Reads the whole archive in from disk, which is a few large sequential reads instead of one per asset.
+    void populate() const;
+
+    [[nodiscard]] const std::vector<AssetArchiveEntry> &getEntries() const;
+
+    //Paths are normalized first, so "./assets/a.png" and "assets/a.png" are the same asset.
+    [[nodiscard]] static uint64_t hashPath(std::string_view path);
+
+    [[nodiscard]] static uint64_t hashContents(const unsigned char* data, size_t size);
+
+    //Returns nullptr, mounting nothing, if the archive can't be opened. Archives mounted later are searched first.
+    static std::shared_ptr<const AssetArchive> mount(const std::string &path);
+
+    static void unmountAll();
+
+    //Searches the mounted archives for the asset. entry is only set if an archive is returned.
+    static std::shared_ptr<const AssetArchive> findMounted(std::string_view assetPath, const AssetArchiveEntry* &entry);
+
+private:
+    static std::vector<std::shared_ptr<const AssetArchive>> mounted;
+    static std::mutex mountMutex;
+
+    MappedFile file;
+    std::vector<AssetArchiveEntry> entries;
+};
+
+
+
+#endif //ASSETARCHIVE_H
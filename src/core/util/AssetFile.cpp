@@ -0,0 +1,63 @@
+#include "AssetFile.h"
+
+#include <new>
+
+AssetFile::AssetFile(const std::string &path) {
+    const AssetArchiveEntry* entry = nullptr;
+    archive = AssetArchive::findMounted(path, entry);
+    if (archive == nullptr) {
+        file = MappedFile(path);
+        open = file.isOpen();
+        contents = file.data();
+        contentSize = file.size();
+        return;
+    }
+
+    if (entry->compression == AssetArchiveEntry::NONE) {
+        const MappedFile::View stored = archive->getStoredContents(*entry);
+        contents = stored.data;
+        contentSize = stored.size;
+        open = true;
+        return;
+    }
+
+    //Loader threads open assets, so running out of memory fails the load instead of throwing.
+    decompressed = std::unique_ptr<unsigned char[]>(new (std::nothrow) unsigned char[entry->size]);
+    if (decompressed != nullptr && archive->read(*entry, decompressed.get())) {
+        contents = decompressed.get();
+        contentSize = entry->size;
+        open = true;
+    }
+}
+
+bool AssetFile::isOpen() const {
+    return open;
+}
+
+const unsigned char *AssetFile::data() const {
+    return contents;
+}
+
+size_t AssetFile::size() const {
+    return contentSize;
+}
+
+bool AssetFile::isFromArchive() const {
+    return archive != nullptr;
+}
+
+void AssetFile::populate() const {
+    if (archive == nullptr) {
+        file.populate();
+        return;
+    }
+    if (decompressed != nullptr) {
+        return;
+    }
+    //Only the entry's part of the archive mapping, the rest may never be needed.
+    unsigned char sum = 0;
+    for (size_t offset = 0; offset < contentSize; offset += 4096) {
+        sum += static_cast<const volatile unsigned char*>(contents)[offset];
+    }
+    static_cast<void>(sum);
+}
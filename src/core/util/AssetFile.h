@@ -0,0 +1,43 @@
+#ifndef ASSETFILE_H
+#define ASSETFILE_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "AssetArchive.h"
+#include "MappedFile.h"
+
+//The contents of an asset, from the most recently mounted AssetArchive that has it, or else mapped from the loose file at
+//its path. Uncompressed archive entries and loose files are read in place; compressed entries are decompressed into a
+//buffer. Either way data() is at least 16 byte aligned.
+class AssetFile {
+public:
+    //Check isOpen() afterwards, the asset may not exist or its archive entry may be corrupt.
+    explicit AssetFile(const std::string &path);
+
+    [[nodiscard]] bool isOpen() const;
+
+    [[nodiscard]] const unsigned char* data() const;
+
+    [[nodiscard]] size_t size() const;
+
+    //Whether the asset was found in a mounted archive.
+    [[nodiscard]] bool isFromArchive() const;
+
+    //Reads every page of the asset in from disk, like MappedFile::populate(). Decompressed assets already are.
+    void populate() const;
+
+private:
+    MappedFile file;
+    //Keeps the mapping data() points into alive.
+    std::shared_ptr<const AssetArchive> archive;
+    std::unique_ptr<unsigned char[]> decompressed;
+    const unsigned char* contents = nullptr;
+    size_t contentSize = 0;
+    bool open = false;
+};
+
+
+
+#endif //ASSETFILE_H
@@ -9,6 +9,7 @@
 
 class FileUtil {
 public:
+    //Copies the whole file into a buffer. MappedFile reads it in place instead, which is what the engine's loaders use.
     static std::vector<char> readFile(const std::string& filename) {
         const std::string res = std::filesystem::absolute(filename);
         std::ifstream file(res, std::ios::ate | std::ios::binary);
@@ -0,0 +1,266 @@
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "Profiler.h"
+
+std::vector<std::thread> JobSystem::workers;
+std::vector<std::unique_ptr<JobSystem::WorkStealingDeque>> JobSystem::deques;
+std::deque<JobSystem::Job*> JobSystem::sharedJobs;
+std::mutex JobSystem::sharedMutex;
+std::condition_variable JobSystem::jobAvailable;
+std::atomic<uint32_t> JobSystem::queuedJobs;
+std::atomic<uint32_t> JobSystem::sleepingWorkers;
+bool JobSystem::stopping;
+thread_local int32_t JobSystem::workerIndex = -1;
+
+bool JobSystem::WorkStealingDeque::push(Job *job) {
+    const int64_t b = bottom.load(std::memory_order_relaxed);
+    const int64_t t = top.load(std::memory_order_acquire);
+    if (b - t >= CAPACITY) {
+        return false;
+    }
+    jobs[b & (CAPACITY - 1)].store(job, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom.store(b + 1, std::memory_order_relaxed);
+    return true;
+}
+
+JobSystem::Job *JobSystem::WorkStealingDeque::pop() {
+    const int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top.load(std::memory_order_relaxed);
+
+    if (t > b) {
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    Job* job = jobs[b & (CAPACITY - 1)].load(std::memory_order_relaxed);
+    if (t == b) {
+        //The last job, which a thief may be taking at the same time.
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            job = nullptr;
+        }
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+    return job;
+}
+
+JobSystem::Job *JobSystem::WorkStealingDeque::steal() {
+    int64_t t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const int64_t b = bottom.load(std::memory_order_acquire);
+    if (t >= b) {
+        return nullptr;
+    }
+
+    Job* job = jobs[t & (CAPACITY - 1)].load(std::memory_order_relaxed);
+    if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return nullptr;
+    }
+    return job;
+}
+
+void JobSystem::init(const uint32_t workerCount) {
+    stopping = false;
+    queuedJobs = 0;
+    sleepingWorkers = 0;
+    deques.clear();
+    for (uint32_t i = 0; i < workerCount; ++i) {
+        deques.emplace_back(std::make_unique<WorkStealingDeque>());
+    }
+    //Every deque has to exist before any worker starts stealing.
+    for (uint32_t i = 0; i < workerCount; ++i) {
+        workers.emplace_back(workerLoop, i);
+    }
+}
+
+void JobSystem::cleanUp() {
+    {
+        std::lock_guard lock(sharedMutex);
+        stopping = true;
+    }
+    jobAvailable.notify_all();
+    for (std::thread &worker: workers) {
+        worker.join();
+    }
+    workers.clear();
+
+    for (const std::unique_ptr<WorkStealingDeque> &deque: deques) {
+        while (Job* job = deque->steal()) {
+            delete job;
+        }
+    }
+    deques.clear();
+    for (const Job* job: sharedJobs) {
+        delete job;
+    }
+    sharedJobs.clear();
+    queuedJobs = 0;
+}
+
+void JobSystem::run(std::function<void()> &&job, JobCounter *counter) {
+    if (counter != nullptr) {
+        counter->remaining.fetch_add(1, std::memory_order_relaxed);
+    }
+    Job* newJob = new Job {std::move(job), counter};
+
+    //Counted before it can be taken, so the count never drops below zero.
+    queuedJobs.fetch_add(1);
+    if (workerIndex < 0 || !deques[workerIndex]->push(newJob)) {
+        std::lock_guard lock(sharedMutex);
+        sharedJobs.emplace_back(newJob);
+    }
+
+    //Workers count themselves as sleeping before checking queuedJobs, so either they see the job or this sees them.
+    if (sleepingWorkers.load() > 0) {
+        //Taking the lock ensures a worker that is about to sleep has started waiting before it is notified.
+        { std::lock_guard lock(sharedMutex); }
+        jobAvailable.notify_one();
+    }
+}
+
+void JobSystem::wait(JobCounter &counter) {
+    while (!counter.isDone()) {
+        if (Job* job = findJobOf(counter)) {
+            execute(job);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    std::lock_guard lock(counter.errorMutex);
+    if (counter.error != nullptr) {
+        std::rethrow_exception(std::exchange(counter.error, nullptr));
+    }
+}
+
+void JobSystem::parallelFor(const size_t count, const size_t grainSize,
+                            const std::function<void(size_t first, size_t last)> &body) {
+    const size_t grain = std::max<size_t>(grainSize, 1);
+    if (count <= grain) {
+        body(0, count);
+        return;
+    }
+
+    JobCounter counter;
+    for (size_t first = grain; first < count; first += grain) {
+        run([&body, first, last = std::min(count, first + grain)] { body(first, last); }, &counter);
+    }
+    //The first range runs on the calling thread, which then helps with the rest. The other ranges use body, so they have
+    //to finish before an exception from this one can leave.
+    std::exception_ptr error;
+    try {
+        body(0, grain);
+    } catch (...) {
+        error = std::current_exception();
+    }
+    wait(counter);
+    if (error != nullptr) {
+        std::rethrow_exception(error);
+    }
+}
+
+uint32_t JobSystem::getWorkerCount() {
+    return static_cast<uint32_t>(workers.size());
+}
+
+void JobSystem::workerLoop(const uint32_t index) {
+    workerIndex = static_cast<int32_t>(index);
+    Profiler::setThreadName("Job Worker " + std::to_string(index));
+    while (true) {
+        if (Job* job = findJob()) {
+            execute(job);
+            continue;
+        }
+
+        std::unique_lock lock(sharedMutex);
+        sleepingWorkers.fetch_add(1);
+        jobAvailable.wait(lock, [] { return stopping || queuedJobs.load() > 0; });
+        sleepingWorkers.fetch_sub(1);
+        if (stopping) {
+            return;
+        }
+    }
+}
+
+JobSystem::Job *JobSystem::findJob() {
+    if (queuedJobs.load(std::memory_order_relaxed) == 0) {
+        return nullptr;
+    }
+
+    Job* job = nullptr;
+    if (workerIndex >= 0) {
+        job = deques[workerIndex]->pop();
+    }
+    if (job == nullptr) {
+        std::lock_guard lock(sharedMutex);
+        if (!sharedJobs.empty()) {
+            job = sharedJobs.front();
+            sharedJobs.pop_front();
+        }
+    }
+    //Starting with the next deque spreads thieves over all of them.
+    const size_t start = workerIndex >= 0 ? workerIndex + 1 : 0;
+    for (size_t i = 0; job == nullptr && i < deques.size(); ++i) {
+        job = deques[(start + i) % deques.size()]->steal();
+    }
+
+    if (job != nullptr) {
+        queuedJobs.fetch_sub(1);
+    }
+    return job;
+}
+
+JobSystem::Job *JobSystem::findJobOf(const JobCounter &counter) {
+    if (queuedJobs.load(std::memory_order_relaxed) == 0) {
+        return nullptr;
+    }
+
+    Job* job = nullptr;
+    if (workerIndex >= 0) {
+        //The batch was pushed last, so anything else at the bottom means none of its jobs are left in the deque.
+        job = deques[workerIndex]->pop();
+        if (job != nullptr && job->counter != &counter) {
+            deques[workerIndex]->push(job);
+            job = nullptr;
+        }
+    }
+    if (job == nullptr) {
+        std::lock_guard lock(sharedMutex);
+        const auto found = std::find_if(sharedJobs.begin(), sharedJobs.end(), [&counter](const Job* sharedJob) {
+            return sharedJob->counter == &counter;
+        });
+        if (found != sharedJobs.end()) {
+            job = *found;
+            sharedJobs.erase(found);
+        }
+    }
+
+    if (job != nullptr) {
+        queuedJobs.fetch_sub(1);
+    }
+    return job;
+}
+
+void JobSystem::execute(Job *job) {
+    JobCounter* counter = job->counter;
+    try {
+        job->function();
+    } catch (...) {
+        if (counter != nullptr) {
+            std::lock_guard lock(counter->errorMutex);
+            if (counter->error == nullptr) {
+                counter->error = std::current_exception();
+            }
+        }
+    }
+    delete job;
+    //The waiting thread may destroy the counter as soon as this reaches zero.
+    if (counter != nullptr) {
+        counter->remaining.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
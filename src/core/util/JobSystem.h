@@ -0,0 +1,107 @@
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+//Counts the unfinished jobs started with it. The first exception thrown by one of them is rethrown by JobSystem::wait.
+class JobCounter {
+public:
+    [[nodiscard]] bool isDone() const {
+        return remaining.load(std::memory_order_acquire) == 0;
+    }
+
+private:
+    friend class JobSystem;
+
+    std::atomic<uint32_t> remaining {0};
+    std::mutex errorMutex;
+    std::exception_ptr error;
+};
+
+//A work-stealing job scheduler. Every worker has its own Chase-Lev deque: it pushes and pops jobs at one end without
+//locking, and idle workers steal from the other end. Jobs started from threads that aren't workers, like the render and
+//tick threads, go through a shared queue instead.
+//
+//Waiting on a counter runs the counter's own jobs that haven't started yet until it is done, so jobs can start and wait
+//on jobs of their own, and the thread that starts a batch helps finish it. Jobs of other batches are left to the
+//workers, so e.g. the render thread never picks up tick work while waiting for its recording chunks. Jobs shouldn't
+//block on anything else for long, e.g. file reads, since that keeps their worker from running other jobs.
+class JobSystem {
+public:
+    //workerCount may be 0, in which case every job runs on the thread waiting for it, and jobs nobody waits for never run.
+    static void init(uint32_t workerCount);
+
+    //Jobs that haven't started yet are dropped.
+    static void cleanUp();
+
+    //counter may be nullptr if nobody waits for the job, in which case exceptions it throws are lost.
+    static void run(std::function<void()>&& job, JobCounter* counter = nullptr);
+
+    static void wait(JobCounter& counter);
+
+    //Calls body(first, last) on ranges of at most grainSize indices covering [0, count), in parallel, and returns once
+    //all of them have finished.
+    static void parallelFor(size_t count, size_t grainSize, const std::function<void(size_t first, size_t last)>& body);
+
+    [[nodiscard]] static uint32_t getWorkerCount();
+
+private:
+    struct Job {
+        std::function<void()> function;
+        JobCounter* counter;
+    };
+
+    //A fixed size Chase-Lev deque. Only its owner pushes and pops, any thread may steal.
+    class WorkStealingDeque {
+    public:
+        //Returns false if the deque is full.
+        bool push(Job* job);
+
+        Job* pop();
+
+        Job* steal();
+
+    private:
+        static constexpr int64_t CAPACITY = 4096;
+
+        std::atomic<int64_t> top {0};
+        std::atomic<int64_t> bottom {0};
+        std::atomic<Job*> jobs[CAPACITY] {};
+    };
+
+    static std::vector<std::thread> workers;
+    static std::vector<std::unique_ptr<WorkStealingDeque>> deques;
+    static std::deque<Job*> sharedJobs;
+    static std::mutex sharedMutex;
+    static std::condition_variable jobAvailable;
+    //Jobs that have been started but not picked up yet, so idle workers know whether to go to sleep.
+    static std::atomic<uint32_t> queuedJobs;
+    static std::atomic<uint32_t> sleepingWorkers;
+    static bool stopping;
+    //The index of the calling thread's deque, or -1 if it isn't a worker.
+    static thread_local int32_t workerIndex;
+
+    static void workerLoop(uint32_t index);
+
+    static Job* findJob();
+
+    //Only takes jobs started with counter, from the calling thread's own deque and the shared queue, which is where
+    //jobs it started are unless they have been stolen.
+    static Job* findJobOf(const JobCounter& counter);
+
+    static void execute(Job* job);
+};
+
+
+
+#endif //JOBSYSTEM_H
@@ -0,0 +1,184 @@
+#include "Lz4.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+static constexpr size_t MIN_MATCH = 4;
+//The format requires the last 5 bytes to be literals, and the last match to start at least 12 bytes before the end.
+static constexpr size_t LAST_LITERALS = 5;
+static constexpr size_t MATCH_START_LIMIT = 12;
+static constexpr size_t MAX_OFFSET = 65535;
+static constexpr uint32_t HASH_BITS = 16;
+
+static uint32_t read32(const unsigned char* data) {
+    uint32_t value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+static uint32_t hash(const uint32_t sequence) {
+    return sequence * 2654435761u >> (32 - HASH_BITS);
+}
+
+//Lengths that don't fit in their half of the token continue in bytes of 255, ended by a byte less than that.
+static bool writeLength(size_t length, unsigned char* destination, size_t &out, const size_t capacity) {
+    while (length >= 255) {
+        if (out >= capacity) {
+            return false;
+        }
+        destination[out++] = 255;
+        length -= 255;
+    }
+    if (out >= capacity) {
+        return false;
+    }
+    destination[out++] = static_cast<unsigned char>(length);
+    return true;
+}
+
+static bool readLength(const unsigned char* source, size_t &in, const size_t sourceSize, size_t &length) {
+    unsigned char byte;
+    do {
+        if (in >= sourceSize) {
+            return false;
+        }
+        byte = source[in++];
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+//Writes the literals from anchor up to position, followed by the match if matchLength isn't 0.
+static bool writeSequence(const unsigned char* source, const size_t anchor, const size_t position, const size_t offset,
+                          const size_t matchLength, unsigned char* destination, size_t &out, const size_t capacity) {
+    const size_t literalLength = position - anchor;
+    if (out >= capacity) {
+        return false;
+    }
+    const size_t token = out++;
+    destination[token] = static_cast<unsigned char>(std::min<size_t>(literalLength, 15) << 4);
+    if (literalLength >= 15 && !writeLength(literalLength - 15, destination, out, capacity)) {
+        return false;
+    }
+    if (literalLength > capacity - out) {
+        return false;
+    }
+    if (literalLength > 0) {
+        memcpy(destination + out, source + anchor, literalLength);
+    }
+    out += literalLength;
+
+    if (matchLength == 0) {
+        return true;
+    }
+    if (capacity - out < 2) {
+        return false;
+    }
+    destination[out++] = static_cast<unsigned char>(offset);
+    destination[out++] = static_cast<unsigned char>(offset >> 8);
+    const size_t extraLength = matchLength - MIN_MATCH;
+    destination[token] |= static_cast<unsigned char>(std::min<size_t>(extraLength, 15));
+    return extraLength < 15 || writeLength(extraLength - 15, destination, out, capacity);
+}
+
+size_t Lz4::getMaxCompressedSize(const size_t size) {
+    return size + size / 255 + 16;
+}
+
+size_t Lz4::getMaxDecompressedSize(const size_t compressedSize) {
+    return compressedSize * 255 + 16;
+}
+
+size_t Lz4::compress(const unsigned char* source, const size_t size, unsigned char* destination, const size_t capacity) {
+    //Positions are stored plus one, so 0 means the hash hasn't been seen yet.
+    std::vector<size_t> table(1 << HASH_BITS, 0);
+    size_t out = 0;
+    size_t anchor = 0;
+    size_t position = 0;
+
+    while (size >= MATCH_START_LIMIT && position <= size - MATCH_START_LIMIT) {
+        const uint32_t sequence = read32(source + position);
+        size_t &entry = table[hash(sequence)];
+        const size_t candidate = entry;
+        entry = position + 1;
+        if (candidate == 0 || position - (candidate - 1) > MAX_OFFSET || read32(source + candidate - 1) != sequence) {
+            ++position;
+            continue;
+        }
+
+        const size_t match = candidate - 1;
+        size_t length = MIN_MATCH;
+        while (position + length < size - LAST_LITERALS && source[match + length] == source[position + length]) {
+            ++length;
+        }
+        if (!writeSequence(source, anchor, position, position - match, length, destination, out, capacity)) {
+            return 0;
+        }
+        position += length;
+        anchor = position;
+    }
+
+    if (!writeSequence(source, anchor, size, 0, 0, destination, out, capacity)) {
+        return 0;
+    }
+    return out;
+}
+
+bool Lz4::decompress(const unsigned char* source, const size_t sourceSize, unsigned char* destination,
+                     const size_t size) {
+    size_t in = 0;
+    size_t out = 0;
+    while (in < sourceSize) {
+        const unsigned char token = source[in++];
+
+        size_t literalLength = token >> 4;
+        if (literalLength == 15 && !readLength(source, in, sourceSize, literalLength)) {
+            return false;
+        }
+        if (literalLength > sourceSize - in || literalLength > size - out) {
+            return false;
+        }
+        if (literalLength > 0) {
+            memcpy(destination + out, source + in, literalLength);
+        }
+        in += literalLength;
+        out += literalLength;
+
+        //The last sequence only has literals.
+        if (in == sourceSize) {
+            break;
+        }
+
+        if (sourceSize - in < 2) {
+            return false;
+        }
+        const size_t offset = source[in] | static_cast<size_t>(source[in + 1]) << 8;
+        in += 2;
+        if (offset == 0 || offset > out) {
+            return false;
+        }
+
+        size_t matchLength = token & 15;
+        if (matchLength == 15 && !readLength(source, in, sourceSize, matchLength)) {
+            return false;
+        }
+        matchLength += MIN_MATCH;
+        if (matchLength > size - out) {
+            return false;
+        }
+
+        const unsigned char* match = destination + out - offset;
+        if (offset >= matchLength) {
+            memcpy(destination + out, match, matchLength);
+        } else {
+            //The match overlaps what it is copied to, which repeats the last offset bytes.
+            for (size_t i = 0; i < matchLength; ++i) {
+                destination[out + i] = match[i];
+            }
+        }
+        out += matchLength;
+    }
+    return out == size;
+}
@@ -0,0 +1,28 @@
+#ifndef LZ4_H
+#define LZ4_H
+
+#include <cstddef>
+
+
+//Compresses and decompresses single blocks in the LZ4 block format, without the frame format around them, so they can
+//be read by any LZ4 implementation and the other way around. Compression is greedy with one candidate per hash, which is
+//fast and good enough for data that is compressed once offline; decompression is what has to be fast.
+class Lz4 {
+public:
+    [[nodiscard]] static size_t getMaxCompressedSize(size_t size);
+
+    //The most a block of compressedSize bytes can decompress to. A match can't copy more than 255 bytes per byte of
+    //its length, so anything claiming to be larger is malformed.
+    [[nodiscard]] static size_t getMaxDecompressedSize(size_t compressedSize);
+
+    //Returns the compressed size, or 0 if it doesn't fit in capacity bytes.
+    static size_t compress(const unsigned char* source, size_t size, unsigned char* destination, size_t capacity);
+
+    //size is the size of the decompressed data, which has to be stored alongside the block. Returns false if the block is
+    //malformed or doesn't decompress to exactly size bytes, without ever writing past destination + size.
+    static bool decompress(const unsigned char* source, size_t sourceSize, unsigned char* destination, size_t size);
+};
+
+
+
+#endif //LZ4_H
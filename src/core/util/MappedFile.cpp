@@ -0,0 +1,130 @@
+#include "MappedFile.h"
+
+#include <algorithm>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::string &path) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        return;
+    }
+    mappedSize = static_cast<size_t>(fileSize.QuadPart);
+    if (mappedSize > 0) {
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping != nullptr) {
+            mappedData = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            //The view keeps the mapping alive on its own.
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+#else
+    const int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0) {
+        return;
+    }
+    struct stat fileStat {};
+    if (fstat(file, &fileStat) != 0) {
+        ::close(file);
+        return;
+    }
+    mappedSize = static_cast<size_t>(fileStat.st_size);
+    if (mappedSize > 0) {
+        void* mapping = mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, file, 0);
+        if (mapping != MAP_FAILED) {
+            mappedData = static_cast<const unsigned char*>(mapping);
+            //Files are mostly read front to back, so the kernel can read ahead aggressively.
+            madvise(mapping, mappedSize, MADV_SEQUENTIAL);
+        }
+    }
+    //The mapping stays valid after the descriptor is closed.
+    ::close(file);
+#endif
+    open = mappedSize == 0 || mappedData != nullptr;
+    if (!open) {
+        mappedSize = 0;
+    }
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+    if (this != &other) {
+        close();
+        mappedData = std::exchange(other.mappedData, nullptr);
+        mappedSize = std::exchange(other.mappedSize, 0);
+        open = std::exchange(other.open, false);
+    }
+    return *this;
+}
+
+bool MappedFile::isOpen() const {
+    return open;
+}
+
+const unsigned char *MappedFile::data() const {
+    return mappedData;
+}
+
+size_t MappedFile::size() const {
+    return mappedSize;
+}
+
+MappedFile::View MappedFile::view(const size_t offset, const size_t size) const {
+    if (offset >= mappedSize) {
+        return {nullptr, 0};
+    }
+    return {mappedData + offset, std::min(size, mappedSize - offset)};
+}
+
+void MappedFile::populate() const {
+    if (mappedData == nullptr) {
+        return;
+    }
+#ifndef _WIN32
+    //Starts reading everything at once, instead of one page fault at a time below.
+    madvise(const_cast<unsigned char*>(mappedData), mappedSize, MADV_WILLNEED);
+#endif
+    //Touching one byte per page is enough to fault all of it in. 4 KiB is the smallest page size on every platform.
+    unsigned char sum = 0;
+    for (size_t offset = 0; offset < mappedSize; offset += 4096) {
+        sum += static_cast<const volatile unsigned char*>(mappedData)[offset];
+    }
+    static_cast<void>(sum);
+}
+
+void MappedFile::close() {
+    if (mappedData != nullptr) {
+#ifdef _WIN32
+        UnmapViewOfFile(mappedData);
+#else
+        munmap(const_cast<unsigned char*>(mappedData), mappedSize);
+#endif
+    }
+    mappedData = nullptr;
+    mappedSize = 0;
+    open = false;
+}
@@ -0,0 +1,58 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+
+//A read only view of a whole file, mapped into memory instead of read into a buffer. Pages are only read from disk once
+//they are touched, and the mapping is released when the MappedFile is destroyed. data() starts on a page boundary, so
+//anything at an offset that is a multiple of its alignment can be read in place, e.g. SPIR-V as uint32_t.
+class MappedFile {
+public:
+    //Part of the file. Only valid as long as the MappedFile it came from.
+    struct View {
+        const unsigned char* data;
+        size_t size;
+    };
+
+    MappedFile() = default;
+
+    //Check isOpen() afterwards, the file may not exist or be readable.
+    explicit MappedFile(const std::string& path);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    [[nodiscard]] bool isOpen() const;
+
+    [[nodiscard]] const unsigned char* data() const;
+
+    [[nodiscard]] size_t size() const;
+
+    //Clamped to the end of the file, so the view is empty if offset is past it.
+    [[nodiscard]] View view(size_t offset, size_t size) const;
+
+    //Reads every page in from disk, so later reads don't block on it. Meant for loader threads, which can then hand the
+    //file to a thread that shouldn't block.
+    void populate() const;
+
+private:
+    const unsigned char* mappedData = nullptr;
+    size_t mappedSize = 0;
+    //Empty files can't be mapped, but still open successfully.
+    bool open = false;
+
+    void close();
+};
+
+
+
+#endif //MAPPEDFILE_H
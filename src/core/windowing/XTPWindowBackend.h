@@ -54,6 +54,11 @@ public:
     virtual glm::dvec2 getMouseDelta() = 0;
 
     virtual glm::dvec2 getScrollDelta() = 0;
+
+    //If true, the renderer will not create a surface or swapchain and will instead render into offscreen images.
+    virtual bool isHeadless() {
+        return false;
+    }
 };
 
 
@@ -11,7 +11,7 @@ function(compileShaders TARGET SHADER_DIR)
 
     set(SHADER_PRODUCTS)
 
-    add_custom_command(TARGET XTPTest POST_BUILD
+    add_custom_command(TARGET ${TARGET} POST_BUILD
             COMMAND mkdir -p ${CMAKE_BINARY_DIR}/bin/assets/shaders
             BYPRODUCTS "${CMAKE_BINARY_DIR}/bin/assets/shaders/${SHADER_NAME}.spv"
             COMMENT "Creating Shader Directory"
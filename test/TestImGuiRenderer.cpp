@@ -8,7 +8,9 @@
 #include "imgui_internal.h"
 #include "implot.h"
 #include "implot_internal.h"
+#include "ProfilerPanel.h"
 #include "TimeManager.h"
+#include "XTP.h"
 #include "XTPVulkan.h"
 #include "renderable/MergedMeshRenderable.h"
 
@@ -121,7 +123,24 @@ void TestImGuiRenderer::render() {
 
         ImGui::Unindent(15);
     }
+
+    if (ImGui::CollapsingHeader("Tick Info")) {
+        ImGui::Indent(15);
+        const TickStatistics statistics = XTP::ticker->getStatistics();
+        const auto toMilis = [](const std::chrono::nanoseconds duration) {
+            return std::chrono::duration<double, std::milli>(duration).count();
+        };
+        ImGui::Text("Ticks: %llu (%llu Skipped)", static_cast<unsigned long long>(statistics.tickCount),
+                    static_cast<unsigned long long>(statistics.skippedTicks));
+        ImGui::Text("Tick Time (ms): %.3f Last, %.3f Average, %.3f Max", toMilis(statistics.lastTickDuration),
+                    toMilis(statistics.averageTickDuration), toMilis(statistics.maxTickDuration));
+        ImGui::Text("Last Tick Late By (ms): %.3f", toMilis(statistics.lastTickLateness));
+        ImGui::Text("Interpolation Alpha: %.2f", XTPVulkan::tickInterpolationAlpha);
+        ImGui::Unindent(15);
+    }
     ImGui::End();
+
+    ProfilerPanel::draw();
 }
 #endif
 #endif
\ No newline at end of file
@@ -19,7 +19,7 @@ public:
     static std::shared_ptr<Material> TEST_MTL;
 
     TestRenderable(const std::shared_ptr<SimpleShaderObject> &shader, std::shared_ptr<Mesh> mesh)
-        : SimpleIndexBufferedRenderable(shader, std::move(mesh)) {
+        : SimpleIndexBufferedRenderable(shader, std::move(mesh), createTransform()) {
     }
 
     std::shared_ptr<Material> getMaterial() override {
@@ -29,36 +29,28 @@ public:
         return TEST_MTL;
     }
 
-    void draw(VkCommandBuffer commandBuffer, uint32_t imageIndex) override {
-        glm::mat4 mtx = glm::identity<glm::mat4>();
-        mtx = rotate(mtx, glm::radians(0.0f), glm::vec3(1, 0, 0));
-        mtx = rotate(mtx, glm::radians(0.0f), glm::vec3(0, 1, 0));
-        mtx = rotate(mtx, glm::radians(0.0f), glm::vec3(0, 0, 1));
-        mtx = translate(mtx, glm::vec3(0, 0, 0));
-        mtx = scale(mtx, glm::vec3(1, 1, 1));
-
-        transformBuffer.bufferValue = mtx;
-        transformBuffer.markBuffersDirty();
-
-        transformBuffer.onFrame(XTPVulkan::currentFrameIndex);
-        getMesh()->getVertexBuffer().bind(commandBuffer);
-        getMesh()->getIndexBuffer().bind(commandBuffer);
-
-
-        SimpleShaderObject::bindPushConstant(commandBuffer, getPushConstants(XTPVulkan::currentFrameIndex), shader.get());
-        vkCmdDrawIndexed(commandBuffer, mesh->getIndexCount(), 1, 0, 0, 0);
-    }
-
     TestShaderData getPushConstants(const uint32_t frameIndex) override {
         return TestShaderData {
             XTPVulkan::globalSceneDataBuffers[frameIndex].gpuAddress,
-            transformBuffer.getBuffer(frameIndex)->gpuAddress
+            transformBuffer.getAddress(frameIndex)
         };
     }
 
     void createBuffers() override {
 
     }
+
+private:
+    //The transform starts out as the tick state's initial value, so it goes through tickTransform like any other write.
+    static glm::mat4 createTransform() {
+        glm::mat4 mtx = glm::identity<glm::mat4>();
+        mtx = rotate(mtx, glm::radians(0.0f), glm::vec3(1, 0, 0));
+        mtx = rotate(mtx, glm::radians(0.0f), glm::vec3(0, 1, 0));
+        mtx = rotate(mtx, glm::radians(0.0f), glm::vec3(0, 0, 1));
+        mtx = translate(mtx, glm::vec3(0, 0, 0));
+        mtx = scale(mtx, glm::vec3(1, 1, 1));
+        return mtx;
+    }
 };
 
 
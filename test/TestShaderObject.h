@@ -3,6 +3,7 @@
 #define TESTSHADEROBJECT_H
 #include <glm/glm.hpp>
 
+#include "IndirectBatcher.h"
 #include "renderable/SimpleIndexBufferedRenderable.h"
 #include "renderable/SimpleRenderable.h"
 #include "shader/SimpleShaderObject.h"
@@ -23,13 +24,22 @@ public:
 
     VertexInput getVertexInput() override;
 
-    TestShaderObject(const std::string& vertexShaderPath, const std::string &fragmentShaderPath, const ShaderProperties &properties): SimpleShaderObject(vertexShaderPath, fragmentShaderPath, properties, {{VK_SHADER_STAGE_VERTEX_BIT, sizeof(TestShaderData), 0}}) {
+    //If indirect is true, the vertex shader must read the transforms the same way test_indirect.vert does, and gets
+    //IndirectDrawPushConstants instead of TestShaderData.
+    TestShaderObject(const std::string& vertexShaderPath, const std::string &fragmentShaderPath, const ShaderProperties &properties, const bool indirect = false): SimpleShaderObject(vertexShaderPath, fragmentShaderPath, properties, {{VK_SHADER_STAGE_VERTEX_BIT, indirect ? static_cast<uint32_t>(sizeof(IndirectDrawPushConstants)) : static_cast<uint32_t>(sizeof(TestShaderData)), 0}}), indirect(indirect) {
+    }
+
+    bool drawsIndirect() override {
+        return indirect;
     }
 
     void initRenderable(Renderable *renderable) override {
+        //Indirectly drawn renderables have their transforms copied into a shared buffer, so they don't need their own.
+        if (indirect) {
+            return;
+        }
         if (auto* rend = dynamic_cast<SimpleIndexBufferedRenderable<TestShaderData>*>(renderable); rend != nullptr) {
-            rend->transformBuffer = BufferManager<glm::mat4>{sizeof(glm::mat4), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
-            VMA_MEMORY_USAGE_CPU_ONLY, 0, 1};
+            rend->transformBuffer = BufferManager<glm::mat4>{sizeof(glm::mat4)};
         }
     }
 
@@ -44,6 +54,9 @@ public:
     void createBuffers() override {
 
     }
+
+private:
+    bool indirect;
 };
 
 
@@ -3,10 +3,12 @@
 #include "implot.h"
 #endif
 #include "XTP.h"
+#include "AssetArchive.h"
 #include "Events.h"
 #include "SimpleLogger.h"
 #include "XTPWindowing.h"
 #include "GLFWWindowBackend.h"
+#include "HeadlessWindowBackend.h"
 #include "ShaderRegisterEvent.h"
 #include "renderable/SimpleIndexBufferedRenderable.h"
 #include "TestShaderObject.h"
@@ -153,9 +155,16 @@ class TestCleanUpEvent final : public CleanUpEvent {
 };
 
 int main(const int argc, char *argv[]) {
-    XTPWindowing::setWindowBackend(std::unique_ptr<XTPWindowBackend>(new GLFWWindowBackend()));
+    //Passing "--headless <frames>" renders the given number of frames offscreen and exits, without opening a window.
+    if (argc >= 3 && std::string(argv[1]) == "--headless") {
+        XTPWindowing::setWindowBackend(std::unique_ptr<XTPWindowBackend>(new HeadlessWindowBackend(std::stoull(argv[2]))));
+    } else {
+        XTPWindowing::setWindowBackend(std::unique_ptr<XTPWindowBackend>(new GLFWWindowBackend()));
+    }
     XTPWindowing::setWindowData(std::unique_ptr<XTPWindowData>(new TestWindowData));
     VulkanRenderInfo::INSTANCE = new VulkanRenderInfo();
+    //Built with "XTPPack assets.xtpa assets". Without it, the loose files are loaded instead.
+    AssetArchive::mount("assets.xtpa");
     Camera::camera = std::shared_ptr<Camera>(new TestCamera());
 
     Events::registerEvent(std::unique_ptr<Event>(new TestShaderEvent()));
@@ -0,0 +1,64 @@
+#version 450
+#extension GL_EXT_buffer_reference : require
+#extension GL_EXT_debug_printf : enable
+
+layout(buffer_reference, std430, buffer_reference_align = 16) readonly buffer GlobalData
+{
+    mat4 projectionMatrix;
+    mat4 viewMatrix;
+};
+
+//IndirectObjectData, one per object drawn by the IndirectBatcher.
+struct Object
+{
+    mat4 transformationMatrix;
+    uint materialIndex;
+};
+
+//Indexed by the instance index of the object's indirect command.
+layout(buffer_reference, std430, buffer_reference_align = 16) readonly buffer ObjectData
+{
+    Object objects[];
+};
+
+//BindlessMaterialData, indexed by Object::materialIndex. Unused here, but part of IndirectDrawPushConstants.
+struct Material
+{
+    vec4 baseColorFactor;
+    vec4 emissiveFactor;
+    float metallicFactor;
+    float roughnessFactor;
+    uint baseColorTexture;
+    uint metallicRoughnessTexture;
+    uint normalTexture;
+    uint occlusionTexture;
+    uint emissiveTexture;
+    uint samplerIndex;
+};
+
+layout(buffer_reference, std430, buffer_reference_align = 16) readonly buffer MaterialData
+{
+    Material materials[];
+};
+
+layout(push_constant, std430) uniform Data
+{
+    GlobalData global;
+    ObjectData object;
+    MaterialData material;
+} data;
+
+//Mesh Data
+layout(location = 0) in vec3 inPosition;
+layout(location = 2) in vec2 inTexCoord;
+
+layout(location = 0) out vec3 fragColor;
+layout(location = 1) out vec2 fragTexCoord;
+
+void main() {
+
+    gl_Position = data.global.projectionMatrix * data.global.viewMatrix * data.object.objects[gl_InstanceIndex].transformationMatrix * vec4(inPosition, 1.0);
+//    debugPrintfEXT("Pos:%1.2v4f", gl_Position);
+    fragTexCoord = inTexCoord;
+}
+